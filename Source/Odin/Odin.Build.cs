@@ -42,5 +42,13 @@ public class Odin : ModuleRules
                 "Projects", "AudioCaptureCore",
           }
       );
+
+    // local HTTP stand-in used by the automation tests, only linked where developer tools are built
+    bool bWithHttpServerTests = Target.bBuildDeveloperTools && Target.Configuration != UnrealTargetConfiguration.Shipping;
+    if (bWithHttpServerTests)
+    {
+      PrivateDependencyModuleNames.Add("HTTPServer");
     }
+    PrivateDefinitions.Add("ODIN_WITH_HTTP_SERVER_TESTS=" + (bWithHttpServerTests ? "1" : "0"));
+  }
 }
@@ -2,6 +2,14 @@
 
 #include "OdinAudio/Effects/OdinActivityEffect.h"
 #include "Async/TaskGraphInterfaces.h"
+#include "DSP/Dsp.h"
+#include "DSP/FloatArrayMath.h"
+
+namespace
+{
+    // -120 dBFS, matching the default of FOdinAudioLevels
+    constexpr float LevelFloor = 1.0e-6f;
+} // namespace
 
 UOdinActivityEffect::UOdinActivityEffect(const FObjectInitializer &PCIP)
     : Super(PCIP)
@@ -12,11 +20,17 @@ void UOdinActivityEffect::CustomEffect(const TArrayView<float> &InSamples, bool
 {
     TRACE_CPUPROFILER_EVENT_SCOPE(UOdinActivityEffect::CustomEffect);
     // nothing to do if there is no pipeline anymore
-    if (GetParent().IsValid() == false)
+    if (IsAttached() == false)
         return;
 
     bool bIsActive = !*bIsSilent;
 
+    if (bMeasureLevels) {
+        if (auto effect = InUserData->Root.Get()) {
+            static_cast<UOdinActivityEffect *>(effect)->PublishLevels(InSamples, bIsActive);
+        }
+    }
+
     if (ActivityCallback.IsBound() && this->HasActivity != bIsActive) {
         TRACE_CPUPROFILER_EVENT_SCOPE(UOdinActivityEffect::CustomEffect - Broadcast Update on Pipeline Thread);
         if (auto effect = InUserData->Root.Get()) {
@@ -36,6 +50,35 @@ void UOdinActivityEffect::CustomEffect(const TArrayView<float> &InSamples, bool
     }
 }
 
+void UOdinActivityEffect::PublishLevels(const TArrayView<float> &InSamples, bool bIsActive)
+{
+    FLevelSnapshot Snapshot;
+    Snapshot.bIsActive = bIsActive;
+    if (InSamples.Num() > 0) {
+        const TArrayView<const float> Samples(InSamples.GetData(), InSamples.Num());
+        Snapshot.Peak = Audio::ArrayMaxAbsValue(Samples);
+        // magnitude is the square root of the sum of squares
+        Snapshot.Rms = Audio::ArrayGetMagnitude(Samples) / FMath::Sqrt(static_cast<float>(Samples.Num()));
+    }
+    Levels.Write(Snapshot);
+}
+
+FOdinAudioLevels UOdinActivityEffect::GetLevels() const
+{
+    FLevelSnapshot Snapshot;
+    const uint32   Sequence = Levels.Read(Snapshot);
+
+    FOdinAudioLevels Result;
+    Result.Peak      = Snapshot.Peak;
+    Result.Rms       = Snapshot.Rms;
+    Result.PeakDbfs  = Audio::ConvertToDecibels(Snapshot.Peak, LevelFloor);
+    Result.RmsDbfs   = Audio::ConvertToDecibels(Snapshot.Rms, LevelFloor);
+    Result.bIsActive = Snapshot.bIsActive;
+    // the sequence lock advances by two per write
+    Result.Sequence = Sequence / 2;
+    return Result;
+}
+
 UOdinActivityEffect *UOdinActivityEffect::ConstructActivityEffect(UObject *WorldContextObject)
 {
     UOdinActivityEffect *result = NewObject<UOdinActivityEffect>(WorldContextObject);
@@ -1,14 +1,95 @@
 /* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
 
 #include "OdinAudio/Effects/OdinCloneEffect.h"
-#include "Async/TaskGraphInterfaces.h"
+
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "OdinVoice.h"
+
+namespace
+{
+    constexpr float DefaultBufferCapacityMs = 200.0f;
+    constexpr int32 MaxBufferSampleRate     = 48000;
+    constexpr int32 MaxBufferChannels       = 2;
+} // namespace
+
+FOdinCloneDrainThread::FOdinCloneDrainThread(UOdinCloneEffect *InEffect, const float InDrainIntervalMs)
+    : Effect(InEffect)
+    , bIsRunning(false)
+    , DrainEvent(nullptr)
+    , DrainIntervalMs(InDrainIntervalMs)
+{
+}
+
+FOdinCloneDrainThread::~FOdinCloneDrainThread()
+{ Exit(); }
+
+void FOdinCloneDrainThread::Start()
+{
+    if (bIsRunning) {
+        return;
+    }
+    bIsRunning = true;
+    DrainEvent = FGenericPlatformProcess::GetSynchEventFromPool();
+    check(DrainEvent);
+    Thread.Reset(FRunnableThread::Create(this, TEXT("OdinCloneDrainThread"), 0, TPri_Normal));
+}
+
+uint32 FOdinCloneDrainThread::Run()
+{
+    while (bIsRunning) {
+        check(DrainEvent);
+        DrainEvent->Wait(DrainIntervalMs);
+
+        if (bIsRunning) {
+            Effect->Drain();
+        }
+    }
+    return 0;
+}
+
+void FOdinCloneDrainThread::Exit()
+{
+    if (!bIsRunning) {
+        return;
+    }
+
+    bIsRunning = false;
+
+    if (DrainEvent) {
+        DrainEvent->Trigger();
+    }
+    if (Thread.IsValid()) {
+        Thread->WaitForCompletion();
+    }
+
+    if (DrainEvent) {
+        FGenericPlatformProcess::ReturnSynchEventToPool(DrainEvent);
+        DrainEvent = nullptr;
+    }
+}
 
 UOdinCloneEffect::UOdinCloneEffect(const FObjectInitializer &PCIP)
     : Super(PCIP)
-{ UserData = TOdinCustomEffectUserData(this); }
+{
+    UserData = TOdinCustomEffectUserData(this);
+    Ring.SetCapacity(static_cast<uint32>(MaxBufferSampleRate * MaxBufferChannels * DefaultBufferCapacityMs / 1000.0f));
+}
+
+void UOdinCloneEffect::PostInitProperties()
+{
+    Super::PostInitProperties();
+    if (!HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject)) {
+        DeliverOnGameThread();
+    }
+}
 
 void UOdinCloneEffect::BeginDestroy()
-{ Super::BeginDestroy(); }
+{
+    StopDelivery();
+    Super::BeginDestroy();
+}
 
 UOdinCloneEffect *UOdinCloneEffect::ConstructCloneEffect(UObject *WorldContextObject)
 {
@@ -16,35 +97,107 @@ UOdinCloneEffect *UOdinCloneEffect::ConstructCloneEffect(UObject *WorldContextOb
     return result;
 }
 
+bool UOdinCloneEffect::SetBufferCapacityMs(float Milliseconds)
+{
+    if (IsAttached() || DrainThread.IsValid()) {
+        ODIN_LOG(Warning, "Aborting SetBufferCapacityMs, the clone effect is in use by a pipeline or worker thread.");
+        return false;
+    }
+    const int32 NumChannels = Stereo ? 2 : 1;
+    const int32 NumSamples  = FMath::Max(static_cast<int32>(SampleRate * NumChannels * Milliseconds / 1000.0f), NumChannels);
+    Ring.SetCapacity(static_cast<uint32>(NumSamples));
+    return true;
+}
+
+int64 UOdinCloneEffect::GetDroppedSampleCount() const
+{ return static_cast<int64>(NumDroppedSamples.load(std::memory_order_relaxed)); }
+
+void UOdinCloneEffect::DeliverOnGameThread()
+{
+    if (TickerHandle.IsValid()) {
+        return;
+    }
+    StopDelivery();
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UOdinCloneEffect::TickDrain), 0.0f);
+}
+
+void UOdinCloneEffect::DeliverOnWorkerThread(FOdinCloneSampleHandler Handler, float DrainIntervalMs)
+{
+    StopDelivery();
+    WorkerHandler = MoveTemp(Handler);
+    DrainThread   = MakeUnique<FOdinCloneDrainThread>(this, DrainIntervalMs);
+    DrainThread->Start();
+}
+
+void UOdinCloneEffect::StopDelivery()
+{
+    if (TickerHandle.IsValid()) {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+    if (DrainThread.IsValid()) {
+        DrainThread->Exit();
+        DrainThread.Reset();
+    }
+    WorkerHandler = nullptr;
+}
+
+bool UOdinCloneEffect::TickDrain(float DeltaTime)
+{
+    Drain();
+    return true;
+}
+
 void UOdinCloneEffect::CustomEffect(const TArrayView<float> &InSamples, bool *&bIsSilent, TOdinCustomEffectUserData<UOdinCustomEffect> *const InUserData) const
 {
     TRACE_CPUPROFILER_EVENT_SCOPE(UOdinCloneEffect::CustomEffect);
 
-    if (GetParent().IsValid() == false)
+    if (IsAttached() == false)
         return;
 
     if (auto effect = InUserData->Root.Get()) {
-        DispatchClone(static_cast<UOdinCloneEffect *>(effect), InSamples, ENamedThreads::GameThread);
+        auto self = static_cast<UOdinCloneEffect *>(effect);
+        self->DispatchClone(self, InSamples);
     }
 }
 
-void UOdinCloneEffect::Callback(Audio::TSampleBuffer<float> Buffer) const
+void UOdinCloneEffect::Callback(const TArray<float> &Samples) const
 {
     if (OnDispatchCloneCallbackBP.IsBound())
-        OnDispatchCloneCallbackBP.Broadcast(TArray<float>(Buffer.GetArrayView()));
+        OnDispatchCloneCallbackBP.Broadcast(Samples);
 }
 
-void UOdinCloneEffect::DispatchClone(UOdinCloneEffect *Self, const TArrayView<float> &Samples, ENamedThreads::Type Target) const
+void UOdinCloneEffect::DispatchClone(UOdinCloneEffect *Self, const TArrayView<float> &Samples)
 {
     TRACE_CPUPROFILER_EVENT_SCOPE(UOdinCloneEffect::CustomEffect - Pipeline Thread);
-    TWeakObjectPtr<UOdinCloneEffect> WeakSelf = Self;
-    FFunctionGraphTask::CreateAndDispatchWhenReady(
-        // uses cctor FMemory::Memcpy
-        [WeakSelf, buffer = Audio::TSampleBuffer<float>(Samples.GetData(), Samples.Num(), Self->Stereo ? 2 : 1, Self->SampleRate)]() {
-            TRACE_CPUPROFILER_EVENT_SCOPE(UOdinCloneEffect::CustomEffect - Game Thread);
-            if (WeakSelf.IsValid()) {
-                WeakSelf->Callback(buffer);
-            }
-        },
-        TStatId(), nullptr, Target);
+    const uint32 NumSamples = static_cast<uint32>(Samples.Num());
+    if (Self->Ring.Remainder() < NumSamples) {
+        // the consumer fell behind, keep the buffered audio and drop this frame as a whole, so the consumer never gets a partial one
+        Self->NumDroppedSamples.fetch_add(NumSamples, std::memory_order_relaxed);
+        return;
+    }
+    Self->Ring.Push(Samples.GetData(), NumSamples);
+}
+
+void UOdinCloneEffect::Drain()
+{
+    const uint32 NumAvailable = Ring.Num();
+    if (NumAvailable == 0) {
+        return;
+    }
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinCloneEffect::Drain);
+    // Reset keeps the allocation, so the buffer only grows until it reached the size of the ring
+    DrainBuffer.Reset();
+    DrainBuffer.AddUninitialized(NumAvailable);
+    const uint32 NumPopped = Ring.Pop(DrainBuffer.GetData(), NumAvailable);
+    if (NumPopped < NumAvailable) {
+        DrainBuffer.SetNum(NumPopped);
+    }
+
+    if (WorkerHandler) {
+        WorkerHandler(DrainBuffer, SampleRate, Stereo ? 2 : 1);
+    } else {
+        Callback(DrainBuffer);
+    }
 }
@@ -19,7 +19,7 @@ void UOdinCustomEffect::CustomEffect(const TArrayView<float>& InSamples, bool*&
         return;
 
     // nothing to do if there is no pipeline anymore
-    if (GetParent().IsValid() == false)
+    if (IsAttached() == false)
         return;
 }
 
@@ -19,7 +19,7 @@ void UOdinMuteEffect::CustomEffect(const TArrayView<float> &InSamples, bool *&bI
         return;
 
     // nothing to do if there is no pipeline anymore
-    if (GetParent().IsValid() == false)
+    if (IsAttached() == false)
         return;
 
     *bIsSilent = *bIsSilent || MuteFlag == EOdinMuteEffectOptions::ODIN_EFFECT_TOGGLE_ON;
@@ -0,0 +1,215 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#include "OdinAudio/Effects/OdinNativeEffectChain.h"
+
+#include "OdinAudio/Effects/OdinCustomEffect.h"
+
+/**
+ * Chain entry running a custom effect. The effect counts its hosts, so it knows it is attached without a parent pipeline.
+ */
+class FOdinCustomEffectHost : public IOdinNativeEffect
+{
+  public:
+    explicit FOdinCustomEffectHost(UOdinCustomEffect* InEffect)
+        : Effect(InEffect)
+    { InEffect->NumChainHosts.fetch_add(1, std::memory_order_relaxed); }
+
+    virtual ~FOdinCustomEffectHost() override
+    {
+        if (UOdinCustomEffect* Target = Effect.Get()) {
+            Target->NumChainHosts.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    virtual void Process(float* Samples, uint32 NumSamples, bool& bIsSilent) override
+    {
+        if (UOdinCustomEffect* Target = Effect.Get()) {
+            Target->FFICallback(Samples, NumSamples, &bIsSilent, &Target->UserData);
+        }
+    }
+
+    virtual const TCHAR* GetName() const override
+    { return TEXT("CustomEffect"); }
+
+  private:
+    TWeakObjectPtr<UOdinCustomEffect> Effect;
+};
+
+FOdinNativeEffectChain::FOdinNativeEffectChain()
+    : Snapshot(new FSnapshot())
+{
+}
+
+FOdinNativeEffectChain::~FOdinNativeEffectChain()
+{
+    // no pipeline references the chain anymore, so nothing reads the snapshots
+    delete Snapshot.exchange(nullptr);
+    for (const FSnapshot* Retired : RetiredSnapshots) {
+        delete Retired;
+    }
+}
+
+void FOdinNativeEffectChain::Process(float* Samples, uint32 NumSamples, bool& bIsSilent)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FOdinNativeEffectChain::Process);
+
+    NumReaders.fetch_add(1);
+    if (const FSnapshot* Current = Snapshot.load()) {
+        for (const FEntry& Entry : *Current) {
+            if (!Entry.bBypass) {
+                Entry.Effect->Process(Samples, NumSamples, bIsSilent);
+            }
+        }
+    }
+    NumReaders.fetch_sub(1);
+}
+
+bool FOdinNativeEffectChain::ContainsEffect(const IOdinNativeEffect* Effect) const
+{
+    bool bContains = false;
+    NumReaders.fetch_add(1);
+    if (const FSnapshot* Current = Snapshot.load()) {
+        for (const FEntry& Entry : *Current) {
+            if (Entry.Effect.GetReference() == Effect || Entry.Effect->ContainsEffect(Effect)) {
+                bContains = true;
+                break;
+            }
+        }
+    }
+    NumReaders.fetch_sub(1);
+    return bContains;
+}
+
+bool FOdinNativeEffectChain::Insert(int32 Index, FOdinNativeEffectRef Effect)
+{
+    // a chain running itself, directly or through other chains, would recurse on the first frame
+    if (!Effect.IsValid() || Effect.GetReference() == this || Effect->ContainsEffect(this)) {
+        return false;
+    }
+
+    FScopeLock Lock(&ChainCS);
+    if (IndexOf(Effect) != INDEX_NONE) {
+        return false;
+    }
+    FEntry Entry;
+    Entry.Effect = MoveTemp(Effect);
+    if (Index == INDEX_NONE || Index >= Entries.Num()) {
+        Entries.Add(MoveTemp(Entry));
+    } else {
+        Entries.Insert(MoveTemp(Entry), FMath::Max(Index, 0));
+    }
+    Publish();
+    return true;
+}
+
+FOdinNativeEffectRef FOdinNativeEffectChain::InsertCustomEffect(int32 Index, UOdinCustomEffect* Effect)
+{
+    if (!IsValid(Effect) || Effect->GetParent().IsValid()) {
+        return nullptr;
+    }
+
+    FScopeLock Lock(&ChainCS);
+    if (Entries.ContainsByPredicate([Effect](const FEntry& Entry) { return Entry.CustomEffect == Effect; })) {
+        return nullptr;
+    }
+    FEntry Entry;
+    Entry.Effect       = new FOdinCustomEffectHost(Effect);
+    Entry.CustomEffect = Effect;
+    FOdinNativeEffectRef Host = Entry.Effect;
+    if (Index == INDEX_NONE || Index >= Entries.Num()) {
+        Entries.Add(MoveTemp(Entry));
+    } else {
+        Entries.Insert(MoveTemp(Entry), FMath::Max(Index, 0));
+    }
+    Publish();
+    return Host;
+}
+
+bool FOdinNativeEffectChain::Remove(const FOdinNativeEffectRef& Effect)
+{
+    FScopeLock  Lock(&ChainCS);
+    const int32 Index = IndexOf(Effect);
+    if (Index == INDEX_NONE) {
+        return false;
+    }
+    Entries.RemoveAt(Index);
+    Publish();
+    return true;
+}
+
+bool FOdinNativeEffectChain::Move(const FOdinNativeEffectRef& Effect, int32 NewIndex)
+{
+    FScopeLock  Lock(&ChainCS);
+    const int32 Index = IndexOf(Effect);
+    if (Index == INDEX_NONE) {
+        return false;
+    }
+    FEntry Entry = MoveTemp(Entries[Index]);
+    Entries.RemoveAt(Index);
+    Entries.Insert(MoveTemp(Entry), FMath::Clamp(NewIndex, 0, Entries.Num()));
+    Publish();
+    return true;
+}
+
+bool FOdinNativeEffectChain::SetBypass(const FOdinNativeEffectRef& Effect, bool bBypass)
+{
+    FScopeLock  Lock(&ChainCS);
+    const int32 Index = IndexOf(Effect);
+    if (Index == INDEX_NONE) {
+        return false;
+    }
+    Entries[Index].bBypass = bBypass;
+    Publish();
+    return true;
+}
+
+bool FOdinNativeEffectChain::IsBypassed(const FOdinNativeEffectRef& Effect) const
+{
+    FScopeLock  Lock(&ChainCS);
+    const int32 Index = IndexOf(Effect);
+    return Index != INDEX_NONE && Entries[Index].bBypass;
+}
+
+TArray<FOdinNativeEffectRef> FOdinNativeEffectChain::GetEffects() const
+{
+    FScopeLock                   Lock(&ChainCS);
+    TArray<FOdinNativeEffectRef> Effects;
+    Effects.Reserve(Entries.Num());
+    for (const FEntry& Entry : Entries) {
+        Effects.Add(Entry.Effect);
+    }
+    return Effects;
+}
+
+int32 FOdinNativeEffectChain::Num() const
+{
+    FScopeLock Lock(&ChainCS);
+    return Entries.Num();
+}
+
+int32 FOdinNativeEffectChain::IndexOf(const FOdinNativeEffectRef& Effect) const
+{
+    return Entries.IndexOfByPredicate([&Effect](const FEntry& Entry) { return Entry.Effect == Effect; });
+}
+
+void FOdinNativeEffectChain::Publish()
+{
+    const FSnapshot* Previous = Snapshot.exchange(new FSnapshot(Entries));
+    if (Previous) {
+        RetiredSnapshots.Add(Previous);
+    }
+    ReleaseRetiredSnapshots();
+}
+
+void FOdinNativeEffectChain::ReleaseRetiredSnapshots()
+{
+    // Readers register before loading the snapshot. Once no reader is registered after the swap, every later reader
+    // loads the new snapshot, so the retired ones can go. Otherwise they are released with the next edit.
+    if (NumReaders.load() != 0) {
+        return;
+    }
+    for (const FSnapshot* Retired : RetiredSnapshots) {
+        delete Retired;
+    }
+    RetiredSnapshots.Reset();
+}
@@ -1,34 +1,340 @@
 /* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
 
 #include "OdinAudio/Effects/OdinRestGSTTEffect.h"
-#include "Engine/World.h"
-#include "TimerManager.h"
+#include "Async/Async.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
 #include "HttpFwd.h"
 #include "HttpModule.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "OdinVoice.h"
 #include "Runtime/Launch/Resources/Version.h"
 
+namespace
+{
+    constexpr int32 MaxRingSampleRate = 48000;
+    constexpr int32 MaxRingChannels   = 2;
+    // pipeline frames are 20 ms, anything above 100 ms is rejected to keep the frame buffer bounded
+    constexpr int32 MaxFrameMs    = 100;
+    constexpr int32 MinFrameMs    = 10;
+    constexpr float DrainInterval = 20.0f;
+
+    void WriteWavFile(const TArray<int16>& Samples, int32 SampleRate, TArray<uint8>& OutWav)
+    {
+        const uint32 DataSize = Samples.Num() * sizeof(int16);
+        OutWav.Reset(44 + DataSize);
+
+        auto WriteTag = [&OutWav](const char* Tag) { OutWav.Append(reinterpret_cast<const uint8*>(Tag), 4); };
+        auto WriteU32 = [&OutWav](uint32 Value) {
+            for (int32 Byte = 0; Byte < 4; ++Byte) {
+                OutWav.Add(static_cast<uint8>(Value >> (Byte * 8)));
+            }
+        };
+        auto WriteU16 = [&OutWav](uint16 Value) {
+            OutWav.Add(static_cast<uint8>(Value));
+            OutWav.Add(static_cast<uint8>(Value >> 8));
+        };
+
+        WriteTag("RIFF");
+        WriteU32(36 + DataSize);
+        WriteTag("WAVE");
+        WriteTag("fmt ");
+        WriteU32(16);
+        WriteU16(1); // PCM
+        WriteU16(1); // mono
+        WriteU32(SampleRate);
+        WriteU32(SampleRate * sizeof(int16));
+        WriteU16(sizeof(int16));
+        WriteU16(16);
+        WriteTag("data");
+        WriteU32(DataSize);
+#if PLATFORM_LITTLE_ENDIAN
+        OutWav.Append(reinterpret_cast<const uint8*>(Samples.GetData()), DataSize);
+#else
+        for (const int16 Sample : Samples) {
+            WriteU16(static_cast<uint16>(Sample));
+        }
+#endif
+    }
+} // namespace
+
+FOdinGSTTStreamer::FOdinGSTTStreamer(UOdinRestGSTTEffect* InOwner, const float InCapacityMs)
+    : Owner(InOwner)
+    , MaxFrameSamples(MaxRingSampleRate * MaxRingChannels * MaxFrameMs / 1000)
+    , PendingUploads(MakeShared<std::atomic<int32>, ESPMode::ThreadSafe>(0))
+    , bIsRunning(false)
+    , DrainEvent(nullptr)
+{
+    SampleRing.SetCapacity(static_cast<uint32>(MaxRingSampleRate * MaxRingChannels * InCapacityMs / 1000.0f));
+    HeaderRing.SetCapacity(static_cast<uint32>(InCapacityMs / MinFrameMs) + 1);
+    FrameBuffer.SetNumUninitialized(MaxFrameSamples);
+}
+
+FOdinGSTTStreamer::~FOdinGSTTStreamer()
+{ Exit(); }
+
+void FOdinGSTTStreamer::Write(const float* Samples, int32 NumSamples, int32 NumChannels, int32 SampleRate, bool bIsActive)
+{
+    if (NumSamples <= 0 || NumSamples > MaxFrameSamples || SampleRing.Remainder() < static_cast<uint32>(NumSamples) || HeaderRing.Remainder() < 1) {
+        NumOverflowFrames.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    FFrameHeader Header;
+    Header.NumSamples  = NumSamples;
+    Header.NumChannels = FMath::Max(NumChannels, 1);
+    Header.SampleRate  = SampleRate;
+    Header.bIsActive   = bIsActive;
+    // samples first, the worker only reads a frame once its header is visible
+    SampleRing.Push(Samples, NumSamples);
+    HeaderRing.Push(&Header, 1);
+}
+
+void FOdinGSTTStreamer::Start(const FOdinGSTTStreamSettings& InSettings)
+{
+    FScopeLock Lock(&StartCS);
+    Exit();
+
+    Settings              = InSettings;
+    Settings.ResampleRate = FMath::Max(Settings.ResampleRate, 8000);
+    MaxSegmentSamples     = FMath::Max(static_cast<int32>(Settings.ResampleRate * Settings.MaxSegmentSeconds), Settings.ResampleRate / 10);
+    HangoverSamples       = static_cast<int32>(Settings.ResampleRate * Settings.HangoverMs / 1000.0f);
+    Segment.Reset(MaxSegmentSamples);
+    PreRoll.SetCapacity(static_cast<uint32>(Settings.ResampleRate * Settings.PreRollMs / 1000.0f) + 1);
+    Resampler.Reset();
+    SilentSamples = 0;
+    bInSegment    = false;
+
+    bIsRunning = true;
+    DrainEvent = FGenericPlatformProcess::GetSynchEventFromPool();
+    check(DrainEvent);
+    Thread.Reset(FRunnableThread::Create(this, TEXT("OdinGSTTStreamerThread"), 0, TPri_BelowNormal));
+}
+
+FOdinGSTTStats FOdinGSTTStreamer::GetStats() const
+{
+    FOdinGSTTStats Stats;
+    Stats.NumSegments        = NumSegments.load(std::memory_order_relaxed);
+    Stats.NumUploads         = NumUploads.load(std::memory_order_relaxed);
+    Stats.NumDroppedSegments = NumDroppedSegments.load(std::memory_order_relaxed);
+    Stats.NumOverflowFrames  = NumOverflowFrames.load(std::memory_order_relaxed);
+    return Stats;
+}
+
+uint32 FOdinGSTTStreamer::Run()
+{
+    while (bIsRunning) {
+        check(DrainEvent);
+        DrainEvent->Wait(DrainInterval);
+
+        if (bIsRunning) {
+            Drain();
+        }
+    }
+    // frames queued since the last wakeup still belong to the stream
+    Drain();
+    // an open utterance also gets the input still held back by the resampler, then send what was recorded so far
+    if (bInSegment) {
+        AppendToSegment(Resampler.Flush());
+    }
+    FinishSegment();
+    return 0;
+}
+
+void FOdinGSTTStreamer::Exit()
+{
+    if (!bIsRunning) {
+        return;
+    }
+
+    bIsRunning = false;
+
+    if (DrainEvent) {
+        DrainEvent->Trigger();
+    }
+    if (Thread.IsValid()) {
+        Thread->WaitForCompletion();
+    }
+
+    if (DrainEvent) {
+        FGenericPlatformProcess::ReturnSynchEventToPool(DrainEvent);
+        DrainEvent = nullptr;
+    }
+}
+
+void FOdinGSTTStreamer::Drain()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FOdinGSTTStreamer::Drain);
+
+    FFrameHeader Header;
+    while (HeaderRing.Num() > 0) {
+        HeaderRing.Pop(&Header, 1);
+        SampleRing.Pop(FrameBuffer.GetData(), Header.NumSamples);
+        ProcessFrame(Header, FrameBuffer.GetData());
+    }
+}
+
+void FOdinGSTTStreamer::ProcessFrame(const FFrameHeader& Header, const float* Samples)
+{
+    if (Remixer.GetNumInputChannels() != Header.NumChannels || Remixer.GetNumOutputChannels() != 1) {
+        Remixer.Init(Header.NumChannels, 1);
+    }
+    if (Resampler.GetInputSampleRate() != Header.SampleRate || Resampler.GetOutputSampleRate() != Settings.ResampleRate) {
+        Resampler.Init(Header.SampleRate, Settings.ResampleRate, 1);
+    }
+
+    const TArrayView<const float> Mono = Remixer.Process(Samples, Header.NumSamples);
+    if (Mono.Num() == 0) {
+        return;
+    }
+
+    const TArrayView<const float> Output       = Resampler.Process(Mono.GetData(), Mono.Num());
+    const int32                   NumOutFrames = Output.Num();
+    if (Header.bIsActive) {
+        if (!bInSegment) {
+            bInSegment = true;
+            Segment.Reset();
+            // start the utterance with the audio right before the VAD triggered
+            float PreRollSample;
+            while (PreRoll.Num() > 0) {
+                PreRoll.Pop(&PreRollSample, 1);
+                AppendToSegment(TArrayView<const float>(&PreRollSample, 1));
+            }
+        }
+        SilentSamples = 0;
+        AppendToSegment(Output);
+    } else if (bInSegment) {
+        AppendToSegment(Output);
+        SilentSamples += NumOutFrames;
+        if (SilentSamples >= HangoverSamples) {
+            FinishSegment();
+            bInSegment = false;
+        }
+    } else {
+        const uint32 NumToPush = FMath::Min(static_cast<uint32>(NumOutFrames), PreRoll.GetCapacity());
+        if (PreRoll.Remainder() < NumToPush) {
+            PreRoll.Pop(NumToPush - PreRoll.Remainder());
+        }
+        PreRoll.Push(Output.GetData() + NumOutFrames - NumToPush, NumToPush);
+    }
+}
+
+void FOdinGSTTStreamer::AppendToSegment(TArrayView<const float> Samples)
+{
+    for (const float Sample : Samples) {
+        Segment.Add(static_cast<int16>(FMath::Clamp(Sample, -1.0f, 1.0f) * 32767.0f));
+        // long utterances are sent in chunks, the segment stays open
+        if (Segment.Num() >= MaxSegmentSamples) {
+            FinishSegment();
+        }
+    }
+}
+
+void FOdinGSTTStreamer::FinishSegment()
+{
+    if (Segment.Num() == 0) {
+        return;
+    }
+    TRACE_CPUPROFILER_EVENT_SCOPE(FOdinGSTTStreamer::FinishSegment);
+    NumSegments.fetch_add(1, std::memory_order_relaxed);
+
+    const FString Name      = FString::Printf(TEXT("buffer_%d"), SegmentIndex++);
+    const FString NameSpace = TEXT("GSTT");
+
+    TArray<uint8> Wav;
+    WriteWavFile(Segment, Settings.ResampleRate, Wav);
+    if (Settings.bWriteWav) {
+        FFileHelper::SaveArrayToFile(Wav, *FPaths::Combine(FPaths::ProjectSavedDir(), NameSpace, Name + TEXT(".wav")));
+    }
+
+    if (Settings.Endpoint.IsEmpty()) {
+        Audio::FAlignedFloatBuffer Buffer;
+        Buffer.SetNumUninitialized(Segment.Num());
+        for (int32 Index = 0; Index < Segment.Num(); ++Index) {
+            Buffer[Index] = Segment[Index] / 32768.0f;
+        }
+        TWeakObjectPtr<UOdinRestGSTTEffect> WeakOwner = Owner;
+        AsyncTask(ENamedThreads::GameThread, [WeakOwner, Buffer = MoveTemp(Buffer), Name, NameSpace]() {
+            if (UOdinRestGSTTEffect* Effect = WeakOwner.Get()) {
+                Effect->Callback(Buffer, Name, NameSpace);
+            }
+        });
+    } else {
+        Upload(MoveTemp(Wav), SegmentIndex - 1);
+    }
+    // keeps the allocation of MaxSegmentSamples
+    Segment.Reset();
+}
+
+void FOdinGSTTStreamer::Upload(TArray<uint8>&& Wav, int32 Index)
+{
+    if (PendingUploads->load() >= Settings.MaxPendingUploads) {
+        NumDroppedSegments.fetch_add(1, std::memory_order_relaxed);
+        ODIN_LOG(Verbose, "UOdinRestGSTTEffect: Dropping segment, %d uploads are still pending.", PendingUploads->load());
+        return;
+    }
+    PendingUploads->fetch_add(1);
+    NumUploads.fetch_add(1, std::memory_order_relaxed);
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+    Request->SetVerb(TEXT("POST"));
+    Request->SetHeader(TEXT("Content-Type"), Settings.ContentType);
+    Request->SetHeader(TEXT("X-Odin-Segment"), FString::FromInt(Index));
+    Request->SetURL(Settings.Endpoint);
+    Request->SetContent(MoveTemp(Wav));
+
+    TWeakObjectPtr<UOdinRestGSTTEffect>                 WeakOwner = Owner;
+    TSharedPtr<std::atomic<int32>, ESPMode::ThreadSafe> Pending   = PendingUploads;
+    Request->OnProcessRequestComplete().BindLambda([WeakOwner, Pending](FHttpRequestPtr CompletedRequest, FHttpResponsePtr Response, bool bConnectedSuccessfully) {
+        Pending->fetch_sub(1);
+        if (!bConnectedSuccessfully || !Response.IsValid()) {
+            ODIN_LOG(Warning, "UOdinRestGSTTEffect: Segment upload failed.");
+            return;
+        }
+        if (UOdinRestGSTTEffect* Effect = WeakOwner.Get()) {
+            Effect->PostResponse.Broadcast(Response->GetContentAsString());
+        }
+    });
+    Request->ProcessRequest();
+}
+
 UOdinRestGSTTEffect::UOdinRestGSTTEffect(const class FObjectInitializer &PCIP)
     : Super(PCIP)
 { UserData = TOdinCustomEffectUserData(this); }
 
+void UOdinRestGSTTEffect::PostInitProperties()
+{
+    Super::PostInitProperties();
+    // only the rings are allocated here, the worker starts with the first processed frame or an explicit StartStreaming
+    if (!HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject)) {
+        Streamer = MakeUnique<FOdinGSTTStreamer>(this);
+    }
+}
+
 void UOdinRestGSTTEffect::CustomEffect(const TArrayView<float> &InSamples, bool *&bIsSilent,
                                        TOdinCustomEffectUserData<UOdinCustomEffect> *const InUserData) const
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinRestGSTTEffect::CustomEffect);
+
     // nothing to do if there is no pipeline anymore
-    if (GetParent().IsValid() == false)
+    if (IsAttached() == false || !Streamer.IsValid())
         return;
 
-    if (auto effect = InUserData->Root.Get()) {
-        auto self = static_cast<UOdinRestGSTTEffect *>(effect);
-
-        if (self->TimerHandle.IsValid())
-            self->AudioBuffer.Append(InSamples.GetData(), InSamples.Num(), bStereo ? 2 : 1, SampleRate);
-        else {
-            GetWorld()->GetTimerManager().SetTimer(self->TimerHandle, self, &UOdinRestGSTTEffect::TimerCallback, self->Timer, false);
-        }
+    if (!bStartRequested.exchange(true)) {
+        // the rings buffer the frames until the worker runs, settings are only read on the game thread
+        TWeakObjectPtr<UOdinRestGSTTEffect> WeakThis = const_cast<UOdinRestGSTTEffect *>(this);
+        AsyncTask(ENamedThreads::GameThread, [WeakThis]() {
+            UOdinRestGSTTEffect *Effect = WeakThis.Get();
+            if (Effect && !Effect->IsStreaming()) {
+                Effect->StartStreaming();
+            }
+        });
     }
+    Streamer->Write(InSamples.GetData(), InSamples.Num(), bStereo ? 2 : 1, SampleRate, !*bIsSilent);
 }
 
 UOdinRestGSTTEffect *UOdinRestGSTTEffect::ConstructRestGSTTEffect(UObject *WorldContextObject)
@@ -37,31 +343,37 @@ UOdinRestGSTTEffect *UOdinRestGSTTEffect::ConstructRestGSTTEffect(UObject *World
     return result;
 }
 
-void UOdinRestGSTTEffect::TimerCallback()
+void UOdinRestGSTTEffect::StartStreaming()
 {
-
-    Audio::FAlignedFloatBuffer buffer;
-    if (Remix(AudioBuffer.GetData(), AudioBuffer.GetNumSamples(), AudioBuffer.GetNumChannels(), AudioBuffer.GetSampleRate(), ResampleRate, buffer)) {
-        FString name = "buffer", path = "GSTT";
-        if (WriteWav) {
-            const Audio::FSampleBuffer wav = Audio::TSampleBuffer<int16>(buffer, 1, ResampleRate);
-#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 4
-            Writer.SynchronouslyWriteToWavFile(wav, name, path);
-#else
-            Writer.SynchronouslyWriteSoundWave(wav, &name, &path);
-#endif
-        }
-        Callback(buffer, name, path);
+    if (!Streamer.IsValid()) {
+        return;
     }
 
-    AudioBuffer.Reset();
-    GetWorld()->GetTimerManager().ClearTimer(TimerHandle);
+    FOdinGSTTStreamSettings Settings;
+    Settings.Endpoint          = UploadEndpoint;
+    Settings.ContentType       = UploadContentType;
+    Settings.ResampleRate      = ResampleRate;
+    Settings.MaxSegmentSeconds = Timer;
+    Settings.PreRollMs         = PreRollMs;
+    Settings.HangoverMs        = HangoverMs;
+    Settings.MaxPendingUploads = MaxPendingUploads;
+    Settings.bWriteWav         = WriteWav;
+    bStartRequested            = true;
+    Streamer->Start(Settings);
 }
 
+bool UOdinRestGSTTEffect::IsStreaming() const
+{ return Streamer.IsValid() && Streamer->IsRunning(); }
+
+FOdinGSTTStats UOdinRestGSTTEffect::GetStreamingStats() const
+{ return Streamer.IsValid() ? Streamer->GetStats() : FOdinGSTTStats(); }
+
 void UOdinRestGSTTEffect::BeginDestroy()
 {
+    if (Streamer.IsValid()) {
+        Streamer->Exit();
+    }
     Super::BeginDestroy();
-    AudioBuffer.Reset();
 }
 
 /// <summary>
@@ -107,35 +419,23 @@ void UOdinRestGSTTEffect::PostRequest(const FString &Endpoint, const FString &Pa
 bool UOdinRestGSTTEffect::Remix(const float *InAudio, int32 NumSamples, int32 NumChannels, int32 SourceSampleRate, int32 TargetSampleRate,
                                 Audio::FAlignedFloatBuffer &OutAudio)
 {
-    if (!NumSamples) {
+    if (!NumSamples || NumChannels <= 0) {
         UE_LOG(LogTemp, Error, TEXT("UOdinRestGSTTEffect: No samples to downmix/resample."));
         return false;
     }
 
     // downmix
-    Audio::FAlignedFloatBuffer monoSamples = Audio::FAlignedFloatBuffer();
-    monoSamples.SetNum((NumSamples / NumChannels));
-    for (int32 sampleCnt = 0; sampleCnt < NumSamples; sampleCnt += NumChannels) {
-        float sum = 0.f;
-        for (int32 channelCnt = 0; channelCnt < NumChannels; ++channelCnt)
-            sum += InAudio[sampleCnt + channelCnt];
-        monoSamples.Add(sum / NumChannels);
-    }
+    FOdinRemixer                  Remixer(NumChannels, 1);
+    const int32                   NumFrames   = NumSamples / NumChannels;
+    const TArrayView<const float> MonoSamples = Remixer.Process(InAudio, NumFrames * NumChannels);
 
     // resample
-    const double ratio  = double(SourceSampleRate) / TargetSampleRate;
-    const int32  newNum = FMath::CeilToInt(monoSamples.Num() / ratio);
-    OutAudio.SetNum(newNum);
-    for (int32 i = 0; i < newNum; ++i) {
-        double srcIdx = i * ratio;
-        int32  index  = FMath::FloorToInt(srcIdx);
-
-        float sampleValueAtStart = monoSamples[FMath::Clamp(index, 0, monoSamples.Num() - 1)];
-        float sampleValueAtEnd   = monoSamples[FMath::Clamp(index + 1, 0, monoSamples.Num() - 1)];
-
-        double frac = srcIdx - index;
-        OutAudio[i] = (sampleValueAtStart + (sampleValueAtEnd - sampleValueAtStart) * frac);
-    }
+    FOdinResampler Resampler(SourceSampleRate, TargetSampleRate, 1);
+    OutAudio.SetNumUninitialized(Resampler.GetMaxOutputFrames(NumFrames) + Resampler.GetMaxOutputFrames(Resampler.GetLatencyFrames()));
+    int32 NumOutFrames = Resampler.Process(MonoSamples.GetData(), NumFrames, OutAudio.GetData(), OutAudio.Num());
+    // the buffer is the whole stream, so it ends with the samples still held back by the filter
+    NumOutFrames += Resampler.Flush(OutAudio.GetData() + NumOutFrames, OutAudio.Num() - NumOutFrames);
+    OutAudio.SetNum(NumOutFrames);
 
     return true;
-}
\ No newline at end of file
+}
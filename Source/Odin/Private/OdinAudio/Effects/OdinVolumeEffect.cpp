@@ -2,41 +2,141 @@
 
 #include "OdinAudio/Effects/OdinVolumeEffect.h"
 
+#include "DSP/FloatArrayMath.h"
+
+namespace
+{
+    // exponential ramps are approximated by linear segments of this many samples, which keeps the kernel vectorized
+    constexpr int32 ExponentialRampSegment = 32;
+    constexpr float SilentGain             = 0.001f;
+} // namespace
+
 UOdinVolumeEffect::UOdinVolumeEffect(const FObjectInitializer &PCIP)
     : Super(PCIP)
-{ UserData = TOdinCustomEffectUserData(this); }
+{
+    UserData = TOdinCustomEffectUserData(this);
+    UpdateTargetGain();
+}
+
+void UOdinVolumeEffect::PostInitProperties()
+{
+    Super::PostInitProperties();
+    UpdateTargetGain();
+}
+
+void UOdinVolumeEffect::PostLoad()
+{
+    Super::PostLoad();
+    UpdateTargetGain();
+}
+
+#if WITH_EDITOR
+void UOdinVolumeEffect::PostEditChangeProperty(FPropertyChangedEvent &PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    UpdateTargetGain();
+}
+#endif
 
 void UOdinVolumeEffect::CustomEffect(const TArrayView<float> &InSamples, bool *&bIsSilent, TOdinCustomEffectUserData<UOdinCustomEffect> *const InUSerData) const
 {
     TRACE_CPUPROFILER_EVENT_SCOPE(UOdinVolumeEffect::CustomEffect);
 
     // nothing to do if there is no pipeline anymore
-    if (GetParent().IsValid() == false)
+    if (IsAttached() == false)
         return;
 
+    const float Target = TargetGain.load(std::memory_order_relaxed);
+    if (!bHasCurrentGain) {
+        CurrentGain     = Target;
+        bHasCurrentGain = true;
+    }
+    const float Start = CurrentGain;
+    CurrentGain       = Target;
+
     // already silent content
     if (*bIsSilent)
         return;
 
-    // scale close to silence
-    if (FMath::IsNearlyEqual(SampleScale, 0.0, 0.001)) {
+    // gain close to silence
+    if (FMath::Abs(Start) < SilentGain && FMath::Abs(Target) < SilentGain) {
         *bIsSilent = true;
         return;
     }
 
-    // Log10(2.0)*20 || 2.0 ^ 1.0
-    float bufferScale = VolumeLog10 ? FMath::LogX(10, SampleScale) * 20.0 : FMath::Pow(SampleScale, ScaleExponent);
+    if (Start == Target) {
+        Audio::ArrayMultiplyByConstantInPlace(InSamples, Target);
+    } else if (Ramp == EOdinVolumeRamp::Exponential && Start > SilentGain && Target > SilentGain) {
+        ApplyExponentialRamp(InSamples, Start, Target);
+    } else {
+        Audio::ArrayFade(InSamples, Start, Target);
+    }
+}
+
+void UOdinVolumeEffect::ApplyExponentialRamp(const TArrayView<float> &InSamples, float StartGain, float EndGain)
+{
+    const int32 NumSamples  = InSamples.Num();
+    const int32 NumSegments = FMath::DivideAndRoundUp(NumSamples, ExponentialRampSegment);
+    // constant gain ratio per segment, so the ramp is linear on a decibel scale
+    const float SegmentRatio = FMath::Pow(EndGain / StartGain, 1.0f / NumSegments);
+
+    float SegmentStart = StartGain;
+    for (int32 Segment = 0; Segment < NumSegments; ++Segment) {
+        const int32 Offset     = Segment * ExponentialRampSegment;
+        const int32 Count      = FMath::Min(ExponentialRampSegment, NumSamples - Offset);
+        const float SegmentEnd = Segment + 1 == NumSegments ? EndGain : SegmentStart * SegmentRatio;
+        Audio::ArrayFade(InSamples.Slice(Offset, Count), SegmentStart, SegmentEnd);
+        SegmentStart = SegmentEnd;
+    }
+}
+
+void UOdinVolumeEffect::UpdateTargetGain()
+{
+    float Gain = 0.0f;
+    // scale close to silence
+    if (!FMath::IsNearlyEqual(SampleScale, 0.0, 0.001)) {
+        // Log10(2.0)*20 || 2.0 ^ 1.0
+        Gain = VolumeLog10 ? FMath::LogX(10, SampleScale) * 20.0 : FMath::Pow(SampleScale, ScaleExponent);
+    }
+    TargetGain.store(Gain, std::memory_order_relaxed);
+}
+
+void UOdinVolumeEffect::SetSampleScale(float NewSampleScale)
+{
+    SampleScale = NewSampleScale;
+    UpdateTargetGain();
+}
+
+float UOdinVolumeEffect::GetSampleScale() const
+{ return SampleScale; }
+
+void UOdinVolumeEffect::SetScaleExponent(float NewScaleExponent)
+{
+    ScaleExponent = NewScaleExponent;
+    UpdateTargetGain();
+}
+
+float UOdinVolumeEffect::GetScaleExponent() const
+{ return ScaleExponent; }
 
-    for (int32 i = 0; i < InSamples.Num(); i++)
-        InSamples[i] *= bufferScale;
+void UOdinVolumeEffect::SetVolumeLog10(bool bNewVolumeLog10)
+{
+    VolumeLog10 = bNewVolumeLog10;
+    UpdateTargetGain();
 }
 
+bool UOdinVolumeEffect::GetVolumeLog10() const
+{ return VolumeLog10; }
+
+float UOdinVolumeEffect::GetTargetGain() const
+{ return TargetGain.load(std::memory_order_relaxed); }
+
 UOdinVolumeEffect *UOdinVolumeEffect::ConstructVolumeEffect(UObject *WorldContextObject, float scale)
 {
     UOdinVolumeEffect *result = NewObject<UOdinVolumeEffect>(WorldContextObject);
-    result->SampleScale       = scale;
+    result->SetSampleScale(scale);
     return result;
 }
 
 void UOdinVolumeEffect::BeginDestroy()
-{ Super::BeginDestroy(); }
\ No newline at end of file
+{ Super::BeginDestroy(); }
@@ -5,23 +5,48 @@
 #include "Async/TaskGraphInterfaces.h"
 #include "AudioDeviceNotificationSubsystem.h"
 #include "OdinVoice.h"
+#include "HAL/PlatformTime.h"
 
 void UOdinAudioCapture::BeginDestroy()
 {
     ODIN_LOG(Verbose, "ODIN Destroy: %s", ANSI_TO_TCHAR(__FUNCTION__));
 
+    // the background task works on this object directly and has to finish before it can be destroyed
+    if (PendingDeviceChange.IsValid()) {
+        PendingDeviceChange.Wait();
+    }
+    if (Watchdog.IsValid()) {
+        Watchdog->Exit();
+    }
+
     Super::BeginDestroy();
     if (AudioCapture.IsStreamOpen() && AudioCapture.IsCapturing()) {
         AudioCapture.AbortStream();
     }
+
+    FScopeLock Lock(&CaptureSinksCS);
+    CaptureSinks.Empty();
 }
 
 void UOdinAudioCapture::PostInitProperties()
 {
     Super::PostInitProperties();
+    if (!HasAnyFlags(RF_ClassDefaultObject)) {
+        TWeakObjectPtr<UOdinAudioCapture> WeakThisPtr = this;
+        Watchdog = MakeUnique<FOdinCaptureWatchdog>([WeakThisPtr]() {
+            AsyncTask(ENamedThreads::GameThread, [WeakThisPtr]() {
+                if (UOdinAudioCapture* Capture = WeakThisPtr.Get()) {
+                    Capture->HandleCaptureStalled();
+                }
+            });
+        });
+    }
     if (GetWorld()) {
         if (UAudioDeviceNotificationSubsystem* AudioDeviceNotificationSubsystem = UAudioDeviceNotificationSubsystem::Get()) {
             AudioDeviceNotificationSubsystem->DefaultCaptureDeviceChangedNative.AddUObject(this, &UOdinAudioCapture::HandleDefaultDeviceChanged);
+            AudioDeviceNotificationSubsystem->DeviceAddedNative.AddUObject(this, &UOdinAudioCapture::HandleDeviceListChanged);
+            AudioDeviceNotificationSubsystem->DeviceRemovedNative.AddUObject(this, &UOdinAudioCapture::HandleDeviceListChanged);
+            AudioDeviceNotificationSubsystem->DeviceStateChangedNative.AddUObject(this, &UOdinAudioCapture::HandleDeviceStateChanged);
         } else {
             ODIN_LOG(Warning, TEXT("Could not retrieve Audio Device Notification Subsystem, "
                                    "can't detect changes of default capture device."));
@@ -29,8 +54,27 @@ void UOdinAudioCapture::PostInitProperties()
     }
 }
 
+void UOdinAudioCapture::HandleDeviceListChanged(FString DeviceId)
+{
+    ODIN_LOG(Verbose, TEXT("Recognized added or removed audio device %s, invalidating capture device cache."), *DeviceId);
+    InvalidateCaptureDevices();
+}
+
+void UOdinAudioCapture::HandleDeviceStateChanged(FString DeviceId, EAudioDeviceChangedState NewState)
+{
+    ODIN_LOG(Verbose, TEXT("Recognized state change of audio device %s, invalidating capture device cache."), *DeviceId);
+    InvalidateCaptureDevices();
+}
+
+void UOdinAudioCapture::InvalidateCaptureDevices()
+{
+    bCaptureDeviceCacheDirty = true;
+    OnCaptureDevicesChanged.Broadcast();
+}
+
 void UOdinAudioCapture::HandleDefaultDeviceChanged(EAudioDeviceChangedRole AudioDeviceChangedRole, FString DeviceId)
 {
+    InvalidateCaptureDevices();
     const bool bIsCurrentDeviceDefault = CurrentSelectedDevice.DeviceId.Equals(DefaultDeviceId);
     DefaultDeviceId                    = DeviceId;
 
@@ -40,8 +84,7 @@ void UOdinAudioCapture::HandleDefaultDeviceChanged(EAudioDeviceChangedRole Audio
         ODIN_LOG(Display, TEXT("Recognized change in default capture device. Current selected device is "
                                "default device, starting reconnect to new default device."));
 
-        bool bSuccess;
-        ChangeCaptureDeviceById(DeviceId, bSuccess);
+        AsyncChangeCaptureDeviceById(DeviceId, FChangeCaptureDeviceDelegate());
         OnDefaultDeviceChanged.Broadcast();
     }
 }
@@ -54,6 +97,79 @@ void UOdinAudioCapture::GetCaptureDevicesAvailable(TArray<FOdinCaptureDeviceInfo
         return;
     }
 
+    UpdateCaptureDeviceCache(false);
+    FScopeLock Lock(&CaptureDeviceCacheCS);
+    OutDevices.Append(CachedCaptureDevices);
+}
+
+void UOdinAudioCapture::RefreshCaptureDevices()
+{ UpdateCaptureDeviceCache(true); }
+
+int32 UOdinAudioCapture::GetCaptureDevicesVersion() const
+{ return static_cast<int32>(CaptureDeviceCacheVersion.load()); }
+
+bool UOdinAudioCapture::FindCaptureDeviceById(FString DeviceId, FOdinCaptureDeviceInfo& OutDevice)
+{
+    int32 DeviceIndex;
+    return FindCaptureDevice(FCaptureDeviceQuery{DeviceId, NAME_None}, DeviceIndex, OutDevice);
+}
+
+bool UOdinAudioCapture::FindCaptureDeviceByName(FName DeviceName, FOdinCaptureDeviceInfo& OutDevice)
+{
+    int32 DeviceIndex;
+    return FindCaptureDevice(FCaptureDeviceQuery{FString(), DeviceName}, DeviceIndex, OutDevice);
+}
+
+bool UOdinAudioCapture::UpdateCaptureDeviceCache(bool bForce)
+{
+    // a pending device change enumerates on its own task, the game thread keeps using the cached list meanwhile
+    if (IsCurrentlyChangingDevice && IsInGameThread()) {
+        return false;
+    }
+    // Clear the flag before enumerating, so a notification arriving in between marks the cache dirty again.
+    if (!bCaptureDeviceCacheDirty.exchange(false) && !bForce) {
+        return false;
+    }
+
+    TArray<FOdinCaptureDeviceInfo> Devices;
+    EnumerateCaptureDevices(Devices);
+
+    FScopeLock Lock(&CaptureDeviceCacheCS);
+    CachedCaptureDevices = MoveTemp(Devices);
+    CachedDeviceIndexById.Reset();
+    CachedDeviceIndexByName.Reset();
+    for (int32 i = 0; i < CachedCaptureDevices.Num(); ++i) {
+        // keep the first device on duplicate entries, same as the linear search before
+        if (!CachedDeviceIndexById.Contains(CachedCaptureDevices[i].DeviceId)) {
+            CachedDeviceIndexById.Add(CachedCaptureDevices[i].DeviceId, i);
+        }
+        if (!CachedDeviceIndexByName.Contains(CachedCaptureDevices[i].AudioCaptureInfo.DeviceName)) {
+            CachedDeviceIndexByName.Add(CachedCaptureDevices[i].AudioCaptureInfo.DeviceName, i);
+        }
+    }
+    ++CaptureDeviceCacheVersion;
+    ODIN_LOG(Verbose, TEXT("Refreshed capture device cache, %d devices, version %u."), CachedCaptureDevices.Num(), CaptureDeviceCacheVersion.load());
+    return true;
+}
+
+bool UOdinAudioCapture::FindCaptureDevice(const FCaptureDeviceQuery& Query, int32& OutDeviceIndex, FOdinCaptureDeviceInfo& OutDevice)
+{
+    UpdateCaptureDeviceCache(false);
+
+    FScopeLock   Lock(&CaptureDeviceCacheCS);
+    const int32* FoundIndex = Query.DeviceName.IsNone() ? CachedDeviceIndexById.Find(Query.DeviceId) : CachedDeviceIndexByName.Find(Query.DeviceName);
+    if (!FoundIndex) {
+        return false;
+    }
+    OutDeviceIndex = *FoundIndex;
+    OutDevice      = CachedCaptureDevices[OutDeviceIndex];
+    return true;
+}
+
+void UOdinAudioCapture::EnumerateCaptureDevices(TArray<FOdinCaptureDeviceInfo>& OutDevices)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinAudioCapture::EnumerateCaptureDevices);
+
     TArray<Audio::FCaptureDeviceInfo> CaptureDevices;
     AudioCapture.GetCaptureDevicesAvailable(CaptureDevices);
     for (Audio::FCaptureDeviceInfo CaptureDevice : CaptureDevices) {
@@ -77,16 +193,139 @@ void UOdinAudioCapture::ChangeToDefaultCaptureDevice()
 
 void UOdinAudioCapture::ChangeCaptureDeviceById(FString NewDeviceId, bool& bSuccess)
 {
-    // a lambda for finding a device by DeviceId
-    auto DeviceCheck = [NewDeviceId](FOdinCaptureDeviceInfo OdinCaptureDeviceInfo) -> bool { return NewDeviceId == OdinCaptureDeviceInfo.DeviceId; };
-    bSuccess         = ChangeCaptureDevice(DeviceCheck);
+    bSuccess = ChangeCaptureDevice(FCaptureDeviceQuery{NewDeviceId, NAME_None});
     if (!bSuccess) {
-        ODIN_LOG(Warning, TEXT("Did not find Capture Device with Device Id %s, Capture Device was not changed."), *NewDeviceId);
+        ODIN_LOG(Warning, TEXT("Could not change to Capture Device with Device Id %s, Capture Device was not changed."), *NewDeviceId);
+    }
+}
+
+void UOdinAudioCapture::AsyncChangeCaptureDeviceById(FString NewDeviceId, const FChangeCaptureDeviceDelegate& OnChangeCompleted)
+{
+    RunAsyncCaptureDeviceChange(FCaptureDeviceQuery{NewDeviceId, NAME_None}, false, OnChangeCompleted);
+}
+
+void UOdinAudioCapture::AsyncChangeCaptureDeviceByName(FName DeviceName, const FChangeCaptureDeviceDelegate& OnChangeCompleted)
+{
+    RunAsyncCaptureDeviceChange(FCaptureDeviceQuery{FString(), DeviceName}, false, OnChangeCompleted);
+}
+
+void UOdinAudioCapture::AsyncRestartCapturing(const FChangeCaptureDeviceDelegate& OnChangeCompleted)
+{
+    FCaptureDeviceQuery Query;
+    if (CurrentSelectedDeviceIndex >= 0) {
+        Query.DeviceId = CurrentSelectedDevice.DeviceId;
     }
+    RunAsyncCaptureDeviceChange(Query, true, OnChangeCompleted);
+}
+
+void UOdinAudioCapture::RunAsyncCaptureDeviceChange(FCaptureDeviceQuery Query, bool bForceReopen, FChangeCaptureDeviceDelegate OnChangeCompleted)
+{
+    TWeakObjectPtr<UOdinAudioCapture> WeakThisPtr = this;
+    TryRunAsyncChangeDeviceRequest(OnChangeCompleted, [WeakThisPtr, Query, bForceReopen, OnChangeCompleted]() {
+        UOdinAudioCapture* Capture = WeakThisPtr.Get();
+        if (!Capture) {
+            ODIN_LOG(Error, "Aborting RunAsyncCaptureDeviceChange due to invalid object ptr.");
+            return;
+        }
+
+        const FString       CurrentDeviceId = Capture->CurrentSelectedDevice.DeviceId;
+        FCaptureDeviceQuery DeviceQuery     = Query;
+        DeviceQuery.CaptureLatency          = Capture->CaptureLatency;
+        Capture->bFillCaptureGap            = true;
+        // Capture stays valid for the runtime of the task, BeginDestroy waits for PendingDeviceChange.
+        Capture->PendingDeviceChange =
+            Async(EAsyncExecution::ThreadPool, [Capture, WeakThisPtr, DeviceQuery, bForceReopen, CurrentDeviceId, OnChangeCompleted]() {
+                const FCaptureDeviceChangeResult Result = Capture->ReopenCaptureStream(DeviceQuery, bForceReopen, CurrentDeviceId);
+                AsyncTask(ENamedThreads::GameThread, [WeakThisPtr, Result, OnChangeCompleted]() {
+                    if (UOdinAudioCapture* CompletedCapture = WeakThisPtr.Get()) {
+                        CompletedCapture->CompleteCaptureDeviceChange(Result, OnChangeCompleted);
+                    }
+                });
+            });
+    });
+}
+
+UOdinAudioCapture::FCaptureDeviceChangeResult UOdinAudioCapture::ReopenCaptureStream(const FCaptureDeviceQuery& Query, bool bForceReopen,
+                                                                                     const FString& CurrentDeviceId)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinAudioCapture::ReopenCaptureStream);
+
+    FCaptureDeviceChangeResult Result;
+
+    bool bFoundDevice = false;
+    if (!Query.IsDefaultDevice()) {
+        bFoundDevice = FindCaptureDevice(Query, Result.DeviceIndex, Result.Device);
+    } else {
+        Audio::FCaptureDeviceInfo Current;
+        if (AudioCapture.GetCaptureDeviceInfo(Current)) {
+            // Default init with available data, works even if platform does not return valid device ids.
+            Result.Device.DeviceId         = Current.DeviceId;
+            Result.Device.AudioCaptureInfo = FAudioCaptureDeviceInfo{FName(Current.DeviceName), Current.InputChannels, Current.PreferredSampleRate};
+            Result.bIsDefaultDevice        = true;
+            bFoundDevice                   = true;
+            FindCaptureDevice(FCaptureDeviceQuery{Current.DeviceId, NAME_None}, Result.DeviceIndex, Result.Device);
+        }
+    }
+
+    if (!bFoundDevice) {
+        ODIN_LOG(Warning, TEXT("Did not find the requested Capture Device, Capture Device was not changed."));
+        return Result;
+    }
+
+    if (!bForceReopen && Result.Device.DeviceId == CurrentDeviceId) {
+        ODIN_LOG(Log, TEXT("Tried changing to the current selected Device. Doing nothing."));
+        Result.bSuccess = true;
+        return Result;
+    }
+
+    ODIN_LOG(Verbose, TEXT("Reopening capture stream asynchronously with index: %d and device id: %s"), Result.DeviceIndex, *Result.Device.DeviceId);
+    // the stream is started on the game thread, after the generator was initialized with the format of the new device
+    Result.bSuccess        = OpenCaptureStream(Result.DeviceIndex, Result.Device, Query.CaptureLatency);
+    Result.bStreamReopened = Result.bSuccess;
+    return Result;
+}
+
+void UOdinAudioCapture::CompleteCaptureDeviceChange(const FCaptureDeviceChangeResult& Result, FChangeCaptureDeviceDelegate OnChangeCompleted)
+{
+    // the background task has finished, so AudioCapture is only used from the game thread again
+    bool bSuccess = Result.bSuccess;
+    if (Result.bStreamReopened) {
+        const FOdinCaptureDeviceInfo PreviousDevice = CurrentSelectedDevice;
+        CurrentSelectedDeviceIndex                  = Result.DeviceIndex;
+        CurrentSelectedDevice                       = Result.Device;
+        if (Result.bIsDefaultDevice) {
+            DefaultDeviceId = CurrentSelectedDevice.DeviceId;
+        }
+        // generator delegates must not see blocks of the new device in the format of the old one
+        InitializeGenerator();
+        if (!bStopAfterDeviceChange) {
+            bSuccess = AudioCapture.StartStream();
+        }
+        if (PreviousDevice.DeviceId != CurrentSelectedDevice.DeviceId) {
+            OnCaptureDeviceChanged.Broadcast(PreviousDevice, CurrentSelectedDevice);
+        }
+    } else if (bStopAfterDeviceChange && AudioCapture.IsStreamOpen()) {
+        AudioCapture.StopStream();
+    }
+    bStopAfterDeviceChange = false;
+
+    // A change started by the watchdog leaves it disarmed and a failed change never reaches OpenCaptureStream, so arm it
+    // here to keep a still running stream monitored.
+    if (Watchdog.IsValid()) {
+        Watchdog->Arm(AllowedTimeWithoutStreamUpdate, AllowedTimeForStreamSetup);
+    }
+
+    FinalizeCaptureDeviceChange(OnChangeCompleted, bSuccess);
 }
 
 void UOdinAudioCapture::StartCapturing(bool& bSuccess)
 {
+    if (IsCurrentlyChangingDevice) {
+        ODIN_LOG(Warning, TEXT("Currently in the process of changing the Capture Device asynchronously, ignoring "
+                               "Start Capturing Request."));
+        bSuccess = false;
+        return;
+    }
     if (AudioCapture.IsStreamOpen()) {
         bSuccess = AudioCapture.StartStream();
         return;
@@ -94,15 +333,22 @@ void UOdinAudioCapture::StartCapturing(bool& bSuccess)
     bSuccess = false;
 }
 
+void UOdinAudioCapture::StopCapturing()
+{
+    if (IsCurrentlyChangingDevice) {
+        bStopAfterDeviceChange = true;
+        return;
+    }
+    if (AudioCapture.IsStreamOpen()) {
+        AudioCapture.StopStream();
+    }
+}
+
 void UOdinAudioCapture::ChangeCaptureDeviceByName(FName DeviceName, bool& bSuccess)
 {
-    // a lambda for finding a device by DeviceName
-    auto DeviceCheck = [DeviceName](FOdinCaptureDeviceInfo OdinCaptureDeviceInfo) -> bool {
-        return DeviceName == OdinCaptureDeviceInfo.AudioCaptureInfo.DeviceName;
-    };
-    bSuccess = ChangeCaptureDevice(DeviceCheck);
+    bSuccess = ChangeCaptureDevice(FCaptureDeviceQuery{FString(), DeviceName});
     if (!bSuccess) {
-        ODIN_LOG(Warning, TEXT("Did not find Capture Device with name %s, Capture Device was not changed."), *DeviceName.ToString());
+        ODIN_LOG(Warning, TEXT("Could not change to Capture Device with name %s, Capture Device was not changed."), *DeviceName.ToString());
     }
 }
 
@@ -149,48 +395,44 @@ void UOdinAudioCapture::FinalizeCaptureDeviceChange(FChangeCaptureDeviceDelegate
     }
 }
 
-template <typename DeviceCheck> bool UOdinAudioCapture::ChangeCaptureDevice(const DeviceCheck& DeviceCheckFunction)
+bool UOdinAudioCapture::ChangeCaptureDevice(const FCaptureDeviceQuery& Query)
 {
-    TArray<FOdinCaptureDeviceInfo> AllDevices;
-    GetCaptureDevicesAvailable(AllDevices);
+    if (IsCurrentlyChangingDevice) {
+        ODIN_LOG(Warning, TEXT("Currently in the process of changing the Capture Device asynchronously, ignoring "
+                               "synchronous Change Device Request."));
+        return false;
+    }
 
-    FOdinCaptureDeviceInfo PreviousDevice;
-    bool                   bSuccess = false;
-    // look for the name of the selected device.
-    for (int32 i = 0; i < AllDevices.Num(); ++i) {
-        const FOdinCaptureDeviceInfo OdinCaptureDeviceInfo = AllDevices[i];
-        if (DeviceCheckFunction(OdinCaptureDeviceInfo)) {
-            if (OdinCaptureDeviceInfo.DeviceId == CurrentSelectedDevice.DeviceId) {
-                ODIN_LOG(Log, TEXT("Tried changing to the current selected Device. Doing nothing."));
-                return true;
-            } else {
-                CurrentSelectedDeviceIndex = i;
-                PreviousDevice             = CurrentSelectedDevice;
-                CurrentSelectedDevice      = OdinCaptureDeviceInfo;
-                bSuccess                   = true;
-            }
-            break;
-        }
+    int32                  DeviceIndex;
+    FOdinCaptureDeviceInfo Device;
+    if (!FindCaptureDevice(Query, DeviceIndex, Device)) {
+        return false;
     }
 
-    if (bSuccess) {
+    if (Device.DeviceId == CurrentSelectedDevice.DeviceId) {
+        ODIN_LOG(Log, TEXT("Tried changing to the current selected Device. Doing nothing."));
+        return true;
+    }
 
-        ODIN_LOG(Verbose, TEXT("Selected index: %d with device id: %s"), CurrentSelectedDeviceIndex, *CurrentSelectedDevice.DeviceId);
+    const FOdinCaptureDeviceInfo PreviousDevice = CurrentSelectedDevice;
+    CurrentSelectedDeviceIndex                  = DeviceIndex;
+    CurrentSelectedDevice                       = Device;
 
-        if (IsInGameThread()) {
-            RestartCapturing();
-            OnCaptureDeviceChanged.Broadcast(PreviousDevice, CurrentSelectedDevice);
-        } else {
-            TWeakObjectPtr<UOdinAudioCapture> WeakThisPtr = this;
-            AsyncTask(ENamedThreads::GameThread, [WeakThisPtr, PreviousDevice]() {
-                if (WeakThisPtr.IsValid()) {
-                    WeakThisPtr->RestartCapturing();
-                    WeakThisPtr->OnCaptureDeviceChanged.Broadcast(PreviousDevice, WeakThisPtr->CurrentSelectedDevice);
-                }
-            });
-        }
+    ODIN_LOG(Verbose, TEXT("Selected index: %d with device id: %s"), CurrentSelectedDeviceIndex, *CurrentSelectedDevice.DeviceId);
+
+    if (IsInGameThread()) {
+        RestartCapturing();
+        OnCaptureDeviceChanged.Broadcast(PreviousDevice, CurrentSelectedDevice);
+    } else {
+        TWeakObjectPtr<UOdinAudioCapture> WeakThisPtr = this;
+        AsyncTask(ENamedThreads::GameThread, [WeakThisPtr, PreviousDevice]() {
+            if (WeakThisPtr.IsValid()) {
+                WeakThisPtr->RestartCapturing();
+                WeakThisPtr->OnCaptureDeviceChanged.Broadcast(PreviousDevice, WeakThisPtr->CurrentSelectedDevice);
+            }
+        });
     }
-    return bSuccess;
+    return true;
 }
 
 bool UOdinAudioCapture::IsStreamOpen() const
@@ -200,6 +442,9 @@ bool UOdinAudioCapture::IsStreamOpen() const
                              "supported. Returning false by default."));
         return false;
     }
+    if (IsCurrentlyChangingDevice) {
+        return false;
+    }
     return AudioCapture.IsStreamOpen();
 }
 
@@ -210,48 +455,56 @@ float UOdinAudioCapture::GetStreamTime() const
                              "not supported."));
         return 0.0f;
     }
+    if (IsCurrentlyChangingDevice) {
+        return 0.0f;
+    }
 
     double StreamTime;
     AudioCapture.GetStreamTime(StreamTime);
     return static_cast<float>(StreamTime);
 }
 
-void UOdinAudioCapture::Tick(float DeltaTime)
+void UOdinAudioCapture::SetCaptureLatency(EOdinCaptureLatency NewCaptureLatency)
+{ CaptureLatency = NewCaptureLatency; }
+
+EOdinCaptureLatency UOdinAudioCapture::GetCaptureLatency() const
+{ return CaptureLatency; }
+
+int32 UOdinAudioCapture::GetMeasuredCaptureBufferFrames() const
+{ return MeasuredBufferFrames.load(std::memory_order_relaxed); }
+
+float UOdinAudioCapture::GetMeasuredCaptureBufferMs() const
 {
-    // Check if the stream is still active.
-    // We have to use the stream time, because AudioCapture.IsCapturing() or
-    // AudioCapture.IsStreamOpen() do NOT recognize that the underlying capture device was removed.
-    if (IsValidLowLevel() && AudioCapture.IsCapturing()) {
-        double CurrentStreamTime;
-        AudioCapture.GetStreamTime(CurrentStreamTime);
-        if (!FMath::IsNearlyEqual(CurrentStreamTime, LastStreamTime)) {
-            TimeWithoutStreamUpdate = 0.0f;
-            LastStreamTime          = CurrentStreamTime;
-        } else {
-            TimeWithoutStreamUpdate += DeltaTime;
-
-            const bool bIsStreamSettingUp = CurrentStreamTime < AllowedTimeForStreamSetup;
-            const bool bIsStreamOffline   = TimeWithoutStreamUpdate > AllowedTimeWithoutStreamUpdate;
-            if (bIsStreamOffline && !bIsStreamSettingUp) {
-                ODIN_LOG(Warning, TEXT("Recognized disconnected Capture Device, restarting Capture Stream "
-                                       "with Default Device..."));
-
-                TimeWithoutStreamUpdate = 0.0f;
-                LastStreamTime          = 0.0f;
-
-                // Reset current device info, in case the user switched the capture device format
-                // instead of changing the capture device.
-                CurrentSelectedDeviceIndex = INDEX_NONE;
-                CurrentSelectedDevice      = FOdinCaptureDeviceInfo();
-                ChangeToDefaultCaptureDevice();
-                OnCaptureDeviceReset.Broadcast();
-            }
-        }
+    const int32 MeasuredSampleRate = MeasuredBufferSampleRate.load(std::memory_order_relaxed);
+    if (MeasuredSampleRate <= 0) {
+        return 0.0f;
     }
+    return 1000.0f * GetMeasuredCaptureBufferFrames() / MeasuredSampleRate;
 }
 
-bool UOdinAudioCapture::IsTickable() const
-{ return GetTryRecognizingDeviceDisconnected(); }
+void UOdinAudioCapture::HandleCaptureStalled()
+{
+    // We have to rely on callbacks, because AudioCapture.IsCapturing() or AudioCapture.IsStreamOpen()
+    // do NOT recognize that the underlying capture device was removed. A stream that was stopped on
+    // purpose does not deliver callbacks either, so keep watching without restarting.
+    // The watchdog disarms itself before calling us, so it has to be armed again whenever no restart is started here.
+    if (!GetTryRecognizingDeviceDisconnected() || IsCurrentlyChangingDevice || !AudioCapture.IsCapturing()) {
+        if (Watchdog.IsValid() && (IsCurrentlyChangingDevice || AudioCapture.IsStreamOpen())) {
+            Watchdog->Arm(AllowedTimeWithoutStreamUpdate, AllowedTimeForStreamSetup);
+        }
+        return;
+    }
+
+    ODIN_LOG(Warning, TEXT("Recognized disconnected Capture Device, restarting Capture Stream "
+                           "with Default Device..."));
+
+    // Reset current device info, in case the user switched the capture device format
+    // instead of changing the capture device.
+    CurrentSelectedDeviceIndex = INDEX_NONE;
+    CurrentSelectedDevice      = FOdinCaptureDeviceInfo();
+    AsyncRestartCapturing(FChangeCaptureDeviceDelegate());
+    OnCaptureDeviceReset.Broadcast();
+}
 
 void UOdinAudioCapture::InitializeGenerator()
 {
@@ -299,15 +552,8 @@ void UOdinAudioCapture::TryRetrieveDefaultDevice()
         ODIN_LOG(Log, TEXT("Retrieved Current Default Device with Id %s"), *Current.DeviceId);
 
         // Try to get actual data
-        TArray<FOdinCaptureDeviceInfo> OutDevices;
-        GetCaptureDevicesAvailable(OutDevices);
-        for (int32 i = 0; i < OutDevices.Num(); ++i) {
-            if (OutDevices[i].DeviceId == Current.DeviceId) {
-                CurrentSelectedDeviceIndex = i;
-                CurrentSelectedDevice      = OutDevices[CurrentSelectedDeviceIndex];
-                DefaultDeviceId            = CurrentSelectedDevice.DeviceId;
-                break;
-            }
+        if (FindCaptureDevice(FCaptureDeviceQuery{Current.DeviceId, NAME_None}, CurrentSelectedDeviceIndex, CurrentSelectedDevice)) {
+            DefaultDeviceId = CurrentSelectedDevice.DeviceId;
         }
     } else {
         ODIN_LOG(Error, TEXT("Error when trying to retrieve Default Device Index. This could happen if "
@@ -331,28 +577,18 @@ bool UOdinAudioCapture::RestartCapturing(bool bAutomaticallyStartCapture)
                              "aborting restart."));
         return false;
     }
-
-    if (AudioCapture.IsStreamOpen()) {
-        AudioCapture.CloseStream();
+    if (IsCurrentlyChangingDevice) {
+        ODIN_LOG(Warning, TEXT("Currently in the process of changing the Capture Device asynchronously, ignoring "
+                               "Restart Capturing Request."));
+        return false;
     }
-    // Below here is basically a copy of the UAudioCapture::OpenDefaultAudioStream() implementation,
-    // except for setting the Params.DeviceIndex.
-    Audio::FOnAudioCaptureFunction OnCapture = [this](const void* AudioData, int32 NumFrames, int32 InNumChannels, int32 InSampleRate, double StreamTime,
-                                                      bool bOverFlow) { OnCaptureCallback(static_cast<const float*>(AudioData), NumFrames, InNumChannels); };
 
     if (CurrentSelectedDeviceIndex < 0) {
         TryRetrieveDefaultDevice();
     }
 
-    Audio::FAudioCaptureDeviceParams Params;
-    Params.DeviceIndex = CurrentSelectedDeviceIndex;
-
-    const int32 SelectedDeviceOptimalFrames =
-        CurrentSelectedDevice.AudioCaptureInfo.SampleRate * CurrentSelectedDevice.AudioCaptureInfo.NumInputChannels * (20.0f / 1000.0f);
-
-    ODIN_LOG(Verbose, "Selected Device Optimal Frames: %d, Choosing ODIN-preferred NumFramesDesired: %d", SelectedDeviceOptimalFrames,
-             SelectedDeviceOptimalFrames);
-    bool bSuccess = AudioCapture.OpenAudioCaptureStream(Params, MoveTemp(OnCapture), SelectedDeviceOptimalFrames);
+    bFillCaptureGap = true;
+    bool bSuccess   = OpenCaptureStream(CurrentSelectedDeviceIndex, CurrentSelectedDevice, CaptureLatency);
     // OpenCaptureStream automatically closes the capture stream, if it's already active.
     if (bSuccess) {
         // If we opened the capture stream successfully, get the capture device info and initialize
@@ -366,9 +602,214 @@ bool UOdinAudioCapture::RestartCapturing(bool bAutomaticallyStartCapture)
     return bSuccess;
 }
 
-void UOdinAudioCapture::OnCaptureCallback(const float* AudioData, int32 NumFrames, int32 InNumChannels)
+bool UOdinAudioCapture::OpenCaptureStream(int32 DeviceIndex, const FOdinCaptureDeviceInfo& Device, EOdinCaptureLatency Latency)
 {
-    const int32 NumSamples = NumFrames * InNumChannels;
-    ODIN_LOG(VeryVerbose, "OnCaptureCallback with Num Samples: %d", NumSamples);
-    OnGeneratedAudio(AudioData, NumSamples);
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinAudioCapture::OpenCaptureStream)
+
+    if (Watchdog.IsValid()) {
+        Watchdog->Disarm();
+    }
+    if (AudioCapture.IsStreamOpen()) {
+        AudioCapture.CloseStream();
+    }
+    // Below here is basically a copy of the UAudioCapture::OpenDefaultAudioStream() implementation,
+    // except for setting the Params.DeviceIndex.
+    Audio::FOnAudioCaptureFunction OnCapture = [this](const void* AudioData, int32 NumFrames, int32 InNumChannels, int32 InSampleRate, double StreamTime,
+                                                      bool bOverFlow) {
+        OnCaptureCallback(static_cast<const float*>(AudioData), NumFrames, InNumChannels, InSampleRate, StreamTime, bOverFlow);
+    };
+
+    Audio::FAudioCaptureDeviceParams Params;
+    Params.DeviceIndex = DeviceIndex;
+
+    // NumFramesDesired is counted per channel, independent of the device channel count.
+    const int32 NumFramesDesired = GetNumFramesForLatency(Device.AudioCaptureInfo.SampleRate, Latency);
+
+    ODIN_LOG(Verbose, "Choosing ODIN-preferred NumFramesDesired: %d (%d ms at %d Hz)", NumFramesDesired, static_cast<int32>(Latency),
+             Device.AudioCaptureInfo.SampleRate);
+    MeasuredBufferFrames = 0;
+    BeginCaptureStats(Device.DeviceId);
+    {
+        FScopeLock Lock(&CaptureSinksCS);
+        for (const FOdinCaptureSinkPtr& Sink : CaptureSinks) {
+            Sink->PrepareCapture(Device.AudioCaptureInfo.NumInputChannels, Device.AudioCaptureInfo.SampleRate);
+        }
+    }
+    const bool bSuccess = AudioCapture.OpenAudioCaptureStream(Params, MoveTemp(OnCapture), NumFramesDesired);
+    if (bSuccess && Watchdog.IsValid()) {
+        Watchdog->Arm(AllowedTimeWithoutStreamUpdate, AllowedTimeForStreamSetup);
+    }
+    return bSuccess;
+}
+
+void UOdinAudioCapture::AddCaptureSink(FOdinCaptureSinkPtr Sink)
+{
+    if (!Sink.IsValid()) {
+        ODIN_LOG(Warning, TEXT("Tried adding an invalid capture sink to %s."), *GetName());
+        return;
+    }
+
+    FScopeLock Lock(&CaptureSinksCS);
+    Sink->PrepareCapture(CurrentSelectedDevice.AudioCaptureInfo.NumInputChannels, CurrentSelectedDevice.AudioCaptureInfo.SampleRate);
+    CaptureSinks.AddUnique(MoveTemp(Sink));
+}
+
+bool UOdinAudioCapture::RemoveCaptureSink(const FOdinCaptureSinkPtr& Sink)
+{
+    FScopeLock Lock(&CaptureSinksCS);
+    return CaptureSinks.Remove(Sink) > 0;
+}
+
+void UOdinAudioCapture::PrepareCaptureSink(const FOdinCaptureSinkPtr& Sink)
+{
+    // sinks are only invoked while holding the lock, so the capture thread cannot use the sink meanwhile
+    FScopeLock Lock(&CaptureSinksCS);
+    if (Sink.IsValid() && CaptureSinks.Contains(Sink)) {
+        Sink->PrepareCapture(CurrentSelectedDevice.AudioCaptureInfo.NumInputChannels, CurrentSelectedDevice.AudioCaptureInfo.SampleRate);
+    }
+}
+
+void UOdinAudioCapture::OnCaptureCallback(const float* AudioData, int32 NumFrames, int32 InNumChannels, int32 InSampleRate, double StreamTime, bool bOverFlow)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinAudioCapture::OnCaptureCallback);
+
+    ODIN_LOG(VeryVerbose, "OnCaptureCallback with Num Samples: %d", NumFrames * InNumChannels);
+
+    FOdinCaptureBlockInfo BlockInfo;
+    BlockInfo.StreamTime  = StreamTime;
+    BlockInfo.ReceiveTime = FPlatformTime::Seconds();
+    BlockInfo.bOverflow   = bOverFlow;
+    RecordCaptureTiming(BlockInfo, NumFrames, InSampleRate);
+
+    if (bFillCaptureGap.exchange(false)) {
+        FillCaptureGap(NumFrames, InNumChannels, InSampleRate);
+    }
+    if (Watchdog.IsValid()) {
+        Watchdog->NotifyCallback();
+    }
+    MeasuredBufferFrames.store(NumFrames, std::memory_order_relaxed);
+    MeasuredBufferSampleRate.store(InSampleRate, std::memory_order_relaxed);
+
+    DispatchCapturedAudio(AudioData, NumFrames, InNumChannels, InSampleRate, BlockInfo);
+}
+
+void UOdinAudioCapture::RecordCaptureTiming(const FOdinCaptureBlockInfo& BlockInfo, int32 NumFrames, int32 InSampleRate)
+{
+    CaptureBlockCount.fetch_add(1, std::memory_order_relaxed);
+    if (BlockInfo.bOverflow) {
+        CaptureOverflowCount.fetch_add(1, std::memory_order_relaxed);
+        ODIN_LOG(Verbose, "Capture device reported an overflow at stream time %.3f s", BlockInfo.StreamTime);
+    }
+
+    if (LastCaptureReceiveTime > 0.0 && InSampleRate > 0) {
+        const double ArrivalDelta = BlockInfo.ReceiveTime - LastCaptureReceiveTime;
+        const double StreamDelta  = BlockInfo.StreamTime - LastCaptureStreamTime;
+        // the device clock advanced further than the previous block covered, so the driver dropped audio
+        if (StreamDelta > LastCaptureBlockSeconds * 1.5) {
+            CaptureDiscontinuityCount.fetch_add(1, std::memory_order_relaxed);
+            ODIN_LOG(Verbose, "Capture stream time skipped %.1f ms ahead", (StreamDelta - LastCaptureBlockSeconds) * 1000.0);
+        }
+
+        // interarrival jitter as in RFC 3550, the stream time takes the role of the media timestamp
+        const float Deviation = static_cast<float>(FMath::Abs(ArrivalDelta - StreamDelta) * 1000.0);
+        const float Jitter    = CaptureJitterMs.load(std::memory_order_relaxed);
+        CaptureJitterMs.store(Jitter + (Deviation - Jitter) / 16.0f, std::memory_order_relaxed);
+        if (Deviation > CaptureMaxJitterMs.load(std::memory_order_relaxed)) {
+            CaptureMaxJitterMs.store(Deviation, std::memory_order_relaxed);
+        }
+    }
+    LastCaptureReceiveTime  = BlockInfo.ReceiveTime;
+    LastCaptureStreamTime   = BlockInfo.StreamTime;
+    LastCaptureBlockSeconds = InSampleRate > 0 ? static_cast<double>(NumFrames) / InSampleRate : 0.0;
+}
+
+void UOdinAudioCapture::BeginCaptureStats(const FString& DeviceId)
+{
+    FScopeLock Lock(&CaptureStatsCS);
+    if (CaptureBlockCount.load() > 0) {
+        CaptureStatsByDevice.Add(CaptureStatsDeviceId, SnapshotCaptureStats());
+    }
+
+    const FOdinCaptureStats* Previous = CaptureStatsByDevice.Find(DeviceId);
+    CaptureStatsDeviceId              = DeviceId;
+    CaptureBlockCount                 = Previous ? Previous->NumBlocks : 0;
+    CaptureOverflowCount              = Previous ? Previous->NumOverflows : 0;
+    CaptureDiscontinuityCount         = Previous ? Previous->NumStreamDiscontinuities : 0;
+    CaptureMaxJitterMs                = Previous ? Previous->MaxJitterMs : 0.0f;
+    CaptureJitterMs                   = 0.0f;
+    // the stream is closed here, so the capture thread does not touch its timing state
+    LastCaptureReceiveTime = 0.0;
+}
+
+FOdinCaptureStats UOdinAudioCapture::SnapshotCaptureStats() const
+{
+    FOdinCaptureStats Stats;
+    Stats.DeviceId                 = CaptureStatsDeviceId;
+    Stats.NumBlocks                = CaptureBlockCount.load(std::memory_order_relaxed);
+    Stats.NumOverflows             = CaptureOverflowCount.load(std::memory_order_relaxed);
+    Stats.NumStreamDiscontinuities = CaptureDiscontinuityCount.load(std::memory_order_relaxed);
+    Stats.JitterMs                 = CaptureJitterMs.load(std::memory_order_relaxed);
+    Stats.MaxJitterMs              = CaptureMaxJitterMs.load(std::memory_order_relaxed);
+    return Stats;
+}
+
+FOdinCaptureStats UOdinAudioCapture::GetCaptureStats() const
+{
+    FScopeLock Lock(&CaptureStatsCS);
+    return SnapshotCaptureStats();
+}
+
+bool UOdinAudioCapture::GetCaptureStatsForDevice(const FString& DeviceId, FOdinCaptureStats& OutStats) const
+{
+    FScopeLock Lock(&CaptureStatsCS);
+    if (DeviceId == CaptureStatsDeviceId && CaptureBlockCount.load() > 0) {
+        OutStats = SnapshotCaptureStats();
+        return true;
+    }
+    if (const FOdinCaptureStats* Stats = CaptureStatsByDevice.Find(DeviceId)) {
+        OutStats = *Stats;
+        return true;
+    }
+    return false;
+}
+
+void UOdinAudioCapture::DispatchCapturedAudio(const float* AudioData, int32 NumFrames, int32 InNumChannels, int32 InSampleRate,
+                                              const FOdinCaptureBlockInfo& BlockInfo)
+{
+    {
+        // Sinks are only added or removed from the game thread, so this lock is uncontended while capturing.
+        FScopeLock Lock(&CaptureSinksCS);
+        for (const FOdinCaptureSinkPtr& Sink : CaptureSinks) {
+            Sink->OnCapturedAudio(AudioData, NumFrames, InNumChannels, InSampleRate, BlockInfo);
+        }
+    }
+    OnGeneratedAudio(AudioData, NumFrames * InNumChannels);
+}
+
+void UOdinAudioCapture::FillCaptureGap(int32 BlockFrames, int32 InNumChannels, int32 InSampleRate)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinAudioCapture::FillCaptureGap);
+
+    const double LastCallbackTime = Watchdog.IsValid() ? Watchdog->GetLastCallbackTime() : 0.0;
+    if (LastCallbackTime <= 0.0 || BlockFrames <= 0 || InNumChannels <= 0) {
+        return;
+    }
+
+    const double GapSeconds      = FMath::Min(FPlatformTime::Seconds() - LastCallbackTime, static_cast<double>(MaxCaptureGapFillSeconds));
+    int32        NumGapFrames    = static_cast<int32>(GapSeconds * InSampleRate);
+    const int32  NumBlockSamples = BlockFrames * InNumChannels;
+    if (CaptureGapSilence.Num() < NumBlockSamples) {
+        CaptureGapSilence.SetNumZeroed(NumBlockSamples);
+    }
+
+    FOdinCaptureBlockInfo GapInfo;
+    GapInfo.ReceiveTime = FPlatformTime::Seconds();
+    GapInfo.bGapFill    = true;
+
+    ODIN_LOG(Verbose, "Filling capture gap of %.1f ms with silence.", GapSeconds * 1000.0);
+    while (NumGapFrames > 0) {
+        const int32 NumFrames = FMath::Min(NumGapFrames, BlockFrames);
+        DispatchCapturedAudio(CaptureGapSilence.GetData(), NumFrames, InNumChannels, InSampleRate, GapInfo);
+        NumGapFrames -= NumFrames;
+    }
 }
@@ -3,11 +3,13 @@
 #include "GenericPlatform/GenericPlatformAffinity.h"
 #include "GenericPlatform/GenericPlatformProcess.h"
 #include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
 #include "HAL/RunnableThread.h"
 #include "HAL/Event.h"
 #include "OdinSubsystem.h"
 #include "OdinVoice.h"
 #include "odin.h"
+#include "OdinAudio/OdinPipelineTiming.h"
 #include "OdinFunctionLibrary.h"
 
 FOdinAudioPushDataThread::FOdinAudioPushDataThread()
@@ -19,15 +21,20 @@ FOdinAudioPushDataThread::FOdinAudioPushDataThread()
 
 FOdinAudioPushDataThread::~FOdinAudioPushDataThread() = default;
 
-void FOdinAudioPushDataThread::LinkEncoder(OdinEncoder* Encoder, OdinRoom* TargetRoom)
+void FOdinAudioPushDataThread::StartThread()
 {
-    TRACE_CPUPROFILER_EVENT_SCOPE(FOdinAudioPushDataThread::LinkEncoder)
     if (!bIsRunning) {
         bIsRunning = true;
         PushEvent  = FGenericPlatformProcess::GetSynchEventFromPool();
         check(PushEvent);
         Thread.Reset(FRunnableThread::Create(this, TEXT("OdinPushAudioThread"), 0, TPri_TimeCritical));
     }
+}
+
+void FOdinAudioPushDataThread::LinkEncoder(OdinEncoder* Encoder, OdinRoom* TargetRoom)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FOdinAudioPushDataThread::LinkEncoder)
+    StartThread();
 
     if (Encoder && TargetRoom && UOdinSubsystem::GlobalIsRoomValid(TargetRoom)) {
         UnlinkEncoder(Encoder);
@@ -38,6 +45,20 @@ void FOdinAudioPushDataThread::LinkEncoder(OdinEncoder* Encoder, OdinRoom* Targe
     }
 }
 
+void FOdinAudioPushDataThread::LinkEncoderWithoutRoom(OdinEncoder* Encoder)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FOdinAudioPushDataThread::LinkEncoderWithoutRoom)
+    StartThread();
+
+    if (Encoder) {
+        UnlinkEncoder(Encoder);
+
+        FScopeLock Lock(&EncoderRoomLinkCS);
+        EncodersWithoutRoom.Add(Encoder);
+        ODIN_LOG(Verbose, "Linking Encoder %p without room", Encoder);
+    }
+}
+
 bool FOdinAudioPushDataThread::UnlinkEncoder(OdinEncoder* EncoderHandle)
 {
     TRACE_CPUPROFILER_EVENT_SCOPE(FOdinAudioPushDataThread::UnlinkEncoder)
@@ -48,10 +69,11 @@ bool FOdinAudioPushDataThread::UnlinkEncoder(OdinEncoder* EncoderHandle)
     if (bFoundEntry && RemovedRoomHandle) {
         ODIN_LOG(Verbose, "Unlinked Encoder %p from Room %p", EncoderHandle, RemovedRoomHandle);
     }
-    return bFoundEntry;
+    return EncodersWithoutRoom.Remove(EncoderHandle) > 0 || bFoundEntry;
 }
 
-void FOdinAudioPushDataThread::PushAudioToEncoder(OdinEncoder* TargetEncoder, TArray<float>&& Audio)
+void FOdinAudioPushDataThread::PushAudioToEncoder(OdinEncoder* TargetEncoder, TArray<float>&& Audio, const FOdinCaptureBlockInfo& BlockInfo,
+                                                  const FOdinAudioBufferPoolPtr& ReturnPool)
 {
     if (!TargetEncoder) {
         ODIN_LOG(Error, "Tried pushing audio to null encoder");
@@ -59,11 +81,38 @@ void FOdinAudioPushDataThread::PushAudioToEncoder(OdinEncoder* TargetEncoder, TA
     }
 
     if (!Audio.IsEmpty()) {
-        FOdinEncoderAudioFrame NewFrame{.EncoderHandle = TargetEncoder, .Audio = MoveTemp(Audio)};
+        FOdinEncoderAudioFrame NewFrame{.EncoderHandle = TargetEncoder, .Audio = MoveTemp(Audio), .BlockInfo = BlockInfo, .ReturnPool = ReturnPool};
         AudioPushQueue.Enqueue(MoveTemp(NewFrame));
     }
 }
 
+bool FOdinAudioPushDataThread::SwapEncoder(OdinEncoder* OldEncoder, OdinEncoder* NewEncoder)
+{
+    if (!bIsRunning || !OldEncoder || !NewEncoder || OldEncoder == NewEncoder) {
+        return false;
+    }
+
+    // Frames captured in between may still carry the old handle, keep redirecting them for two push cycles.
+    EncoderSwapQueue.Enqueue(FOdinEncoderSwap{.OldEncoder = OldEncoder, .NewEncoder = NewEncoder, .GraceCycles = 2});
+    return true;
+}
+
+void FOdinAudioPushDataThread::RetireEncoder(OdinEncoder* Encoder)
+{
+    if (!Encoder) {
+        return;
+    }
+
+    if (!bIsRunning) {
+        ODIN_LOG(Verbose, "Freeing retired Encoder %p", Encoder);
+        odin_encoder_free(Encoder);
+        return;
+    }
+
+    // a swap without replacement, late frames are redirected to null and dropped
+    EncoderSwapQueue.Enqueue(FOdinEncoderSwap{.OldEncoder = Encoder, .NewEncoder = nullptr, .GraceCycles = 2});
+}
+
 uint32 FOdinAudioPushDataThread::Run()
 {
     TArray<uint8> ByteArray;
@@ -75,8 +124,10 @@ uint32 FOdinAudioPushDataThread::Run()
         if (bIsRunning) {
             TRACE_CPUPROFILER_EVENT_SCOPE(FOdinAudioPushDataThread::Run);
             CleanupLinks();
+            ApplyEncoderSwaps(ByteArray);
             PushQueuedAudio();
             PopAllEncoders(ByteArray);
+            ReleaseRetiredEncoders(false);
         }
     }
     return 0;
@@ -103,28 +154,120 @@ void FOdinAudioPushDataThread::CleanupLinks()
     }
 }
 
+void FOdinAudioPushDataThread::ApplyEncoderSwaps(TArray<uint8>& DatagramBuffer)
+{
+    FOdinEncoderSwap Swap;
+    while (EncoderSwapQueue.Dequeue(Swap)) {
+        TRACE_CPUPROFILER_EVENT_SCOPE(FOdinAudioPushDataThread::ApplyEncoderSwaps);
+
+        OdinRoom* TargetRoom = nullptr;
+        {
+            FScopeLock Lock(&EncoderRoomLinkCS);
+            if (EncoderRoomLinks.RemoveAndCopyValue(Swap.OldEncoder, TargetRoom) && TargetRoom && Swap.NewEncoder) {
+                EncoderRoomLinks.Add(Swap.NewEncoder, TargetRoom);
+            }
+            if (EncodersWithoutRoom.Remove(Swap.OldEncoder) > 0 && Swap.NewEncoder) {
+                EncodersWithoutRoom.Add(Swap.NewEncoder);
+            }
+        }
+        ODIN_LOG(Verbose, "Swapped Encoder %p to Encoder %p for Room %p", Swap.OldEncoder, Swap.NewEncoder, TargetRoom);
+
+        // Send everything the old encoder already completed, its last partial frame is superseded by the new encoder.
+        if (TargetRoom) {
+            uint32 NumBytes = 1300;
+            DatagramBuffer.SetNumUninitialized(NumBytes);
+            while (odin_encoder_pop(Swap.OldEncoder, DatagramBuffer.GetData(), &NumBytes) == ODIN_ERROR_SUCCESS) {
+                SendDatagramToRoom(TargetRoom, DatagramBuffer, NumBytes);
+                NumBytes = 1300;
+            }
+        }
+        RetiredEncoders.Add(Swap);
+    }
+}
+
+void FOdinAudioPushDataThread::ReleaseRetiredEncoders(const bool bForce)
+{
+    for (int32 i = RetiredEncoders.Num() - 1; i >= 0; --i) {
+        if (bForce || --RetiredEncoders[i].GraceCycles <= 0) {
+            ODIN_LOG(Verbose, "Freeing retired Encoder %p", RetiredEncoders[i].OldEncoder);
+            odin_encoder_free(RetiredEncoders[i].OldEncoder);
+            RetiredEncoders.RemoveAtSwap(i);
+        }
+    }
+}
+
 void FOdinAudioPushDataThread::PushQueuedAudio()
 {
     TRACE_CPUPROFILER_EVENT_SCOPE(FOdinAudioPushDataThread::PushQueuedAudio);
     FOdinEncoderAudioFrame        Frame;
     TMap<OdinEncoder*, OdinRoom*> LocalLinksCopy;
+    TSet<OdinEncoder*>            LocalWithoutRoomCopy;
     {
         FScopeLock Lock(&EncoderRoomLinkCS);
-        LocalLinksCopy = EncoderRoomLinks;
+        LocalLinksCopy       = EncoderRoomLinks;
+        LocalWithoutRoomCopy = EncodersWithoutRoom;
     }
 
     while (AudioPushQueue.Dequeue(Frame) && bIsRunning) {
-        if (Frame.EncoderHandle && LocalLinksCopy.Contains(Frame.EncoderHandle) && !Frame.Audio.IsEmpty()) {
+        for (const FOdinEncoderSwap& Retired : RetiredEncoders) {
+            if (Frame.EncoderHandle == Retired.OldEncoder) {
+                Frame.EncoderHandle = Retired.NewEncoder;
+                break;
+            }
+        }
+        const bool bIsLinked = LocalLinksCopy.Contains(Frame.EncoderHandle) || LocalWithoutRoomCopy.Contains(Frame.EncoderHandle);
+        if (Frame.EncoderHandle && bIsLinked && !Frame.Audio.IsEmpty()) {
             TRACE_CPUPROFILER_EVENT_SCOPE(FOdinAudioPushDataThread - odin_encoder_push);
             const OdinError Result = odin_encoder_push(Frame.EncoderHandle, Frame.Audio.GetData(), Frame.Audio.Num());
             ODIN_LOG(VeryVerbose, "%s calling odin_encoder_push.", ANSI_TO_TCHAR(__FUNCTION__));
             if (Result != ODIN_ERROR_SUCCESS) {
                 ODIN_LOG(Error, "Error on odin_encoder_push: %s", *UOdinFunctionLibrary::FormatOdinError(static_cast<EOdinError>(Result), false));
             }
+            RecordPushedBlock(Frame.BlockInfo);
+        }
+        if (Frame.ReturnPool.IsValid()) {
+            // a full pool simply frees the buffer
+            Frame.Audio.Reset();
+            Frame.ReturnPool->Enqueue(MoveTemp(Frame.Audio));
+            Frame.ReturnPool.Reset();
         }
     }
 }
 
+void FOdinAudioPushDataThread::RecordPushedBlock(const FOdinCaptureBlockInfo& BlockInfo)
+{
+    NumPushedBlocks.fetch_add(1, std::memory_order_relaxed);
+    if (BlockInfo.bGapFill) {
+        NumGapFillBlocks.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (BlockInfo.bOverflow) {
+        NumOverflowBlocks.fetch_add(1, std::memory_order_relaxed);
+        ODIN_LOG(Verbose, "Pushed capture block with device overflow at stream time %.3f s", BlockInfo.StreamTime);
+    }
+    if (BlockInfo.StreamTime > 0.0) {
+        LastStreamTime.store(BlockInfo.StreamTime, std::memory_order_relaxed);
+    }
+    if (BlockInfo.ReceiveTime > 0.0) {
+        const float QueueDelayMs = static_cast<float>((FPlatformTime::Seconds() - BlockInfo.ReceiveTime) * 1000.0);
+        MeanQueueDelayMs.store(MeanQueueDelayMs.load(std::memory_order_relaxed) * 0.95f + QueueDelayMs * 0.05f, std::memory_order_relaxed);
+        if (QueueDelayMs > MaxQueueDelayMs.load(std::memory_order_relaxed)) {
+            MaxQueueDelayMs.store(QueueDelayMs, std::memory_order_relaxed);
+        }
+    }
+}
+
+FOdinAudioPushDataThread::FOdinPushStats FOdinAudioPushDataThread::GetPushStats() const
+{
+    FOdinPushStats Stats;
+    Stats.NumPushedBlocks   = NumPushedBlocks.load(std::memory_order_relaxed);
+    Stats.NumOverflowBlocks = NumOverflowBlocks.load(std::memory_order_relaxed);
+    Stats.NumGapFillBlocks  = NumGapFillBlocks.load(std::memory_order_relaxed);
+    Stats.MeanQueueDelayMs  = MeanQueueDelayMs.load(std::memory_order_relaxed);
+    Stats.MaxQueueDelayMs   = MaxQueueDelayMs.load(std::memory_order_relaxed);
+    Stats.LastStreamTime    = LastStreamTime.load(std::memory_order_relaxed);
+    return Stats;
+}
+
 void FOdinAudioPushDataThread::PopAllEncoders(TArray<uint8>& DatagramBuffer)
 {
     TRACE_CPUPROFILER_EVENT_SCOPE(FOdinAudioPushDataThread::PopAllEncoders);
@@ -151,6 +294,7 @@ void FOdinAudioPushDataThread::PopAllEncoders(TArray<uint8>& DatagramBuffer)
             {
                 TRACE_CPUPROFILER_EVENT_SCOPE(odin_encoder_pop);
                 ODIN_LOG(VeryVerbose, "odin_encoder_pop for Encoder %p", EncoderHandle);
+                FOdinPopTimingScope PopTiming(EncoderHandle);
                 EncoderPopResult = odin_encoder_pop(EncoderHandle, DatagramBuffer.GetData(), &NumSamples);
             }
 
@@ -201,6 +345,7 @@ void FOdinAudioPushDataThread::Exit()
     {
         FScopeLock Lock(&EncoderRoomLinkCS);
         EncoderRoomLinks.Empty();
+        EncodersWithoutRoom.Empty();
     }
 
     if (PushEvent) {
@@ -211,6 +356,13 @@ void FOdinAudioPushDataThread::Exit()
         Thread->WaitForCompletion();
     }
 
+    // the push thread owns retired encoders, including swaps it did not get to anymore
+    FOdinEncoderSwap Swap;
+    while (EncoderSwapQueue.Dequeue(Swap)) {
+        RetiredEncoders.Add(Swap);
+    }
+    ReleaseRetiredEncoders(true);
+
     if (PushEvent) {
         FGenericPlatformProcess::ReturnSynchEventToPool(PushEvent);
         PushEvent = nullptr;
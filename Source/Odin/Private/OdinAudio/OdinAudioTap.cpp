@@ -0,0 +1,103 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#include "OdinAudio/OdinAudioTap.h"
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "OdinVoice.h"
+
+FOdinAudioTap::FOdinAudioTap(FOdinAudioTapConsumer InConsumer, const int32 InCapacityInSamples, const float InDrainIntervalMs)
+    : Consumer(MoveTemp(InConsumer))
+    , bIsRunning(false)
+    , DrainEvent(nullptr)
+    , DrainIntervalMs(InDrainIntervalMs)
+{
+    Ring.SetCapacity(FMath::Max(InCapacityInSamples, 1));
+    DrainBuffer.SetNumUninitialized(FMath::Max(InCapacityInSamples, 1));
+}
+
+FOdinAudioTap::~FOdinAudioTap()
+{ Exit(); }
+
+void FOdinAudioTap::Start()
+{
+    if (bIsRunning) {
+        return;
+    }
+    bIsRunning = true;
+    DrainEvent = FGenericPlatformProcess::GetSynchEventFromPool();
+    check(DrainEvent);
+    Thread.Reset(FRunnableThread::Create(this, TEXT("OdinAudioTapThread"), 0, TPri_BelowNormal));
+}
+
+bool FOdinAudioTap::Write(const float* Samples, const int32 NumSamples, const int32 InNumChannels, const int32 InSampleRate)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FOdinAudioTap::Write);
+    if (!Samples || NumSamples <= 0) {
+        return false;
+    }
+
+    NumChannels.store(InNumChannels, std::memory_order_relaxed);
+    SampleRate.store(InSampleRate, std::memory_order_relaxed);
+
+    // Drop whole blocks only, so the consumer never sees a block split in the middle of a frame.
+    if (Ring.Remainder() < static_cast<uint32>(NumSamples)) {
+        NumOverflowedSamples.fetch_add(NumSamples, std::memory_order_relaxed);
+        return false;
+    }
+    Ring.Push(Samples, NumSamples);
+    NumWrittenSamples.fetch_add(NumSamples, std::memory_order_relaxed);
+    return true;
+}
+
+void FOdinAudioTap::Drain()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FOdinAudioTap::Drain);
+    const int32 NumAvailable = Ring.Num();
+    if (NumAvailable <= 0) {
+        return;
+    }
+
+    const int32 NumPopped = Ring.Pop(DrainBuffer.GetData(), FMath::Min(NumAvailable, DrainBuffer.Num()));
+    if (NumPopped > 0 && Consumer) {
+        Consumer(TArrayView<const float>(DrainBuffer.GetData(), NumPopped), NumChannels.load(std::memory_order_relaxed),
+                 SampleRate.load(std::memory_order_relaxed));
+    }
+}
+
+uint32 FOdinAudioTap::Run()
+{
+    while (bIsRunning) {
+        check(DrainEvent);
+        DrainEvent->Wait(DrainIntervalMs);
+        Drain();
+    }
+    // Hand remaining samples to the consumer before the tap shuts down.
+    Drain();
+    return 0;
+}
+
+void FOdinAudioTap::Exit()
+{
+    if (!bIsRunning) {
+        return;
+    }
+
+    bIsRunning = false;
+
+    if (DrainEvent) {
+        DrainEvent->Trigger();
+    }
+    if (Thread.IsValid()) {
+        Thread->WaitForCompletion();
+    }
+
+    if (DrainEvent) {
+        FGenericPlatformProcess::ReturnSynchEventToPool(DrainEvent);
+        DrainEvent = nullptr;
+    }
+    if (const uint64 Overflowed = GetNumOverflowedSamples(); Overflowed > 0) {
+        ODIN_LOG(Verbose, "Odin Audio Tap dropped %llu of %llu samples due to overflow.", Overflowed, Overflowed + GetNumWrittenSamples());
+    }
+}
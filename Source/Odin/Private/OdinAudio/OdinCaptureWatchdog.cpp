@@ -0,0 +1,99 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#include "OdinAudio/OdinCaptureWatchdog.h"
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "OdinVoice.h"
+
+FOdinCaptureWatchdog::FOdinCaptureWatchdog(FOdinCaptureStallHandler InStallHandler, const float InCheckIntervalMs)
+    : StallHandler(MoveTemp(InStallHandler))
+    , bIsRunning(false)
+    , CheckEvent(nullptr)
+    , CheckIntervalMs(InCheckIntervalMs)
+{
+}
+
+FOdinCaptureWatchdog::~FOdinCaptureWatchdog()
+{ Exit(); }
+
+void FOdinCaptureWatchdog::Arm(const float InStallTimeoutSeconds, const float InSetupTimeoutSeconds)
+{
+    StallTimeoutSeconds = InStallTimeoutSeconds;
+    SetupTimeoutSeconds = InSetupTimeoutSeconds;
+    ArmedTime           = FPlatformTime::Seconds();
+    bIsArmed            = true;
+
+    FScopeLock Lock(&StartCS);
+    if (!bIsRunning) {
+        bIsRunning = true;
+        CheckEvent = FGenericPlatformProcess::GetSynchEventFromPool();
+        check(CheckEvent);
+        Thread.Reset(FRunnableThread::Create(this, TEXT("OdinCaptureWatchdogThread"), 0, TPri_BelowNormal));
+    }
+}
+
+void FOdinCaptureWatchdog::Disarm()
+{ bIsArmed = false; }
+
+void FOdinCaptureWatchdog::Check()
+{
+    if (!bIsArmed) {
+        return;
+    }
+
+    const double Now          = FPlatformTime::Seconds();
+    const double StreamArmed  = ArmedTime;
+    const double LastCallback = LastCallbackTime;
+
+    // A freshly opened stream gets additional time until the first callback, e.g. for Bluetooth headsets.
+    const bool   bHasCallback = LastCallback >= StreamArmed;
+    const double Reference    = bHasCallback ? LastCallback : StreamArmed;
+    const double Timeout      = bHasCallback ? StallTimeoutSeconds.load() : StallTimeoutSeconds.load() + SetupTimeoutSeconds.load();
+    if (Now - Reference <= Timeout) {
+        return;
+    }
+
+    if (bIsArmed.exchange(false) && StallHandler) {
+        ODIN_LOG(Verbose, "Odin Capture Watchdog detected a stalled capture stream, no callback for %.2f seconds.", Now - Reference);
+        StallHandler();
+    }
+}
+
+uint32 FOdinCaptureWatchdog::Run()
+{
+    while (bIsRunning) {
+        check(CheckEvent);
+        CheckEvent->Wait(CheckIntervalMs);
+
+        if (bIsRunning) {
+            TRACE_CPUPROFILER_EVENT_SCOPE(FOdinCaptureWatchdog::Run);
+            Check();
+        }
+    }
+    return 0;
+}
+
+void FOdinCaptureWatchdog::Exit()
+{
+    if (!bIsRunning) {
+        return;
+    }
+
+    bIsRunning = false;
+    bIsArmed   = false;
+
+    if (CheckEvent) {
+        CheckEvent->Trigger();
+    }
+    if (Thread.IsValid()) {
+        Thread->WaitForCompletion();
+    }
+
+    if (CheckEvent) {
+        FGenericPlatformProcess::ReturnSynchEventToPool(CheckEvent);
+        CheckEvent = nullptr;
+    }
+}
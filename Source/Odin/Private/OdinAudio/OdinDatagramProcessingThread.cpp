@@ -17,7 +17,8 @@ FOdinDatagramProcessingThread::FOdinDatagramProcessingThread()
 
 FOdinDatagramProcessingThread::~FOdinDatagramProcessingThread() = default;
 
-void FOdinDatagramProcessingThread::LinkDecoderToPeer(OdinDecoder* DecoderHandle, OdinRoom* TargetRoom, const uint32 PeerId)
+void FOdinDatagramProcessingThread::LinkDecoderToPeer(OdinDecoder* DecoderHandle, OdinRoom* TargetRoom, const uint32 PeerId,
+                                                      const FOdinDecoderStatePtr& DecoderState)
 {
     TRACE_CPUPROFILER_EVENT_SCOPE(FOdinDatagramProcessingThread::LinkDecoderToPeer);
 
@@ -32,6 +33,9 @@ void FOdinDatagramProcessingThread::LinkDecoderToPeer(OdinDecoder* DecoderHandle
         FScopeLock          RegisterDecoderLock(&DecoderHandlesCS);
         TSet<OdinDecoder*>& OdinDecoders = RegisteredDecoderHandles.FindOrAdd(TPair<OdinRoom*, uint32>(TargetRoom, PeerId));
         OdinDecoders.Add(DecoderHandle);
+        if (DecoderState.IsValid()) {
+            DecoderStates.Add(DecoderHandle, DecoderState);
+        }
         ODIN_LOG(Verbose, "Linking Odin Decoder %p to Room Handle %p and Peer Id %u", DecoderHandle, TargetRoom, PeerId);
 
     } else {
@@ -59,11 +63,61 @@ void FOdinDatagramProcessingThread::UnlinkDecoder(const OdinDecoder* DecoderHand
             }
         }
 
+        DecoderStates.Remove(DecoderHandle);
+
         ODIN_LOG(Verbose, "Deregistered %d Decoders", RemovedDecoders);
         ODIN_LOG(Verbose, "Number of registered decoder handles: %d", RegisteredDecoderHandles.Num());
     }
 }
 
+void FOdinDatagramProcessingThread::SwapDecoderHandle(const OdinDecoder* OldHandle, OdinDecoder* NewHandle)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FOdinDatagramProcessingThread::SwapDecoderHandle);
+
+    if (!OldHandle || !NewHandle) {
+        ODIN_LOG(Log, "Tried swapping invalid Decoder Handle, aborting.");
+        return;
+    }
+    FScopeLock SwapDecoderLock(&DecoderHandlesCS);
+    int32      SwappedLinks = 0;
+    for (auto& Pair : RegisteredDecoderHandles) {
+        if (Pair.Value.Remove(OldHandle) > 0) {
+            Pair.Value.Add(NewHandle);
+            ++SwappedLinks;
+        }
+    }
+    FOdinDecoderStatePtr DecoderState;
+    if (DecoderStates.RemoveAndCopyValue(OldHandle, DecoderState)) {
+        DecoderStates.Add(NewHandle, DecoderState);
+    }
+    ODIN_LOG(Verbose, "Swapped %d peer links of Decoder %p to Decoder %p", SwappedLinks, OldHandle, NewHandle);
+}
+
+void FOdinDatagramProcessingThread::RetireDecoderHandle(OdinDecoder* DecoderHandle)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FOdinDatagramProcessingThread::RetireDecoderHandle);
+
+    if (!DecoderHandle) {
+        return;
+    }
+    if (!bIsRunning) {
+        // nothing can have copied the handle without a running thread
+        odin_decoder_free(DecoderHandle);
+        ODIN_LOG(Verbose, "Freed retired Decoder %p", DecoderHandle);
+        return;
+    }
+    RetiredDecoders.Enqueue(DecoderHandle);
+}
+
+void FOdinDatagramProcessingThread::FreeRetiredDecoders()
+{
+    OdinDecoder* DecoderHandle;
+    while (RetiredDecoders.Dequeue(DecoderHandle)) {
+        odin_decoder_free(DecoderHandle);
+        ODIN_LOG(Verbose, "Freed retired Decoder %p", DecoderHandle);
+    }
+}
+
 TArray<OdinDecoder*> FOdinDatagramProcessingThread::GetDecoderHandlesFor(OdinRoom* TargetRoom, uint32 PeerId) const
 {
     TRACE_CPUPROFILER_EVENT_SCOPE(FOdinDatagramProcessingThread::GetDecoderHandlesFor);
@@ -76,6 +130,18 @@ TArray<OdinDecoder*> FOdinDatagramProcessingThread::GetDecoderHandlesFor(OdinRoo
     return Result;
 }
 
+void FOdinDatagramProcessingThread::GetDecoderTargetsFor(OdinRoom* TargetRoom, uint32 PeerId, TArray<FDecoderTarget>& OutTargets) const
+{
+    OutTargets.Reset();
+    FScopeLock GetDecoderTargetsLock(&DecoderHandlesCS);
+    if (const TSet<OdinDecoder*>* DecodersForPeer = RegisteredDecoderHandles.Find(FDecoderIdentifier(TargetRoom, PeerId))) {
+        for (OdinDecoder* Decoder : *DecodersForPeer) {
+            const FOdinDecoderStatePtr* DecoderState = DecoderStates.Find(Decoder);
+            OutTargets.Emplace(Decoder, DecoderState ? *DecoderState : nullptr);
+        }
+    }
+}
+
 void FOdinDatagramProcessingThread::HandleDatagram(OdinRoom* RoomHandle, uint32 PeerId, uint64 ChannelMask, uint32 SsrcId, TArray<uint8>&& Datagram)
 {
     TRACE_CPUPROFILER_EVENT_SCOPE(FOdinDatagramProcessingThread::HandleDatagram)
@@ -87,10 +153,15 @@ void FOdinDatagramProcessingThread::HandleDatagram(OdinRoom* RoomHandle, uint32
 
 uint32 FOdinDatagramProcessingThread::Run()
 {
+    TArray<FDecoderTarget> DecoderTargets;
     while (bIsRunning) {
         check(PushEvent);
         PushEvent->Wait(PushFrequencyInMs);
 
+        // Retired handles were swapped out before they were queued, so targets copied from now on cannot contain them. Handles
+        // retired during the pass below may still be in copied targets and are only freed on the next iteration.
+        FreeRetiredDecoders();
+
         {
             TRACE_CPUPROFILER_EVENT_SCOPE(FOdinDatagramProcessingThread - Queue Processing)
             FOdinDatagramEvent DatagramEvent;
@@ -98,13 +169,18 @@ uint32 FOdinDatagramProcessingThread::Run()
                 TRACE_CPUPROFILER_EVENT_SCOPE(FOdinDatagramProcessingThread - Single Datagram Processing)
                 if (const UOdinSubsystem* OdinSubsystem = UOdinSubsystem::Get()) {
                     if (OdinSubsystem->IsRoomRegistered(DatagramEvent.Handle)) {
-                        for (OdinDecoder* Decoder : OdinSubsystem->GetDecoderHandlesFor(DatagramEvent.Handle, DatagramEvent.PeerId)) {
+                        GetDecoderTargetsFor(DatagramEvent.Handle, DatagramEvent.PeerId, DecoderTargets);
+                        for (const FDecoderTarget& DecoderTarget : DecoderTargets) {
+                            OdinDecoder* Decoder = DecoderTarget.Key;
                             {
                                 TRACE_CPUPROFILER_EVENT_SCOPE(FOdinDatagramProcessingThread - decoder_push)
                                 const OdinError Result = odin_decoder_push(Decoder, DatagramEvent.Datagram.GetData(), DatagramEvent.Datagram.Num());
                                 if (Result != OdinError::ODIN_ERROR_SUCCESS) {
                                     ODIN_LOG(Error, "Aborting Push due to invalid odin_decoder_push call: %s",
                                              *UOdinFunctionLibrary::FormatOdinError(static_cast<EOdinError>(Result), false));
+                                } else if (DecoderTarget.Value.IsValid()) {
+                                    DecoderTarget.Value->RecordPush();
+                                    DecoderTarget.Value->RefreshPositions(Decoder);
                                 }
                             }
                         }
@@ -130,6 +206,7 @@ void FOdinDatagramProcessingThread::Exit()
     if (Thread.IsValid()) {
         Thread->WaitForCompletion();
     }
+    FreeRetiredDecoders();
 
     if (PushEvent) {
         FGenericPlatformProcess::ReturnSynchEventToPool(PushEvent);
@@ -11,6 +11,7 @@
 
 UOdinDecoder::UOdinDecoder(const class FObjectInitializer &PCIP)
     : Super(PCIP)
+    , State(MakeShared<FOdinDecoderState, ESPMode::ThreadSafe>(FString::Printf(TEXT("%s.%s"), *GetNameSafe(GetOuter()), *GetName())))
 { ODIN_LOG(Verbose, "%s", ANSI_TO_TCHAR(__FUNCTION__)); }
 
 void UOdinDecoder::SetHandle(OdinDecoder *NewHandle)
@@ -59,6 +60,25 @@ UOdinDecoder *UOdinDecoder::ConstructDecoder(UObject *WorldContextObject, const
     return DecoderUObject;
 }
 
+UOdinDecoder *UOdinDecoder::ConstructDecoderForAudioDevice(UObject *WorldContextObject, const bool bUseStereo)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinDecoder::ConstructDecoderForAudioDevice);
+
+    int32 DeviceSampleRate = 48000;
+    int32 DeviceChannels   = 2;
+    if (!UOdinSubsystem::GetAudioDeviceFormat(WorldContextObject, DeviceSampleRate, DeviceChannels)) {
+        ODIN_LOG(Warning, "Could not resolve the audio device format, falling back to Sample Rate %d.", DeviceSampleRate);
+    }
+    ODIN_LOG(Verbose, "Construct Decoder for Audio Device with Sample Rate %d and %d Device Channels was called.", DeviceSampleRate, DeviceChannels);
+
+    UOdinDecoder *DecoderUObject             = NewObject<UOdinDecoder>(WorldContextObject);
+    DecoderUObject->bFollowAudioDeviceFormat = true;
+    DecoderUObject->bPreferStereo            = bUseStereo;
+    DecoderUObject->SetupInternalDecoder(DeviceSampleRate, bUseStereo && DeviceChannels >= 2);
+
+    return DecoderUObject;
+}
+
 UOdinDecoder *UOdinDecoder::SetupInternalDecoder(const int32 DecoderSampleRate, const bool bUseStereo)
 {
     TRACE_CPUPROFILER_EVENT_SCOPE(UOdinDecoder::SetupInternalDecoder);
@@ -113,6 +133,74 @@ bool UOdinDecoder::FreeDecoderInternal(OdinDecoder *DecoderHandle)
     return true;
 }
 
+bool UOdinDecoder::ReconfigureFormat(const int32 NewSampleRate, const bool bNewStereo)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinDecoder::ReconfigureFormat);
+    check(IsInGameThread());
+
+    OdinDecoder *OldDecoderHandle = GetNativeHandle();
+    if (nullptr == OldDecoderHandle) {
+        return SetupInternalDecoder(NewSampleRate, bNewStereo) != nullptr;
+    }
+    if (NewSampleRate == SampleRate && bNewStereo == bStereo) {
+        return true;
+    }
+
+    OdinDecoder *NewDecoderHandle;
+    const auto   Result = odin_decoder_create(NewSampleRate, bNewStereo, &NewDecoderHandle);
+    if (Result != OdinError::ODIN_ERROR_SUCCESS) {
+        FOdinModule::LogErrorCode("Aborting ReconfigureFormat due to invalid odin_decoder_create call: %s", Result);
+        return false;
+    }
+    ODIN_LOG(Log, "Recreating Decoder %p with Sample Rate %d and %d Channels (was %d Hz, %d Channels).", OldDecoderHandle, NewSampleRate,
+             bNewStereo ? 2 : 1, SampleRate, bStereo ? 2 : 1);
+
+    // the new decoder gets its effects before any thread can push to it
+    const OdinPipeline  *NewPipeline = odin_decoder_get_pipeline(NewDecoderHandle);
+    TMap<uint32, uint32> EffectIdMap;
+    if (IsValid(Pipeline) && !Pipeline->CopyEffectsTo(NewPipeline, NewSampleRate, bNewStereo, EffectIdMap)) {
+        ODIN_LOG(Error, "Aborting ReconfigureFormat, the audio pipeline of Decoder %p could not be recreated.", OldDecoderHandle);
+        odin_decoder_free(NewDecoderHandle);
+        return false;
+    }
+
+    // Move all peer links and object registrations over without going through SetHandle, which would unlink the decoder.
+    UOdinSubsystem *OdinSubsystem = UOdinSubsystem::Get();
+    if (OdinSubsystem) {
+        OdinSubsystem->SwapDecoderHandle(OldDecoderHandle, NewDecoderHandle);
+    }
+    Handle->SetHandle(NewDecoderHandle);
+    SampleRate = NewSampleRate;
+    bStereo    = bNewStereo;
+
+    if (IsValid(Pipeline)) {
+        Pipeline->SwapHandle(NewPipeline, EffectIdMap);
+    }
+    if (AudioEventFilter != 0) {
+        SetAudioEventHandler(AudioEventFilter);
+    }
+
+    // Listeners drop their copies of the old handle, the datagram thread frees it once it stopped pushing to it.
+    OnFormatChangedNative.Broadcast(this);
+    if (OdinSubsystem) {
+        OdinSubsystem->RetireDecoderHandle(OldDecoderHandle);
+    } else {
+        odin_decoder_free(OldDecoderHandle);
+    }
+    return true;
+}
+
+bool UOdinDecoder::MatchAudioDeviceFormat(const UObject *WorldContextObject)
+{
+    int32 DeviceSampleRate;
+    int32 DeviceChannels;
+    if (!UOdinSubsystem::GetAudioDeviceFormat(WorldContextObject, DeviceSampleRate, DeviceChannels)) {
+        ODIN_LOG(Verbose, "Aborting MatchAudioDeviceFormat, no audio device available.");
+        return false;
+    }
+    return ReconfigureFormat(DeviceSampleRate, bPreferStereo && DeviceChannels >= 2);
+}
+
 UOdinPipeline *UOdinDecoder::GetOrCreateDecoderPipeline(UOdinDecoder *Decoder)
 {
     TRACE_CPUPROFILER_EVENT_SCOPE(UOdinDecoder::GetDecoderPipeline);
@@ -143,6 +231,7 @@ bool UOdinDecoder::GetIsSilent() const
 bool UOdinDecoder::SetAudioEventHandler(int EFilter)
 {
     TRACE_CPUPROFILER_EVENT_SCOPE(UOdinDecoder::SetAudioEventHandler);
+    AudioEventFilter                           = EFilter;
     const TWeakObjectPtr<UOdinDecoder> DataPtr = this;
     const auto Result = odin_decoder_set_event_callback(this->GetNativeHandle(), static_cast<enum OdinAudioEvents>(EFilter), this->OdinDecoderEventCallbackFunc,
                                                         DataPtr.IsValid() ? DataPtr.Get() : nullptr);
@@ -196,15 +285,75 @@ TArray<FOdinPosition> UOdinDecoder::GetPositions(FOdinChannelMask channelMask) c
         FOdinModule::LogErrorCode("Aborting GetPositions due to invalid odin_decoder_get_positions call: %s", Result);
     } else {
         ODIN_LOG(Verbose, "Received %d positions.", NumPositions);
+        Positions.SetNum(FMath::Min<int32>(NumPositions, Positions.Num()));
     }
 
     return Positions;
 }
 
+int32 UOdinDecoder::GetCachedPositions(TArrayView<FOdinPosition> OutPositions, uint32 &InOutVersion) const
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinDecoder::GetCachedPositions);
+
+    if (State->GetPositionsVersion() == InOutVersion) {
+        return INDEX_NONE;
+    }
+    FOdinDecoderState::FPositionsSnapshot Snapshot;
+    InOutVersion             = State->ReadPositions(Snapshot);
+    const int32 NumPositions = FMath::Min<int32>(Snapshot.NumPositions, OutPositions.Num());
+    static_assert(sizeof(FOdinPosition) == sizeof(OdinPosition), "FOdinPosition has to match the layout of OdinPosition");
+    FMemory::Memcpy(OutPositions.GetData(), Snapshot.Positions, sizeof(OdinPosition) * NumPositions);
+    return NumPositions;
+}
+
+bool UOdinDecoder::GetCachedPositionsChangedSince(const int64 SinceVersion, TArray<FOdinPosition> &Positions, int64 &Version) const
+{
+    uint32 CurrentVersion = static_cast<uint32>(SinceVersion);
+    Positions.SetNumUninitialized(FOdinDecoderState::MaxPositions);
+    const int32 NumPositions = GetCachedPositions(Positions, CurrentVersion);
+    Version                  = CurrentVersion;
+    if (NumPositions == INDEX_NONE) {
+        Positions.Reset();
+        return false;
+    }
+    Positions.SetNum(NumPositions);
+    return true;
+}
+
+int64 UOdinDecoder::GetCachedPositionsVersion() const
+{ return State->GetPositionsVersion(); }
+
+void UOdinDecoder::SetCachedPositionsChannelMask(const FOdinChannelMask InChannelMask)
+{ State->SetPositionsChannelMask(InChannelMask); }
+
+FOdinDecoderPlayoutStats UOdinDecoder::GetPlayoutStats() const
+{
+    const FOdinDecoderState::FPlayoutCounters Counters = State->GetPlayoutCounters();
+
+    FOdinDecoderPlayoutStats Stats;
+    Stats.Pops             = Counters.NumPops;
+    Stats.Underruns        = Counters.NumUnderruns;
+    Stats.ConcealedFrames  = Counters.NumConcealedFrames;
+    Stats.DeliveredSamples = Counters.NumDeliveredSamples;
+    Stats.SilentSamples    = Counters.NumSilentSamples;
+    Stats.ReceivedPackets  = Counters.NumReceivedPackets;
+    Stats.SilenceRatio     = Counters.NumDeliveredSamples > 0 ? static_cast<float>(Counters.NumSilentSamples) / Counters.NumDeliveredSamples : 0.0f;
+    Stats.BufferedMs       = Counters.BufferedMs;
+    return Stats;
+}
+
+void UOdinDecoder::ResetPlayoutStats()
+{ State->ResetPlayoutCounters(); }
+
 int32 UOdinDecoder::Pop(float *Samples, int32 Count, bool *bSilence) const
 {
     TRACE_CPUPROFILER_EVENT_SCOPE(UOdinDecoder::Pop);
-    auto ret = odin_decoder_pop(this->GetNativeHandle(), Samples, Count, bSilence);
+    OdinError ret;
+    {
+        FOdinPopTimingScope PopTiming(this->GetNativeHandle());
+        ret = odin_decoder_pop(this->GetNativeHandle(), Samples, Count, bSilence);
+    }
+    State->RecordPop(ret, bSilence && *bSilence, Count, SampleRate, bStereo ? 2 : 1);
     if (ret == OdinError::ODIN_ERROR_SUCCESS) {
         return Count;
     } else if (ret != OdinError::ODIN_ERROR_NO_DATA) {
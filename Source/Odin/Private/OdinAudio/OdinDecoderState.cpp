@@ -0,0 +1,112 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#include "OdinAudio/OdinDecoderState.h"
+
+namespace OdinDecoderState
+{
+    // Every voice packet carries one 20 ms frame.
+    constexpr uint64 PacketDurationUs = 20000;
+
+    TUniquePtr<FCountersTrace::FCounterInt> MakeCounter(const FString& Name, const TCHAR* Counter)
+    { return MakeUnique<FCountersTrace::FCounterInt>(*FString::Printf(TEXT("Odin/Decoder/%s/%s"), *Name, Counter), TraceCounterDisplayHint_None); }
+} // namespace OdinDecoderState
+
+FOdinDecoderState::FOdinDecoderState(const FString& InName)
+    : UnderrunsCounter(OdinDecoderState::MakeCounter(InName, TEXT("Underruns")))
+    , ConcealedFramesCounter(OdinDecoderState::MakeCounter(InName, TEXT("ConcealedFrames")))
+    , SilentSamplesCounter(OdinDecoderState::MakeCounter(InName, TEXT("SilentSamples")))
+    , ReceivedPacketsCounter(OdinDecoderState::MakeCounter(InName, TEXT("ReceivedPackets")))
+{
+}
+
+FOdinDecoderState::~FOdinDecoderState() = default;
+
+void FOdinDecoderState::RefreshPositions(OdinDecoder* Decoder)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FOdinDecoderState::RefreshPositions);
+
+    FPositionsSnapshot Snapshot;
+    Snapshot.NumPositions = MaxPositions;
+    const OdinError Result =
+        odin_decoder_get_positions(Decoder, PositionsChannelMask.load(std::memory_order_relaxed), Snapshot.Positions, &Snapshot.NumPositions);
+    if (Result != OdinError::ODIN_ERROR_SUCCESS) {
+        return;
+    }
+    Snapshot.NumPositions = FMath::Min(Snapshot.NumPositions, MaxPositions);
+
+    const FPositionsSnapshot& Current = Positions.GetWriterValue();
+    if (Current.NumPositions == Snapshot.NumPositions
+        && FMemory::Memcmp(Current.Positions, Snapshot.Positions, sizeof(OdinPosition) * Snapshot.NumPositions) == 0) {
+        return;
+    }
+    Positions.Write(Snapshot);
+}
+
+void FOdinDecoderState::RecordPush()
+{
+    NumReceivedPackets.fetch_add(1, std::memory_order_relaxed);
+    ReceivedAudioUs.fetch_add(OdinDecoderState::PacketDurationUs, std::memory_order_relaxed);
+    ReceivedPacketsCounter->Increment();
+}
+
+void FOdinDecoderState::RecordPop(const OdinError Result, const bool bIsSilent, const int32 NumSamples, const int32 SampleRate, const int32 NumChannels)
+{
+    NumPops.fetch_add(1, std::memory_order_relaxed);
+    NumDeliveredSamples.fetch_add(NumSamples, std::memory_order_relaxed);
+
+    // Rebase the cursor after a reset, keeping only the audio that is still buffered. The datagram thread keeps adding to
+    // the received audio, so it is reduced atomically by the played audio.
+    if (bRebaseCursor.exchange(false, std::memory_order_relaxed)) {
+        ReceivedAudioUs.fetch_sub(PlayedAudioUs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        PlayedAudioUs.store(0, std::memory_order_relaxed);
+    }
+
+    // Advance the playout cursor, it never overtakes the received audio. Reaching it means the decoder has to conceal.
+    const uint64 ReceivedUs   = ReceivedAudioUs.load(std::memory_order_relaxed);
+    const uint64 PlayedUs     = PlayedAudioUs.load(std::memory_order_relaxed);
+    const uint64 DurationUs   = SampleRate > 0 && NumChannels > 0 ? static_cast<uint64>(NumSamples) * 1000000 / (SampleRate * NumChannels) : 0;
+    const bool   bHasReceived = PlayedUs < ReceivedUs;
+    PlayedAudioUs.store(FMath::Min(PlayedUs + DurationUs, ReceivedUs), std::memory_order_relaxed);
+
+    if (Result == OdinError::ODIN_ERROR_NO_DATA) {
+        NumUnderruns.fetch_add(1, std::memory_order_relaxed);
+        NumSilentSamples.fetch_add(NumSamples, std::memory_order_relaxed);
+        UnderrunsCounter->Increment();
+        SilentSamplesCounter->Add(NumSamples);
+    } else if (Result == OdinError::ODIN_ERROR_SUCCESS) {
+        if (bIsSilent) {
+            NumSilentSamples.fetch_add(NumSamples, std::memory_order_relaxed);
+            SilentSamplesCounter->Add(NumSamples);
+        } else if (!bHasReceived) {
+            NumConcealedFrames.fetch_add(1, std::memory_order_relaxed);
+            ConcealedFramesCounter->Increment();
+        }
+    }
+}
+
+FOdinDecoderState::FPlayoutCounters FOdinDecoderState::GetPlayoutCounters() const
+{
+    FPlayoutCounters Counters;
+    Counters.NumPops             = NumPops.load(std::memory_order_relaxed);
+    Counters.NumUnderruns        = NumUnderruns.load(std::memory_order_relaxed);
+    Counters.NumConcealedFrames  = NumConcealedFrames.load(std::memory_order_relaxed);
+    Counters.NumDeliveredSamples = NumDeliveredSamples.load(std::memory_order_relaxed);
+    Counters.NumSilentSamples    = NumSilentSamples.load(std::memory_order_relaxed);
+    Counters.NumReceivedPackets  = NumReceivedPackets.load(std::memory_order_relaxed);
+
+    const uint64 ReceivedUs = ReceivedAudioUs.load(std::memory_order_relaxed);
+    const uint64 PlayedUs   = PlayedAudioUs.load(std::memory_order_relaxed);
+    Counters.BufferedMs     = ReceivedUs > PlayedUs ? (ReceivedUs - PlayedUs) / 1000.0f : 0.0f;
+    return Counters;
+}
+
+void FOdinDecoderState::ResetPlayoutCounters()
+{
+    NumPops.store(0, std::memory_order_relaxed);
+    NumUnderruns.store(0, std::memory_order_relaxed);
+    NumConcealedFrames.store(0, std::memory_order_relaxed);
+    NumDeliveredSamples.store(0, std::memory_order_relaxed);
+    NumSilentSamples.store(0, std::memory_order_relaxed);
+    NumReceivedPackets.store(0, std::memory_order_relaxed);
+    bRebaseCursor.store(true, std::memory_order_relaxed);
+}
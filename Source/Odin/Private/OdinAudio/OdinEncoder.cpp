@@ -3,12 +3,17 @@
 #include "OdinAudio/OdinEncoder.h"
 
 #include "AudioDevice.h"
+#include "Async/Async.h"
 #include "OdinFunctionLibrary.h"
+#include "OdinRoom.h"
 #include "OdinSubsystem.h"
 #include "OdinVoice.h"
-#include "SampleBuffer.h"
+#include "OdinAudio/OdinAudioCapture.h"
+#include "OdinAudio/OdinAudioPushDataThread.h"
 #include "OdinAudio/OdinPipeline.h"
+#include "OdinAudio/OdinRemixer.h"
 #include "Runtime/Launch/Resources/Version.h"
+#include "Sound/SoundSubmix.h"
 
 UOdinEncoder::UOdinEncoder(const class FObjectInitializer& PCIP)
     : Super(PCIP)
@@ -19,9 +24,9 @@ UOdinEncoder::UOdinEncoder(const class FObjectInitializer& PCIP)
 void UOdinEncoder::BeginDestroy()
 {
     ODIN_LOG(Verbose, "ODIN Destroy: %s", ANSI_TO_TCHAR(__FUNCTION__));
-    if (IsValid(AudioGenerator)) {
-        AudioGenerator->RemoveGeneratorDelegate(Audio_Generator_Handle);
-    }
+    StopAdaptiveEncoding();
+    ReleaseInputMixer();
+    DetachAudioGenerator();
     this->AudioGenerator = nullptr;
     FreeEncoder(this);
     if (Pipeline) {
@@ -68,9 +73,13 @@ UOdinEncoder* UOdinEncoder::CreateEncoder(int64 InPeerId, int32 InSampleRate, bo
         FreeEncoderHandle(encoder);
     }
 
-    this->PeerId     = InPeerId;
-    this->SampleRate = InSampleRate;
-    this->bStereo    = bUseStereo;
+    this->PeerId                   = InPeerId;
+    this->SampleRate               = InSampleRate;
+    this->bStereo                  = bUseStereo;
+    this->bApplicationVoip         = !bUseStereo;
+    this->BitrateKbps              = bUseStereo ? 128 : 32;
+    this->PacketLossPerc           = 15;
+    this->UpdatePositionIntervalMs = 0;
 
     ODIN_LOG(Verbose, "odin_encoder_create for peer %lld with sample rate: %d, channels: %d", InPeerId, InSampleRate, (bUseStereo ? 2 : 1));
 
@@ -95,9 +104,13 @@ UOdinEncoder* UOdinEncoder::CreateEncoderEx(int64 InConnectedPeerId, int32 InSam
     if (encoder != nullptr)
         FreeEncoderHandle(encoder);
 
-    this->PeerId     = InConnectedPeerId;
-    this->SampleRate = InSampleRate;
-    this->bStereo    = bUseStereo;
+    this->PeerId                   = InConnectedPeerId;
+    this->SampleRate               = InSampleRate;
+    this->bStereo                  = bUseStereo;
+    this->bApplicationVoip         = bApplication_VOIP;
+    this->BitrateKbps              = Bitrate_Kbps;
+    this->PacketLossPerc           = Packet_Loss_Perc;
+    this->UpdatePositionIntervalMs = Update_Position_Interval_MS;
 
     ODIN_LOG(Verbose, "odin_encoder_create_ex for peer %lld with sample rate: %d, channels: %d voip: %d bitrate: %d kbps interval: %d ms", InConnectedPeerId,
              InSampleRate, (bUseStereo ? 2 : 1), bApplication_VOIP, Bitrate_Kbps, Update_Position_Interval_MS);
@@ -197,6 +210,7 @@ bool UOdinEncoder::SetAudioEventHandler(int EFilter)
         FOdinModule::LogErrorCode("Aborting SetAudioEventHandler due to invalid odin_encoder_set_event_callback call: %s", Result);
         return false;
     }
+    AudioEventFilter = EFilter;
     return true;
 }
 
@@ -235,9 +249,7 @@ void UOdinEncoder::SetAudioGenerator(UAudioGenerator* Generator)
         ODIN_LOG(Error, "UOdinEncoder::SetAudioCapture - audio capture is null, microphone will "
                         "not work.");
     }
-    if (IsValid(AudioGenerator)) {
-        AudioGenerator->RemoveGeneratorDelegate(Audio_Generator_Handle);
-    }
+    DetachAudioGenerator();
 
     this->AudioGenerator    = Generator;
     int32 CaptureSampleRate = AudioGenerator->GetSampleRate();
@@ -245,40 +257,311 @@ void UOdinEncoder::SetAudioGenerator(UAudioGenerator* Generator)
     int32 OdinSampleRate    = SampleRate;
     int32 OdinChannels      = bStereo + 1;
 
+    // Odin capture objects deliver directly to a native sink, which skips the generator delegate list and any weak pointer
+    // resolution on the capture thread.
+    if (UOdinAudioCapture* AudioCapture = Cast<UOdinAudioCapture>(Generator)) {
+        if (const UOdinSubsystem* Subsystem = UOdinSubsystem::Get()) {
+            CaptureSink = MakeShared<FOdinEncoderCaptureSink, ESPMode::ThreadSafe>(Subsystem->GetPushDataThread(), OdinChannels);
+            CaptureSink->SetEncoderHandle(GetHandle());
+            CaptureSink->SetPreRollMs(PushToTalkPreRollMs);
+            CaptureSink->SetGateOpen(bPushToTalkActive);
+            CaptureSink->SetGateEnabled(bPushToTalkEnabled);
+            AudioCapture->AddCaptureSink(CaptureSink);
+            ODIN_LOG(Verbose, "Encoder %p attached to Odin Audio Capture %s as native capture sink.", GetHandle(), *AudioCapture->GetName());
+            return;
+        }
+    }
+
     TWeakObjectPtr<UOdinHandle>    WeakOdinHandle = Handle;
     TWeakObjectPtr<UOdinSubsystem> SubsystemPtr   = UOdinSubsystem::Get();
     // Create generator delegate TFunction<void(const float *InAudio, int32 NumSamples)>
-    TFunction<void(const float* InAudio, int32 NumSamples)> audioGeneratorHandle = [CaptureSampleRate, CaptureChannels, OdinSampleRate, OdinChannels,
-                                                                                    WeakOdinHandle, SubsystemPtr](const float* InAudio, int32 NumSamples) {
-        TRACE_CPUPROFILER_EVENT_SCOPE(UOdinEncoder - Audio Generator Callback);
-
-        const float* pbuffer   = InAudio;
-        int32        bufferNum = NumSamples;
-
-        ODIN_LOG(VeryVerbose, "Encoder, stream: %d hz %d ch, capture: %d hz %d ch. ue-downmix: %d, odin-resample: %d", OdinSampleRate, OdinChannels,
-                 CaptureSampleRate, CaptureChannels, (OdinChannels != CaptureChannels), (OdinSampleRate != CaptureSampleRate));
-
-        // downmix channels
-        if (OdinChannels != CaptureChannels) {
-            Audio::TSampleBuffer<float> buffer(InAudio, NumSamples, CaptureChannels, CaptureSampleRate);
-            buffer.MixBufferToChannels(OdinChannels);
-            pbuffer   = buffer.GetData();
-            bufferNum = buffer.GetNumSamples();
+    // The remix kernel is selected once here, the remixer keeps its scratch buffer and the pushed buffers are pooled across callbacks.
+    TFunction<void(const float* InAudio, int32 NumSamples)> audioGeneratorHandle =
+        [CaptureSampleRate, CaptureChannels, OdinSampleRate, OdinChannels, WeakOdinHandle, SubsystemPtr,
+         Remixer        = FOdinRemixer(CaptureChannels, OdinChannels),
+         PushBufferPool = MakeShared<FOdinAudioBufferPool, ESPMode::ThreadSafe>(8)](const float* InAudio, int32 NumSamples) mutable {
+            TRACE_CPUPROFILER_EVENT_SCOPE(UOdinEncoder - Audio Generator Callback);
+
+            ODIN_LOG(VeryVerbose, "Encoder, stream: %d hz %d ch, capture: %d hz %d ch. remix: %d, odin-resample: %d", OdinSampleRate, OdinChannels,
+                     CaptureSampleRate, CaptureChannels, (OdinChannels != CaptureChannels), (OdinSampleRate != CaptureSampleRate));
+
+            // downmix channels
+            const TArrayView<const float> Remixed = Remixer.Process(InAudio, NumSamples);
+
+            OdinEncoder* EncoderHandle = nullptr;
+            if (const UOdinHandle* OdinHandle = WeakOdinHandle.Get()) {
+                EncoderHandle = static_cast<OdinEncoder*>(OdinHandle->GetHandle());
+            }
+            if (EncoderHandle) {
+                if (SubsystemPtr.IsValid()) {
+                    TArray<float> PushBuffer;
+                    PushBufferPool->Dequeue(PushBuffer);
+                    PushBuffer.SetNumUninitialized(Remixed.Num());
+                    FMemory::Memcpy(PushBuffer.GetData(), Remixed.GetData(), Remixed.Num() * sizeof(float));
+                    SubsystemPtr->PushAudioToEncoder(EncoderHandle, MoveTemp(PushBuffer), PushBufferPool);
+                }
+            }
+        };
+    this->Audio_Generator_Handle = AudioGenerator->AddGeneratorDelegate(audioGeneratorHandle);
+}
+
+void UOdinEncoder::SetPushToTalkEnabled(bool bEnabled)
+{
+    bPushToTalkEnabled = bEnabled;
+    if (CaptureSink.IsValid()) {
+        CaptureSink->SetGateEnabled(bEnabled);
+    } else if (bEnabled && IsValid(AudioGenerator)) {
+        ODIN_LOG(Warning, "Push-to-talk is only applied to encoders fed by an Odin Audio Capture, generator %s is not gated.", *AudioGenerator->GetName());
+    }
+}
+
+void UOdinEncoder::SetPushToTalkActive(bool bActive)
+{
+    bPushToTalkActive = bActive;
+    if (CaptureSink.IsValid()) {
+        CaptureSink->SetGateOpen(bActive);
+    }
+}
+
+void UOdinEncoder::SetPushToTalkPreRollMs(int32 PreRollMs)
+{
+    PushToTalkPreRollMs = FMath::Clamp(PreRollMs, 0, 1000);
+    if (CaptureSink.IsValid()) {
+        CaptureSink->SetPreRollMs(PushToTalkPreRollMs);
+        if (UOdinAudioCapture* AudioCapture = Cast<UOdinAudioCapture>(AudioGenerator)) {
+            AudioCapture->PrepareCaptureSink(CaptureSink);
         }
+    }
+}
 
-        OdinEncoder* EncoderHandle = nullptr;
-        if (const UOdinHandle* OdinHandle = WeakOdinHandle.Get()) {
-            EncoderHandle = static_cast<OdinEncoder*>(OdinHandle->GetHandle());
+void UOdinEncoder::DetachAudioGenerator()
+{
+    if (CaptureSink.IsValid()) {
+        CaptureSink->SetEncoderHandle(nullptr);
+        if (UOdinAudioCapture* AudioCapture = Cast<UOdinAudioCapture>(AudioGenerator)) {
+            AudioCapture->RemoveCaptureSink(CaptureSink);
         }
-        if (EncoderHandle) {
-            if (SubsystemPtr.IsValid()) {
-                SubsystemPtr->PushAudioToEncoder(EncoderHandle, TArray<float>(pbuffer, bufferNum));
-            }
+        CaptureSink.Reset();
+    }
+    if (IsValid(AudioGenerator)) {
+        AudioGenerator->RemoveGeneratorDelegate(Audio_Generator_Handle);
+    }
+}
+
+bool UOdinEncoder::StartAdaptiveEncoding(UOdinRoom* Room, const TArray<FOdinEncoderProfile>& Profiles, float SampleIntervalMs)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinEncoder::StartAdaptiveEncoding);
+
+    StopAdaptiveEncoding();
+    if (!IsValid(Room) || !Room->GetHandle()) {
+        ODIN_LOG(Error, "Aborting StartAdaptiveEncoding due to invalid UOdinRoom pin.");
+        return false;
+    }
+    if (Profiles.IsEmpty()) {
+        ODIN_LOG(Error, "Aborting StartAdaptiveEncoding, no encoder profiles provided.");
+        return false;
+    }
+
+    const FOdinEncoderProfile& Initial = Profiles[0];
+    if (Initial.bApplicationVoip != bApplicationVoip || Initial.BitrateKbps != BitrateKbps || Initial.PacketLossPerc != PacketLossPerc) {
+        if (!ApplyEncoderProfile(Initial)) {
+            return false;
         }
+    }
+
+    // the adaptation thread only decides, the handover itself runs on the game thread
+    TWeakObjectPtr<UOdinEncoder> WeakThis = this;
+    auto OnProfileChange = [WeakThis, Profiles](int32 ProfileIndex) {
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Profile = Profiles[ProfileIndex]]() {
+            UOdinEncoder* Encoder = WeakThis.Get();
+            if (Encoder && Encoder->Adaptation.IsValid()) {
+                Encoder->ApplyEncoderProfile(Profile);
+            }
+        });
     };
-    this->Audio_Generator_Handle = AudioGenerator->AddGeneratorDelegate(audioGeneratorHandle);
+    Adaptation = MakeUnique<FOdinEncoderAdaptation>(Room->GetHandle(), Profiles, MoveTemp(OnProfileChange), SampleIntervalMs);
+    Adaptation->Start(0);
+    return true;
+}
+
+void UOdinEncoder::StopAdaptiveEncoding()
+{
+    if (Adaptation.IsValid()) {
+        Adaptation->Exit();
+        Adaptation.Reset();
+    }
+}
+
+int32 UOdinEncoder::GetActiveEncoderProfileIndex() const
+{ return Adaptation.IsValid() ? Adaptation->GetProfileIndex() : -1; }
+
+FOdinConnectionStats UOdinEncoder::GetAdaptiveConnectionStats() const
+{ return Adaptation.IsValid() ? FOdinConnectionStats(Adaptation->GetLastStats()) : FOdinConnectionStats(); }
+
+float UOdinEncoder::GetAdaptiveLossPerc() const
+{ return Adaptation.IsValid() ? Adaptation->GetLossPerc() : 0.0f; }
+
+bool UOdinEncoder::ApplyEncoderProfile(const FOdinEncoderProfile& Profile)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinEncoder::ApplyEncoderProfile);
+
+    OdinEncoder* OldHandle = GetHandle();
+    if (!OldHandle) {
+        ODIN_LOG(Error, "Aborting ApplyEncoderProfile due to invalid encoder handle.");
+        return false;
+    }
+
+    OdinEncoder*    NewHandle;
+    const OdinError Result = odin_encoder_create_ex(PeerId, SampleRate, bStereo, Profile.bApplicationVoip, Profile.BitrateKbps, Profile.PacketLossPerc,
+                                                    UpdatePositionIntervalMs, &NewHandle);
+    if (Result != OdinError::ODIN_ERROR_SUCCESS) {
+        FOdinModule::LogErrorCode("Aborting ApplyEncoderProfile due to invalid odin_encoder_create_ex call: %s", Result);
+        return false;
+    }
+
+    // the new encoder is fully configured before any producer can see it
+    UOdinPipeline*       CurrentPipeline = GetOrCreatePipeline();
+    const OdinPipeline*  NewPipeline     = odin_encoder_get_pipeline(NewHandle);
+    TMap<uint32, uint32> EffectIdMap;
+    if (!CurrentPipeline || !CurrentPipeline->CopyEffectsTo(NewPipeline, SampleRate, bStereo, EffectIdMap)) {
+        ODIN_LOG(Error, "Aborting ApplyEncoderProfile, the audio pipeline could not be recreated.");
+        odin_encoder_free(NewHandle);
+        return false;
+    }
+    if (AudioEventFilter != 0) {
+        odin_encoder_set_event_callback(NewHandle, static_cast<enum OdinAudioEvents>(AudioEventFilter), this->OdinEncoderEventCallbackFunc, this);
+    }
+    for (const TPair<uint64, FOdinPosition>& Entry : Positions) {
+        const OdinPosition NativePosition = Entry.Value;
+        odin_encoder_set_position(NewHandle, Entry.Key, &NativePosition);
+    }
+
+    // Keep the existing handle object, the generator delegate holds a weak reference to it.
+    Handle->SetHandle(NewHandle);
+    if (CaptureSink.IsValid()) {
+        CaptureSink->SetEncoderHandle(NewHandle);
+    }
+    if (InputMixer.IsValid()) {
+        InputMixer->SetEncoderHandle(NewHandle);
+    }
+    CurrentPipeline->SwapHandle(NewPipeline, EffectIdMap);
+    if (SubmixListener.IsValid()) {
+        SubmixListener->RemapEffectIds(EffectIdMap);
+    }
+
+    // The push thread moves the room link on its next frame boundary and retires the old encoder afterwards. Without a
+    // swap the old encoder is still retired there, so frames already queued for it never reach a freed handle.
+    UOdinSubsystem* Subsystem = UOdinSubsystem::Get();
+    if (!Subsystem) {
+        FreeEncoderHandle(OldHandle);
+    } else if (!Subsystem->SwapEncoderHandle(OldHandle, NewHandle)) {
+        Subsystem->RetireEncoderHandle(OldHandle);
+    }
+
+    bApplicationVoip = Profile.bApplicationVoip;
+    BitrateKbps      = Profile.BitrateKbps;
+    PacketLossPerc   = Profile.PacketLossPerc;
+    ODIN_LOG(Log, "Encoder %p replaced by %p with bitrate: %d kbps, packet loss: %d%%, voip: %d", OldHandle, NewHandle, BitrateKbps, PacketLossPerc,
+             bApplicationVoip);
+    return true;
+}
+
+FOdinEncoderInputMixer* UOdinEncoder::GetOrCreateInputMixer()
+{
+    if (!InputMixer.IsValid()) {
+        const UOdinSubsystem* Subsystem = UOdinSubsystem::Get();
+        if (!Subsystem) {
+            return nullptr;
+        }
+        InputMixer = MakeUnique<FOdinEncoderInputMixer>(Subsystem->GetPushDataThread(), SampleRate, bStereo ? 2 : 1);
+        InputMixer->SetEncoderHandle(GetHandle());
+    }
+    return InputMixer.Get();
+}
+
+void UOdinEncoder::ReleaseInputMixer()
+{
+    for (const TPair<int32, TWeakObjectPtr<UOdinAudioCapture>>& Entry : MixerCaptures) {
+        if (InputMixer.IsValid() && Entry.Value.IsValid()) {
+            Entry.Value->RemoveCaptureSink(InputMixer->FindSource(Entry.Key));
+        }
+    }
+    MixerCaptures.Empty();
+    for (const TPair<int32, TSharedPtr<FOdinMixerSubmixTap>>& Entry : MixerSubmixTaps) {
+        Entry.Value->Detach();
+    }
+    MixerSubmixTaps.Empty();
+    InputMixer.Reset();
+}
+
+int32 UOdinEncoder::AddMixerCaptureSource(UOdinAudioCapture* AudioCapture, float Gain)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinEncoder::AddMixerCaptureSource);
+
+    if (!IsValid(AudioCapture)) {
+        ODIN_LOG(Error, "Aborting AddMixerCaptureSource due to invalid UOdinAudioCapture pin.");
+        return 0;
+    }
+    FOdinEncoderInputMixer* Mixer = GetOrCreateInputMixer();
+    if (!Mixer) {
+        return 0;
+    }
+
+    const FOdinMixerSourcePtr Source = Mixer->AddSource(AudioCapture->GetFName(), Gain);
+    AudioCapture->AddCaptureSink(Source);
+    MixerCaptures.Add(Source->GetSourceId(), AudioCapture);
+    return Source->GetSourceId();
+}
+
+int32 UOdinEncoder::AddMixerSubmixSource(USoundSubmix* Submix, float Gain)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinEncoder::AddMixerSubmixSource);
+
+    FOdinEncoderInputMixer* Mixer = GetOrCreateInputMixer();
+    if (!Mixer) {
+        return 0;
+    }
+
+    const FOdinMixerSourcePtr             Source = Mixer->AddSource(Submix ? Submix->GetFName() : FName(TEXT("MainSubmix")), Gain);
+    const TSharedPtr<FOdinMixerSubmixTap> Tap    = MakeShared<FOdinMixerSubmixTap>(Source);
+    if (!Tap->Attach(Submix)) {
+        Mixer->RemoveSource(Source->GetSourceId());
+        return 0;
+    }
+    MixerSubmixTaps.Add(Source->GetSourceId(), Tap);
+    return Source->GetSourceId();
+}
+
+bool UOdinEncoder::SetMixerSourceGain(int32 SourceId, float Gain)
+{
+    const FOdinMixerSourcePtr Source = InputMixer.IsValid() ? InputMixer->FindSource(SourceId) : nullptr;
+    if (!Source.IsValid()) {
+        return false;
+    }
+    Source->SetGain(Gain);
+    return true;
+}
+
+bool UOdinEncoder::RemoveMixerSource(int32 SourceId)
+{
+    if (!InputMixer.IsValid()) {
+        return false;
+    }
+
+    TWeakObjectPtr<UOdinAudioCapture> AudioCapture;
+    if (MixerCaptures.RemoveAndCopyValue(SourceId, AudioCapture) && AudioCapture.IsValid()) {
+        AudioCapture->RemoveCaptureSink(InputMixer->FindSource(SourceId));
+    }
+    TSharedPtr<FOdinMixerSubmixTap> Tap;
+    if (MixerSubmixTaps.RemoveAndCopyValue(SourceId, Tap)) {
+        Tap->Detach();
+    }
+    return InputMixer->RemoveSource(SourceId);
 }
 
+FOdinInputMixerStats UOdinEncoder::GetInputMixerStats() const
+{ return InputMixer.IsValid() ? InputMixer->GetStats() : FOdinInputMixerStats(); }
+
 bool UOdinEncoder::SetPosition(FOdinChannelMask ChannelMask, FOdinPosition Position)
 {
     TRACE_CPUPROFILER_EVENT_SCOPE(UOdinEncoder::SetPosition);
@@ -287,6 +570,7 @@ bool UOdinEncoder::SetPosition(FOdinChannelMask ChannelMask, FOdinPosition Posit
     auto         ret = odin_encoder_set_position(this->GetHandle(), ChannelMask.GetChannelMask(), &pos);
     ODIN_LOG(Verbose, TEXT("Set Position Called with ChannelMask %llu and position %s"), ChannelMask.GetChannelMask(), *Position.ToString());
     if (ret == OdinError::ODIN_ERROR_SUCCESS) {
+        Positions.Add(ChannelMask.GetChannelMask(), Position);
         return true;
     } else {
         FOdinModule::LogErrorCode("Aborting SetPositions due to invalid odin_encoder_set_position call: %s", ret);
@@ -302,6 +586,12 @@ bool UOdinEncoder::ClearPosition(FOdinChannelMask ChannelMask)
     auto ret = odin_encoder_clear_position(this->GetHandle(), ChannelMask.GetChannelMask());
     ODIN_LOG(Verbose, "Clear Position called with Channelmask %llu", ChannelMask.GetChannelMask());
     if (ret == OdinError::ODIN_ERROR_SUCCESS) {
+        const uint64 ClearedMask = ChannelMask.GetChannelMask();
+        for (auto It = Positions.CreateIterator(); It; ++It) {
+            if ((It.Key() & ~ClearedMask) == 0) {
+                It.RemoveCurrent();
+            }
+        }
         return true;
     } else {
         FOdinModule::LogErrorCode("Aborting ClearPosition due to invalid odin_encoder_clear_position call: %s", ret);
@@ -314,8 +604,12 @@ int32 UOdinEncoder::Pop(TArray<uint8>& Datagram)
 {
     TRACE_CPUPROFILER_EVENT_SCOPE(UOdinEncoder::Pop);
 
-    uint32_t size = Datagram.Num();
-    auto     ret  = odin_encoder_pop(this->GetHandle(), Datagram.GetData(), &size);
+    uint32_t  size = Datagram.Num();
+    OdinError ret;
+    {
+        FOdinPopTimingScope PopTiming(this->GetHandle());
+        ret = odin_encoder_pop(this->GetHandle(), Datagram.GetData(), &size);
+    }
     if (ret == OdinError::ODIN_ERROR_SUCCESS || ret == OdinError::ODIN_ERROR_NO_DATA) {
         return size;
     } else {
@@ -341,6 +635,13 @@ int32 UOdinEncoder::Push(float* Samples, int32 Count)
 
 void UOdinEncoder::SetHandle(OdinEncoder* handle)
 {
+    if (CaptureSink.IsValid()) {
+        CaptureSink->SetEncoderHandle(handle);
+    }
+    if (InputMixer.IsValid()) {
+        InputMixer->SetEncoderHandle(handle);
+    }
+
     if (nullptr == handle) {
         if (IsValid(Handle)) {
             Handle->SetHandle(nullptr);
@@ -379,6 +680,116 @@ void UOdinEncoder::OnPipelineApmConfigChanged(UOdinPipeline* AffectedPipeline, i
     }
 }
 
+FOdinEncoderCaptureSink::FOdinEncoderCaptureSink(TSharedPtr<FOdinAudioPushDataThread, ESPMode::ThreadSafe> InPushDataThread, int32 InNumEncoderChannels)
+    : PushDataThread(MoveTemp(InPushDataThread))
+    , NumEncoderChannels(InNumEncoderChannels)
+    , PushBufferPool(MakeShared<FOdinAudioBufferPool, ESPMode::ThreadSafe>(8))
+{
+}
+
+void FOdinEncoderCaptureSink::SetEncoderHandle(OdinEncoder* NewHandle)
+{ EncoderHandle.store(NewHandle, std::memory_order_release); }
+
+void FOdinEncoderCaptureSink::SetGateEnabled(bool bEnabled)
+{ bGateEnabled.store(bEnabled, std::memory_order_relaxed); }
+
+void FOdinEncoderCaptureSink::SetGateOpen(bool bOpen)
+{ bGateOpen.store(bOpen, std::memory_order_relaxed); }
+
+void FOdinEncoderCaptureSink::SetPreRollMs(int32 NewPreRollMs)
+{ PreRollMs.store(FMath::Max(NewPreRollMs, 0), std::memory_order_relaxed); }
+
+void FOdinEncoderCaptureSink::PrepareCapture(int32 NumChannels, int32 SampleRate)
+{
+    if (NumChannels <= 0 || SampleRate <= 0) {
+        return;
+    }
+    if (NumChannels != NumCaptureChannels) {
+        NumCaptureChannels = NumChannels;
+        Remixer.Init(NumCaptureChannels, NumEncoderChannels);
+    }
+
+    const int32 Capacity = PreRollMs.load(std::memory_order_relaxed) * SampleRate / 1000 * NumChannels;
+    PreRoll.SetCapacity(FMath::Max(Capacity, 1));
+    PreRollCapacity = Capacity;
+}
+
+void FOdinEncoderCaptureSink::OnCapturedAudio(const float* AudioData, int32 NumFrames, int32 NumChannels, int32 SampleRate,
+                                              const FOdinCaptureBlockInfo& BlockInfo)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FOdinEncoderCaptureSink::OnCapturedAudio);
+
+    OdinEncoder* Encoder = EncoderHandle.load(std::memory_order_acquire);
+    if (!Encoder || !PushDataThread.IsValid() || NumChannels <= 0) {
+        return;
+    }
+
+    // the device may deliver a different channel layout than announced to PrepareCapture
+    if (NumChannels != NumCaptureChannels) {
+        NumCaptureChannels = NumChannels;
+        Remixer.Init(NumCaptureChannels, NumEncoderChannels);
+        PreRoll.Pop(PreRoll.Num());
+    }
+
+    const int32 NumSamples = NumFrames * NumChannels;
+    const bool  bIsOpen    = !bGateEnabled.load(std::memory_order_relaxed) || bGateOpen.load(std::memory_order_relaxed);
+    if (!bIsOpen) {
+        WritePreRoll(AudioData, NumSamples, NumChannels, SampleRate);
+        bWasGateOpen = false;
+        return;
+    }
+
+    if (!bWasGateOpen) {
+        bWasGateOpen = true;
+        FlushPreRoll(Encoder, BlockInfo);
+    }
+    PushToEncoder(Encoder, AudioData, NumSamples, BlockInfo);
+}
+
+void FOdinEncoderCaptureSink::WritePreRoll(const float* AudioData, int32 NumSamples, int32 NumChannels, int32 SampleRate)
+{
+    // the ring is allocated by PrepareCapture, a longer pre-roll or a larger format is limited to its capacity
+    const int32 Requested = PreRollMs.load(std::memory_order_relaxed) * SampleRate / 1000 * NumChannels;
+    const int32 Capacity  = FMath::Min(Requested, PreRollCapacity) / NumChannels * NumChannels;
+    if (Capacity <= 0) {
+        return;
+    }
+
+    // keep only the most recent audio, dropping the oldest whole frames
+    const int32 NumToWrite = FMath::Min(NumSamples, Capacity);
+    const int32 NumToDrop  = static_cast<int32>(PreRoll.Num()) + NumToWrite - Capacity;
+    if (NumToDrop > 0) {
+        PreRoll.Pop(NumToDrop);
+    }
+    PreRoll.Push(AudioData + (NumSamples - NumToWrite), NumToWrite);
+}
+
+void FOdinEncoderCaptureSink::FlushPreRoll(OdinEncoder* Encoder, const FOdinCaptureBlockInfo& BlockInfo)
+{
+    const int32 NumAvailable = PreRoll.Num();
+    if (NumAvailable <= 0) {
+        return;
+    }
+
+    if (PreRollScratch.Num() < NumAvailable) {
+        PreRollScratch.SetNumUninitialized(NumAvailable);
+    }
+    const int32 NumPopped = PreRoll.Pop(PreRollScratch.GetData(), NumAvailable);
+    PushToEncoder(Encoder, PreRollScratch.GetData(), NumPopped, BlockInfo);
+}
+
+void FOdinEncoderCaptureSink::PushToEncoder(OdinEncoder* Encoder, const float* AudioData, int32 NumSamples, const FOdinCaptureBlockInfo& BlockInfo)
+{
+    const TArrayView<const float> Remixed = Remixer.Process(AudioData, NumSamples);
+
+    // reuses a buffer the push thread returned, only the first blocks in flight allocate
+    TArray<float> PushBuffer;
+    PushBufferPool->Dequeue(PushBuffer);
+    PushBuffer.SetNumUninitialized(Remixed.Num());
+    FMemory::Memcpy(PushBuffer.GetData(), Remixed.GetData(), Remixed.Num() * sizeof(float));
+    PushDataThread->PushAudioToEncoder(Encoder, MoveTemp(PushBuffer), BlockInfo, PushBufferPool);
+}
+
 FOdinSubmixListener::FOdinSubmixListener()
 {
     AudioDeviceCreatedCallbackHandle   = FAudioDeviceManagerDelegates::OnAudioDeviceCreated.AddRaw(this, &FOdinSubmixListener::OnAudioDeviceCreated);
@@ -516,6 +927,16 @@ void FOdinSubmixListener::RemoveEffectId(const uint32 EffectId)
     }
 }
 
+void FOdinSubmixListener::RemapEffectIds(const TMap<uint32, uint32>& EffectIdMap)
+{
+    FScopeLock EffectAccessLock(&EffectIdAccessSection);
+    for (uint32& EffectId : ApmEffectIds) {
+        if (const uint32* NewEffectId = EffectIdMap.Find(EffectId)) {
+            EffectId = *NewEffectId;
+        }
+    }
+}
+
 void FOdinSubmixListener::SetDelay(int32 NewDelayInMs)
 { DelayMs = NewDelayInMs; }
 
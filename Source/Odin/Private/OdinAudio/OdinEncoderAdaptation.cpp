@@ -0,0 +1,166 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#include "OdinAudio/OdinEncoderAdaptation.h"
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "OdinFunctionLibrary.h"
+#include "OdinSubsystem.h"
+#include "OdinVoice.h"
+
+FOdinEncoderAdaptation::FOdinEncoderAdaptation(OdinRoom* InRoom, TArray<FOdinEncoderProfile> InProfiles, FOdinProfileChangeHandler InProfileChangeHandler,
+                                               const float InSampleIntervalMs)
+    : Room(InRoom)
+    , Profiles(MoveTemp(InProfiles))
+    , ProfileChangeHandler(MoveTemp(InProfileChangeHandler))
+    , bIsRunning(false)
+    , SampleEvent(nullptr)
+    , SampleIntervalMs(InSampleIntervalMs)
+{
+}
+
+FOdinEncoderAdaptation::~FOdinEncoderAdaptation()
+{ Exit(); }
+
+void FOdinEncoderAdaptation::Start(const int32 InitialProfileIndex)
+{
+    if (bIsRunning || Profiles.IsEmpty()) {
+        return;
+    }
+    ProfileIndex      = FMath::Clamp(InitialProfileIndex, 0, Profiles.Num() - 1);
+    LossPerc          = 0.0f;
+    BaselineRatio     = 0.0f;
+    bHasPreviousStats = false;
+    bIsRunning        = true;
+    SampleEvent       = FGenericPlatformProcess::GetSynchEventFromPool();
+    check(SampleEvent);
+    Thread.Reset(FRunnableThread::Create(this, TEXT("OdinEncoderAdaptationThread"), 0, TPri_BelowNormal));
+}
+
+OdinConnectionStats FOdinEncoderAdaptation::GetLastStats() const
+{
+    FScopeLock Lock(&StatsCS);
+    return LastStats;
+}
+
+float FOdinEncoderAdaptation::EstimateLoss(const OdinConnectionStats& Stats)
+{
+    // counters going backwards mean the connection was re-established, the baseline is learned again
+    if (!bHasPreviousStats || Stats.udp_tx_datagrams < PreviousStats.udp_tx_datagrams || Stats.udp_rx_datagrams < PreviousStats.udp_rx_datagrams) {
+        PreviousStats     = Stats;
+        bHasPreviousStats = true;
+        BaselineRatio     = 0.0f;
+        return LossPerc;
+    }
+
+    const uint64 SentDatagrams     = Stats.udp_tx_datagrams - PreviousStats.udp_tx_datagrams;
+    const uint64 ReceivedDatagrams = Stats.udp_rx_datagrams - PreviousStats.udp_rx_datagrams;
+    if (SentDatagrams < static_cast<uint64>(MinLossDatagrams)) {
+        // keep accumulating until the sample is meaningful
+        return LossPerc;
+    }
+    PreviousStats = Stats;
+
+    // The baseline follows improvements at once and drops only slowly, so lost datagrams show up as a shortfall against it
+    // while a lasting change of the traffic mix is absorbed after a few samples.
+    const float Ratio = static_cast<float>(ReceivedDatagrams) / static_cast<float>(SentDatagrams);
+    if (BaselineRatio > 0.0f && Ratio < BaselineRatio * RemoteSilenceRatio) {
+        // most received datagrams are remote voice, such a drop means the other peers stopped talking
+        BaselineRatio = Ratio;
+        return LossPerc;
+    }
+    if (BaselineRatio <= 0.0f || Ratio > BaselineRatio) {
+        BaselineRatio = Ratio;
+    } else {
+        BaselineRatio += (Ratio - BaselineRatio) * BaselineRate;
+    }
+
+    const float SampleLossPerc = BaselineRatio > 0.0f ? FMath::Clamp(1.0f - Ratio / BaselineRatio, 0.0f, 1.0f) * 100.0f : 0.0f;
+    const float Smoothed       = 0.5f * (LossPerc + SampleLossPerc);
+    LossPerc                   = Smoothed;
+    return Smoothed;
+}
+
+void FOdinEncoderAdaptation::Sample()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FOdinEncoderAdaptation::Sample);
+
+    if (!UOdinSubsystem::GlobalIsRoomValid(Room)) {
+        return;
+    }
+
+    OdinConnectionStats Stats;
+    const OdinError     Result = odin_room_get_connection_stats(Room, &Stats);
+    if (Result != ODIN_ERROR_SUCCESS) {
+        ODIN_LOG(Verbose, "Error on odin_room_get_connection_stats: %s", *UOdinFunctionLibrary::FormatOdinError(static_cast<EOdinError>(Result), false));
+        return;
+    }
+    {
+        FScopeLock Lock(&StatsCS);
+        LastStats = Stats;
+    }
+
+    const float Loss    = EstimateLoss(Stats);
+    const int32 Current = ProfileIndex;
+    int32       Target  = Current;
+    if (Current + 1 < Profiles.Num() && Stats.rtt > Profiles[Current].MaxRttMs) {
+        RecoverStreak = 0;
+        if (++DegradeStreak >= DegradeSamples) {
+            Target = Current + 1;
+        }
+    } else if (Current > 0 && Stats.rtt < Profiles[Current - 1].MaxRttMs * RecoverRatio) {
+        DegradeStreak = 0;
+        if (++RecoverStreak >= RecoverSamples) {
+            Target = Current - 1;
+        }
+    } else {
+        DegradeStreak = 0;
+        RecoverStreak = 0;
+    }
+
+    if (Target != Current) {
+        DegradeStreak = 0;
+        RecoverStreak = 0;
+        ProfileIndex  = Target;
+        ODIN_LOG(Log, "Encoder adaptation moves from profile %d to %d at %.1f ms round-trip time and %.1f%% estimated loss.", Current, Target, Stats.rtt,
+                 Loss);
+        if (ProfileChangeHandler) {
+            ProfileChangeHandler(Target);
+        }
+    }
+}
+
+uint32 FOdinEncoderAdaptation::Run()
+{
+    while (bIsRunning) {
+        check(SampleEvent);
+        SampleEvent->Wait(SampleIntervalMs);
+
+        if (bIsRunning) {
+            Sample();
+        }
+    }
+    return 0;
+}
+
+void FOdinEncoderAdaptation::Exit()
+{
+    if (!bIsRunning) {
+        return;
+    }
+
+    bIsRunning = false;
+
+    if (SampleEvent) {
+        SampleEvent->Trigger();
+    }
+    if (Thread.IsValid()) {
+        Thread->WaitForCompletion();
+    }
+
+    if (SampleEvent) {
+        FGenericPlatformProcess::ReturnSynchEventToPool(SampleEvent);
+        SampleEvent = nullptr;
+    }
+}
@@ -0,0 +1,329 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#include "OdinAudio/OdinEncoderInputMixer.h"
+
+#include "AudioDevice.h"
+#include "DSP/FloatArrayMath.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "OdinVoice.h"
+#include "OdinAudio/OdinAudioPushDataThread.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "Sound/SoundSubmix.h"
+
+FOdinMixerSource::FOdinMixerSource(int32 InSourceId, FName InName, int32 InSampleRate, int32 InNumChannels, float InGain, int32 InCapacityFrames)
+    : SourceId(InSourceId)
+    , Name(InName)
+    , SampleRate(InSampleRate)
+    , NumChannels(InNumChannels)
+    , Gain(InGain)
+{ Ring.SetCapacity(InCapacityFrames * InNumChannels); }
+
+void FOdinMixerSource::OnCapturedAudio(const float* AudioData, int32 NumFrames, int32 InNumChannels, int32 InSampleRate, const FOdinCaptureBlockInfo& BlockInfo)
+{ Write(AudioData, NumFrames, InNumChannels, InSampleRate, BlockInfo.ReceiveTime > 0.0 ? BlockInfo.ReceiveTime : FPlatformTime::Seconds()); }
+
+void FOdinMixerSource::Write(const float* AudioData, int32 NumFrames, int32 InNumChannels, int32 InSampleRate, double Timestamp)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FOdinMixerSource::Write);
+
+    if (!AudioData || NumFrames <= 0 || InNumChannels <= 0 || InSampleRate <= 0) {
+        return;
+    }
+
+    if (InNumChannels != NumInputChannels) {
+        NumInputChannels = InNumChannels;
+        Remixer.Init(NumInputChannels, NumChannels);
+    }
+    if (InSampleRate != InputSampleRate) {
+        InputSampleRate = InSampleRate;
+        Resampler.Init(InputSampleRate, SampleRate, NumChannels);
+    }
+
+    TArrayView<const float> Converted = Remixer.Process(AudioData, NumFrames * InNumChannels);
+    Converted                         = Resampler.Process(Converted.GetData(), NumFrames);
+
+    const int32 NumConvertedFrames = Converted.Num() / NumChannels;
+    const int32 NumFreeFrames      = static_cast<int32>(Ring.Remainder()) / NumChannels;
+    const int32 NumFramesToWrite   = FMath::Min(NumConvertedFrames, NumFreeFrames);
+    if (NumFramesToWrite < NumConvertedFrames) {
+        NumOverflowFrames.fetch_add(NumConvertedFrames - NumFramesToWrite, std::memory_order_relaxed);
+    }
+    if (NumFramesToWrite > 0) {
+        Ring.Push(Converted.GetData(), NumFramesToWrite * NumChannels);
+        TotalFramesWritten += NumFramesToWrite;
+    }
+    Anchor.Write(FWriteAnchor{.Timestamp = Timestamp, .TotalFrames = TotalFramesWritten});
+}
+
+FOdinInputMixerSourceStats FOdinMixerSource::GetStats() const
+{
+    FOdinInputMixerSourceStats Stats;
+    Stats.SourceId          = SourceId;
+    Stats.Name              = Name;
+    Stats.Gain              = GetGain();
+    Stats.NumMixedFrames    = NumMixedFrames.load(std::memory_order_relaxed);
+    Stats.NumUnderrunFrames = NumUnderrunFrames.load(std::memory_order_relaxed);
+    Stats.NumLateFrames     = NumLateFrames.load(std::memory_order_relaxed);
+    Stats.NumOverflowFrames = NumOverflowFrames.load(std::memory_order_relaxed);
+    return Stats;
+}
+
+FOdinMixerSubmixTap::FOdinMixerSubmixTap(FOdinMixerSourcePtr InSource)
+    : Source(MoveTemp(InSource))
+{
+}
+
+void FOdinMixerSubmixTap::OnNewSubmixBuffer(const USoundSubmix* OwningSubmix, float* AudioData, int32 NumSamples, int32 NumChannels, const int32 SampleRate,
+                                            double AudioClock)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FOdinMixerSubmixTap::OnNewSubmixBuffer);
+    if (bIsListening && Source.IsValid() && NumChannels > 0) {
+        Source->Write(AudioData, NumSamples / NumChannels, NumChannels, SampleRate, FPlatformTime::Seconds());
+    }
+}
+
+bool FOdinMixerSubmixTap::Attach(USoundSubmix* Submix)
+{
+    if (bIsListening) {
+        return true;
+    }
+    if (!FAudioDevice::GetAudioDeviceManager()) {
+        ODIN_LOG(Warning, "FOdinMixerSubmixTap::Attach failed, could not retrieve audio device manager");
+        return false;
+    }
+
+    FAudioDeviceHandle AudioDevice = FAudioDevice::GetAudioDeviceManager()->GetActiveAudioDevice();
+    if (!AudioDevice.IsValid()) {
+        ODIN_LOG(Warning, "FOdinMixerSubmixTap::Attach failed, no active audio device");
+        return false;
+    }
+
+    TappedSubmix   = Submix;
+    ListenTargetId = MakeShared<Audio::FDeviceId, ESPMode::ThreadSafe>(AudioDevice.GetDeviceID());
+    bIsListening   = true;
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 4
+    USoundSubmix* TargetSubmix = Submix ? Submix : &AudioDevice->GetMainSubmixObject();
+    AudioDevice->RegisterSubmixBufferListener(AsShared(), *TargetSubmix);
+#else
+    AudioDevice->RegisterSubmixBufferListener(this, Submix);
+#endif
+    return true;
+}
+
+void FOdinMixerSubmixTap::Detach()
+{
+    if (!bIsListening.exchange(false) || !ListenTargetId.IsValid() || !FAudioDevice::GetAudioDeviceManager()) {
+        return;
+    }
+
+    if (FAudioDeviceHandle AudioDevice = FAudioDevice::GetAudioDeviceManager()->GetAudioDevice(*ListenTargetId); AudioDevice.IsValid()) {
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 4
+        USoundSubmix* TargetSubmix = TappedSubmix.IsValid() ? TappedSubmix.Get() : &AudioDevice->GetMainSubmixObject();
+        AudioDevice->UnregisterSubmixBufferListener(AsShared(), *TargetSubmix);
+#else
+        AudioDevice->UnregisterSubmixBufferListener(this, TappedSubmix.Get());
+#endif
+    }
+    ListenTargetId.Reset();
+}
+
+FOdinEncoderInputMixer::FOdinEncoderInputMixer(TSharedPtr<FOdinAudioPushDataThread, ESPMode::ThreadSafe> InPushDataThread, int32 InSampleRate,
+                                               int32 InNumChannels, float InMixIntervalMs, float InMixLatencyMs)
+    : PushDataThread(MoveTemp(InPushDataThread))
+    , SampleRate(InSampleRate)
+    , NumChannels(InNumChannels)
+    , MixIntervalMs(InMixIntervalMs)
+    , MixLatencySeconds(InMixLatencyMs / 1000.0)
+    , SourceCapacityFrames(InSampleRate)
+    , PushBufferPool(MakeShared<FOdinAudioBufferPool, ESPMode::ThreadSafe>(8))
+    , bIsRunning(false)
+    , MixEvent(nullptr)
+{
+}
+
+FOdinEncoderInputMixer::~FOdinEncoderInputMixer()
+{ Exit(); }
+
+FOdinMixerSourcePtr FOdinEncoderInputMixer::AddSource(FName Name, float Gain)
+{
+    // one second of audio absorbs scheduling hiccups of the mixer thread
+    FOdinMixerSourcePtr Source;
+    {
+        FScopeLock Lock(&SourcesCS);
+        Source = MakeShared<FOdinMixerSource, ESPMode::ThreadSafe>(NextSourceId++, Name, SampleRate, NumChannels, Gain, SourceCapacityFrames);
+        Sources.Add(Source);
+    }
+    Start();
+    return Source;
+}
+
+bool FOdinEncoderInputMixer::RemoveSource(int32 SourceId)
+{
+    FScopeLock Lock(&SourcesCS);
+    return Sources.RemoveAll([SourceId](const FOdinMixerSourcePtr& Source) { return Source->GetSourceId() == SourceId; }) > 0;
+}
+
+FOdinMixerSourcePtr FOdinEncoderInputMixer::FindSource(int32 SourceId) const
+{
+    FScopeLock                 Lock(&SourcesCS);
+    const FOdinMixerSourcePtr* Found = Sources.FindByPredicate([SourceId](const FOdinMixerSourcePtr& Source) { return Source->GetSourceId() == SourceId; });
+    return Found ? *Found : nullptr;
+}
+
+void FOdinEncoderInputMixer::SetEncoderHandle(OdinEncoder* NewHandle)
+{ EncoderHandle.store(NewHandle, std::memory_order_release); }
+
+FOdinInputMixerStats FOdinEncoderInputMixer::GetStats() const
+{
+    FOdinInputMixerStats Stats;
+    {
+        FScopeLock Lock(&SourcesCS);
+        for (const FOdinMixerSourcePtr& Source : Sources) {
+            Stats.Sources.Add(Source->GetStats());
+        }
+    }
+    Stats.MeanMixTimeUs      = MeanMixTimeUs.load(std::memory_order_relaxed);
+    Stats.MaxMixTimeUs       = MaxMixTimeUs.load(std::memory_order_relaxed);
+    Stats.BudgetUsagePercent = MixIntervalMs > 0 ? Stats.MeanMixTimeUs / (MixIntervalMs * 10.0f) : 0.0f;
+    return Stats;
+}
+
+void FOdinEncoderInputMixer::Start()
+{
+    if (bIsRunning) {
+        return;
+    }
+    bIsRunning = true;
+    MixEvent   = FGenericPlatformProcess::GetSynchEventFromPool();
+    check(MixEvent);
+    Thread.Reset(FRunnableThread::Create(this, TEXT("OdinEncoderInputMixerThread"), 0, TPri_AboveNormal));
+}
+
+uint32 FOdinEncoderInputMixer::Run()
+{
+    while (bIsRunning) {
+        check(MixEvent);
+        MixEvent->Wait(MixIntervalMs);
+
+        if (bIsRunning) {
+            const uint64 StartCycles = FPlatformTime::Cycles64();
+            Mix();
+            const float MixTimeUs = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0);
+            MeanMixTimeUs.store(MeanMixTimeUs.load(std::memory_order_relaxed) * 0.95f + MixTimeUs * 0.05f, std::memory_order_relaxed);
+            if (MixTimeUs > MaxMixTimeUs.load(std::memory_order_relaxed)) {
+                MaxMixTimeUs.store(MixTimeUs, std::memory_order_relaxed);
+            }
+        }
+    }
+    return 0;
+}
+
+void FOdinEncoderInputMixer::Mix()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FOdinEncoderInputMixer::Mix);
+
+    // The mix window trails the wall clock by the mix latency, so every source had time to deliver its audio for it.
+    const double WindowEnd = FPlatformTime::Seconds() - MixLatencySeconds;
+    if (WindowStart <= 0.0) {
+        WindowStart = WindowEnd;
+        return;
+    }
+    int32 NumFrames = static_cast<int32>((WindowEnd - WindowStart) * SampleRate);
+    if (NumFrames <= 0) {
+        return;
+    }
+    // After a stall the window can outgrow the source rings, older audio is gone anyway and the mix resumes with the
+    // newest window the sources can still hold.
+    if (NumFrames > SourceCapacityFrames) {
+        WindowStart = WindowEnd - static_cast<double>(SourceCapacityFrames) / SampleRate;
+        NumFrames   = SourceCapacityFrames;
+    }
+
+    MixBuffer.SetNumUninitialized(NumFrames * NumChannels);
+    FMemory::Memzero(MixBuffer.GetData(), MixBuffer.Num() * sizeof(float));
+    {
+        FScopeLock Lock(&SourcesCS);
+        for (const FOdinMixerSourcePtr& Source : Sources) {
+            MixSource(*Source, NumFrames);
+        }
+    }
+    WindowStart += static_cast<double>(NumFrames) / SampleRate;
+
+    OdinEncoder* Encoder = EncoderHandle.load(std::memory_order_acquire);
+    if (Encoder && PushDataThread.IsValid()) {
+        // reuses a buffer the push thread returned, only the first blocks in flight allocate
+        TArray<float> PushBuffer;
+        PushBufferPool->Dequeue(PushBuffer);
+        PushBuffer.SetNumUninitialized(MixBuffer.Num());
+        FMemory::Memcpy(PushBuffer.GetData(), MixBuffer.GetData(), MixBuffer.Num() * sizeof(float));
+
+        // the queue delay of the push thread covers the time from here, the mix latency itself is intentional
+        FOdinCaptureBlockInfo BlockInfo;
+        BlockInfo.ReceiveTime = FPlatformTime::Seconds();
+        PushDataThread->PushAudioToEncoder(Encoder, MoveTemp(PushBuffer), BlockInfo, PushBufferPool);
+    }
+}
+
+void FOdinEncoderInputMixer::MixSource(FOdinMixerSource& Source, int32 NumFrames)
+{
+    FOdinMixerSource::FWriteAnchor Anchor;
+    Source.Anchor.Read(Anchor);
+    if (Anchor.TotalFrames == 0) {
+        return;
+    }
+
+    // receive time of the oldest frame still in the ring, derived from the latest consistent write
+    int64  NumAvailable = static_cast<int64>(Anchor.TotalFrames - Source.TotalFramesRead);
+    double HeadTime     = Anchor.Timestamp - static_cast<double>(NumAvailable) / SampleRate;
+
+    // skip audio that belongs before this window, a small tolerance absorbs rounding and block jitter
+    const int32 Tolerance = SampleRate / 500;
+    const int64 NumLate   = FMath::Min<int64>(NumAvailable, FMath::RoundToInt64((WindowStart - HeadTime) * SampleRate));
+    if (NumLate > Tolerance) {
+        Source.Ring.Pop(static_cast<uint32>(NumLate * NumChannels));
+        Source.TotalFramesRead += NumLate;
+        Source.NumLateFrames.fetch_add(NumLate, std::memory_order_relaxed);
+        NumAvailable -= NumLate;
+        HeadTime = WindowStart;
+    }
+
+    const int32 Offset   = FMath::Clamp(static_cast<int32>(FMath::RoundToInt64((HeadTime - WindowStart) * SampleRate)), 0, NumFrames);
+    const int32 NumToMix = static_cast<int32>(FMath::Min<int64>(NumAvailable, NumFrames - Offset));
+    if (NumToMix < NumFrames - Offset) {
+        Source.NumUnderrunFrames.fetch_add(NumFrames - Offset - NumToMix, std::memory_order_relaxed);
+    }
+    if (NumToMix <= 0) {
+        return;
+    }
+
+    SourceBuffer.SetNumUninitialized(NumToMix * NumChannels);
+    const int32 NumPopped = Source.Ring.Pop(SourceBuffer.GetData(), NumToMix * NumChannels);
+    Source.TotalFramesRead += NumPopped / NumChannels;
+    Source.NumMixedFrames.fetch_add(NumPopped / NumChannels, std::memory_order_relaxed);
+
+    Audio::ArrayMixIn(TArrayView<const float>(SourceBuffer.GetData(), NumPopped), TArrayView<float>(MixBuffer.GetData() + Offset * NumChannels, NumPopped),
+                      Source.GetGain());
+}
+
+void FOdinEncoderInputMixer::Exit()
+{
+    if (!bIsRunning) {
+        return;
+    }
+
+    bIsRunning = false;
+
+    if (MixEvent) {
+        MixEvent->Trigger();
+    }
+    if (Thread.IsValid()) {
+        Thread->WaitForCompletion();
+    }
+
+    if (MixEvent) {
+        FGenericPlatformProcess::ReturnSynchEventToPool(MixEvent);
+        MixEvent = nullptr;
+    }
+}
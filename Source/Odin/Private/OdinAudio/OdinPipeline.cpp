@@ -7,6 +7,7 @@
 #include "OdinAudio/Effects/OdinCloneEffect.h"
 #include "OdinAudio/Effects/OdinMuteEffect.h"
 #include "OdinAudio/Effects/OdinVolumeEffect.h"
+#include "OdinAudio/OdinPipelineDescriptor.h"
 
 UOdinPipeline::UOdinPipeline(const class FObjectInitializer &PCIP)
     : Super(PCIP)
@@ -79,6 +80,13 @@ bool UOdinPipeline::RemoveEffect(int32 EffectId)
 {
     const OdinError Result = odin_pipeline_remove_effect(this->GetHandle(), EffectId);
     if (Result == OdinError::ODIN_ERROR_SUCCESS) {
+        TWeakObjectPtr<UOdinCustomEffect> CustomEffect;
+        if (CustomEffects.RemoveAndCopyValue(EffectId, CustomEffect)) {
+            OwnedCustomEffects.Remove(CustomEffect.Get());
+        }
+        // the native pipeline no longer calls the effect once it was removed
+        NativeEffects.Remove(EffectId);
+        EffectTimers.Remove(EffectId);
         return true;
     }
 
@@ -95,11 +103,12 @@ int32 UOdinPipeline::InsertCustomEffect(int32 Index, UOdinCustomEffect *Effect)
     }
 
     uint32_t   ID;
-    const auto Result = odin_pipeline_insert_custom_effect(this->GetHandle(), Index, Effect->FFICallback, &Effect->UserData, &ID);
+    const auto Result = InsertTimedEffect(Index, Effect->FFICallback, &Effect->UserData, Effect->GetName(), ID);
     if (Result == OdinError::ODIN_ERROR_SUCCESS) {
         Effect->SetParent(this->Self);
         Effect->Index    = Index;
         Effect->EffectId = ID;
+        CustomEffects.Add(ID, Effect);
         return ID;
     } else {
         FOdinModule::LogErrorCode("Aborting InsertCustomEffect due to invalid "
@@ -109,6 +118,200 @@ int32 UOdinPipeline::InsertCustomEffect(int32 Index, UOdinCustomEffect *Effect)
     return 0;
 }
 
+int32 UOdinPipeline::InsertNativeEffect(int32 Index, FOdinNativeEffectRef Effect)
+{
+    if (!Effect.IsValid()) {
+        ODIN_LOG(Error, "Aborting InsertNativeEffect due to invalid IOdinNativeEffect.");
+        return 0;
+    }
+
+    uint32_t   ID;
+    const auto Result = InsertTimedEffect(Index, &IOdinNativeEffect::FFICallback, Effect.GetReference(),
+                                          FString::Printf(TEXT("%s_%u"), Effect->GetName(), NumNativeEffectsInserted++), ID);
+    if (Result == OdinError::ODIN_ERROR_SUCCESS) {
+        NativeEffects.Add(ID, MoveTemp(Effect));
+        return ID;
+    } else {
+        FOdinModule::LogErrorCode("Aborting InsertNativeEffect due to invalid "
+                                  "odin_pipeline_insert_custom_effect call: %s",
+                                  Result);
+    }
+    return 0;
+}
+
+FOdinNativeEffectRef UOdinPipeline::FindNativeEffect(int32 EffectId) const
+{
+    const FOdinNativeEffectRef *Effect = NativeEffects.Find(EffectId);
+    return Effect ? *Effect : FOdinNativeEffectRef();
+}
+
+OdinError UOdinPipeline::InsertTimedEffect(int32 Index, OdinCustomEffectCallback Callback, const void *UserData, const FString &Name, uint32_t &OutEffectId)
+{
+    FOdinEffectTimerRef Timer  = new FOdinEffectTimer(GetOrCreateTimings(), Callback, UserData, Name);
+    const OdinError     Result = odin_pipeline_insert_custom_effect(GetHandle(), Index, &FOdinEffectTimer::FFICallback, Timer.GetReference(), &OutEffectId);
+    if (Result == OdinError::ODIN_ERROR_SUCCESS) {
+        Timer->SetEffectId(OutEffectId);
+        EffectTimers.Add(OutEffectId, MoveTemp(Timer));
+    }
+    return Result;
+}
+
+FOdinPipelineTimings *UOdinPipeline::GetOrCreateTimings()
+{
+    if (!Timings.IsValid()) {
+        Timings = new FOdinPipelineTimings(FString::Printf(TEXT("%s.%s"), *GetNameSafe(GetOuter()), *GetName()));
+    }
+    return Timings.GetReference();
+}
+
+// timing
+void UOdinPipeline::SetEffectTimingEnabled(bool bEnabled)
+{
+    FOdinPipelineTimings *PipelineTimings = GetOrCreateTimings();
+    if (PipelineTimings->IsEnabled() == bEnabled) {
+        return;
+    }
+    PipelineTimings->SetEnabled(bEnabled);
+    UpdateTimingRegistration(bEnabled ? GetHandle() : nullptr);
+}
+
+void UOdinPipeline::UpdateTimingRegistration(const OdinPipeline *NewHandle)
+{
+    // pop calls only know the encoder or decoder and find the timings by pipeline handle
+    if (RegisteredTimingHandle) {
+        FOdinPipelineTimings::Unregister(RegisteredTimingHandle, Timings);
+    }
+    RegisteredTimingHandle = NewHandle;
+    if (RegisteredTimingHandle) {
+        FOdinPipelineTimings::Register(RegisteredTimingHandle, Timings);
+    }
+}
+
+bool UOdinPipeline::IsEffectTimingEnabled() const
+{ return Timings.IsValid() && Timings->IsEnabled(); }
+
+FOdinEffectTimingStats UOdinPipeline::GetEffectTimingStats(TArray<FOdinEffectTimingStats> &OutEffects) const
+{
+    OutEffects.Reset(EffectTimers.Num());
+    const int32 Count = GetEffectCount();
+    for (int32 Index = 0; Index < Count; ++Index) {
+        uint32_t EffectId;
+        if (odin_pipeline_get_effect_id(GetHandle(), Index, &EffectId) != OdinError::ODIN_ERROR_SUCCESS) {
+            continue;
+        }
+        if (const FOdinEffectTimerRef *Timer = EffectTimers.Find(EffectId)) {
+            (*Timer)->GetStats(OutEffects.AddDefaulted_GetRef());
+        }
+    }
+
+    FOdinEffectTimingStats PopStats;
+    PopStats.Name = TEXT("Pop");
+    if (Timings.IsValid()) {
+        Timings->PopStats.Get(PopStats);
+    }
+    return PopStats;
+}
+
+void UOdinPipeline::ResetEffectTimingStats()
+{
+    if (Timings.IsValid()) {
+        Timings->PopStats.Reset();
+    }
+    for (const TPair<uint32, FOdinEffectTimerRef> &Entry : EffectTimers) {
+        Entry.Value->ResetStats();
+    }
+}
+
+bool UOdinPipeline::ApplyDescriptorAsset(UOdinPipelineDescriptorAsset *Descriptor, TArray<UOdinCustomEffect *> &OutCustomEffects)
+{
+    OutCustomEffects.Reset();
+    if (!IsValid(Descriptor)) {
+        ODIN_LOG(Error, "Aborting ApplyDescriptorAsset due to invalid UOdinPipelineDescriptorAsset pin.");
+        return false;
+    }
+    const FOdinCompiledPipelineDescriptor *Compiled = Descriptor->GetCompiled();
+    if (!Compiled) {
+        ODIN_LOG(Error, "Aborting ApplyDescriptorAsset, descriptor %s is invalid.", *Descriptor->GetName());
+        return false;
+    }
+    return ApplyCompiledDescriptor(*Compiled, OutCustomEffects);
+}
+
+bool UOdinPipeline::ApplyDescriptor(const FOdinPipelineDescriptor &Descriptor, TArray<UOdinCustomEffect *> &OutCustomEffects)
+{
+    OutCustomEffects.Reset();
+    FOdinCompiledPipelineDescriptor Compiled;
+    TArray<FString>                 Errors;
+    if (!Descriptor.Compile(Compiled, Errors)) {
+        ODIN_LOG(Error, "Aborting ApplyDescriptor due to invalid descriptor: %s", *FString::Join(Errors, TEXT(" ")));
+        return false;
+    }
+    return ApplyCompiledDescriptor(Compiled, OutCustomEffects);
+}
+
+bool UOdinPipeline::ApplyCompiledDescriptor(const FOdinCompiledPipelineDescriptor &Compiled, TArray<UOdinCustomEffect *> &OutCustomEffects)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinPipeline::ApplyCompiledDescriptor);
+
+    OutCustomEffects.Reset(Compiled.Slots.Num());
+    TArray<uint32, TInlineAllocator<16>> InsertedIds;
+    const int32                          FirstIndex = GetEffectCount();
+
+    OdinError Result = OdinError::ODIN_ERROR_SUCCESS;
+    for (int32 SlotIndex = 0; SlotIndex < Compiled.Slots.Num() && Result == OdinError::ODIN_ERROR_SUCCESS; ++SlotIndex) {
+        const FOdinCompiledPipelineDescriptor::FSlot &Slot  = Compiled.Slots[SlotIndex];
+        const int32                                   Index = FirstIndex + SlotIndex;
+
+        uint32_t ID = 0;
+        switch (Slot.Type) {
+            case EOdinPipelineSlotType::Vad:
+                Result = odin_pipeline_insert_vad_effect(GetHandle(), Index, &ID);
+                if (Result == OdinError::ODIN_ERROR_SUCCESS) {
+                    InsertedIds.Add(ID);
+                    Result = odin_pipeline_set_vad_config(GetHandle(), ID, &Slot.VadConfig);
+                }
+                break;
+            case EOdinPipelineSlotType::Apm:
+                Result = odin_pipeline_insert_apm_effect(GetHandle(), Index, Compiled.ApmSampleRate, Compiled.bApmStereo, &ID);
+                if (Result == OdinError::ODIN_ERROR_SUCCESS) {
+                    InsertedIds.Add(ID);
+                    Result = odin_pipeline_set_apm_config(GetHandle(), ID, &Slot.ApmConfig);
+                }
+                break;
+            case EOdinPipelineSlotType::Custom: {
+                UOdinCustomEffect *Effect = NewObject<UOdinCustomEffect>(this, Slot.CustomEffectClass);
+                Result                    = InsertTimedEffect(Index, Effect->FFICallback, &Effect->UserData, Effect->GetName(), ID);
+                if (Result == OdinError::ODIN_ERROR_SUCCESS) {
+                    InsertedIds.Add(ID);
+                    Effect->SetParent(this->Self);
+                    Effect->Index    = Index;
+                    Effect->EffectId = ID;
+                    CustomEffects.Add(ID, Effect);
+                    OwnedCustomEffects.Add(Effect);
+                    OutCustomEffects.Add(Effect);
+                }
+            } break;
+        }
+    }
+
+    if (Result != OdinError::ODIN_ERROR_SUCCESS) {
+        // leave the pipeline as it was, so a failed descriptor never results in a partial pipeline
+        for (int32 Index = InsertedIds.Num() - 1; Index >= 0; --Index) {
+            odin_pipeline_remove_effect(GetHandle(), InsertedIds[Index]);
+            CustomEffects.Remove(InsertedIds[Index]);
+            EffectTimers.Remove(InsertedIds[Index]);
+        }
+        for (UOdinCustomEffect *Effect : OutCustomEffects) {
+            Effect->SetParent(nullptr);
+            OwnedCustomEffects.Remove(Effect);
+        }
+        OutCustomEffects.Reset();
+        FOdinModule::LogErrorCode("Aborting ApplyCompiledDescriptor due to failed effect insertion: %s", Result);
+        return false;
+    }
+    return true;
+}
+
 // vad
 int32 UOdinPipeline::InsertVadEffect(int32 Index)
 {
@@ -261,6 +464,118 @@ UOdinVolumeEffect *UOdinPipeline::AppendVolumeEffect()
 
 void UOdinPipeline::SetHandle(const OdinPipeline *NewHandle)
 {
+    if (IsEffectTimingEnabled()) {
+        UpdateTimingRegistration(NewHandle);
+    }
     this->Handle = NewObject<UOdinHandle>();
     this->Handle->SetHandle(const_cast<OdinPipeline *>(NewHandle));
 }
+
+bool UOdinPipeline::CopyEffectsTo(const OdinPipeline *Target, int32 SampleRate, bool bStereo, TMap<uint32, uint32> &OutEffectIdMap) const
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinPipeline::CopyEffectsTo);
+
+    OutEffectIdMap.Reset();
+    const int32 Count = GetEffectCount();
+    for (int32 Index = 0; Index < Count; ++Index) {
+        uint32_t  EffectId;
+        OdinError Result = odin_pipeline_get_effect_id(GetHandle(), Index, &EffectId);
+        if (Result != OdinError::ODIN_ERROR_SUCCESS) {
+            FOdinModule::LogErrorCode("Aborting CopyEffectsTo due to invalid odin_pipeline_get_effect_id call: %s", Result);
+            return false;
+        }
+
+        OdinEffectType EffectType;
+        Result = odin_pipeline_get_effect_type(GetHandle(), EffectId, &EffectType);
+        if (Result != OdinError::ODIN_ERROR_SUCCESS) {
+            FOdinModule::LogErrorCode("Aborting CopyEffectsTo due to invalid odin_pipeline_get_effect_type call: %s", Result);
+            return false;
+        }
+
+        uint32_t NewEffectId = 0;
+        switch (EffectType) {
+            case OdinEffectType::ODIN_EFFECT_TYPE_VAD: {
+                OdinVadConfig Config;
+                Result = odin_pipeline_get_vad_config(GetHandle(), EffectId, &Config);
+                if (Result == OdinError::ODIN_ERROR_SUCCESS) {
+                    Result = odin_pipeline_insert_vad_effect(Target, Index, &NewEffectId);
+                }
+                if (Result == OdinError::ODIN_ERROR_SUCCESS) {
+                    Result = odin_pipeline_set_vad_config(Target, NewEffectId, &Config);
+                }
+            } break;
+            case OdinEffectType::ODIN_EFFECT_TYPE_APM: {
+                OdinApmConfig Config;
+                Result = odin_pipeline_get_apm_config(GetHandle(), EffectId, &Config);
+                if (Result == OdinError::ODIN_ERROR_SUCCESS) {
+                    Result = odin_pipeline_insert_apm_effect(Target, Index, SampleRate, bStereo, &NewEffectId);
+                }
+                if (Result == OdinError::ODIN_ERROR_SUCCESS) {
+                    Result = odin_pipeline_set_apm_config(Target, NewEffectId, &Config);
+                }
+            } break;
+            case OdinEffectType::ODIN_EFFECT_TYPE_CUSTOM: {
+                // custom and native effects are inserted with their timer, so statistics continue on the new pipeline
+                const FOdinEffectTimerRef               *Timer  = EffectTimers.Find(EffectId);
+                const TWeakObjectPtr<UOdinCustomEffect> *Effect = CustomEffects.Find(EffectId);
+                if (!Timer || (!NativeEffects.Contains(EffectId) && (!Effect || !Effect->IsValid()))) {
+                    ODIN_LOG(Error, "Aborting CopyEffectsTo, custom effect %u was not inserted through this pipeline.", EffectId);
+                    return false;
+                }
+                Result = odin_pipeline_insert_custom_effect(Target, Index, &FOdinEffectTimer::FFICallback, Timer->GetReference(), &NewEffectId);
+            } break;
+            default:
+                ODIN_LOG(Error, "Aborting CopyEffectsTo due to unknown effect type %d.", static_cast<int32>(EffectType));
+                return false;
+        }
+
+        if (Result != OdinError::ODIN_ERROR_SUCCESS) {
+            FOdinModule::LogErrorCode("Aborting CopyEffectsTo due to failed effect insertion: %s", Result);
+            return false;
+        }
+        OutEffectIdMap.Add(EffectId, NewEffectId);
+    }
+    return true;
+}
+
+void UOdinPipeline::SwapHandle(const OdinPipeline *NewHandle, const TMap<uint32, uint32> &EffectIdMap)
+{
+    SetHandle(NewHandle);
+
+    TMap<uint32, TWeakObjectPtr<UOdinCustomEffect>> RemappedEffects;
+    for (const TPair<uint32, TWeakObjectPtr<UOdinCustomEffect>> &Entry : CustomEffects) {
+        const uint32 *NewEffectId = EffectIdMap.Find(Entry.Key);
+        if (!NewEffectId || !Entry.Value.IsValid()) {
+            // the effect is not part of the new pipeline anymore
+            OwnedCustomEffects.Remove(Entry.Value.Get());
+            continue;
+        }
+        Entry.Value->EffectId = *NewEffectId;
+        Entry.Value->Index    = GetEffectIndex(*NewEffectId);
+        RemappedEffects.Add(*NewEffectId, Entry.Value);
+    }
+    CustomEffects = MoveTemp(RemappedEffects);
+
+    TMap<uint32, FOdinNativeEffectRef> RemappedNativeEffects;
+    for (TPair<uint32, FOdinNativeEffectRef> &Entry : NativeEffects) {
+        if (const uint32 *NewEffectId = EffectIdMap.Find(Entry.Key)) {
+            RemappedNativeEffects.Add(*NewEffectId, MoveTemp(Entry.Value));
+        }
+    }
+    NativeEffects = MoveTemp(RemappedNativeEffects);
+
+    TMap<uint32, FOdinEffectTimerRef> RemappedTimers;
+    for (TPair<uint32, FOdinEffectTimerRef> &Entry : EffectTimers) {
+        if (const uint32 *NewEffectId = EffectIdMap.Find(Entry.Key)) {
+            Entry.Value->SetEffectId(*NewEffectId);
+            RemappedTimers.Add(*NewEffectId, MoveTemp(Entry.Value));
+        }
+    }
+    EffectTimers = MoveTemp(RemappedTimers);
+}
+
+void UOdinPipeline::BeginDestroy()
+{
+    UpdateTimingRegistration(nullptr);
+    Super::BeginDestroy();
+}
@@ -0,0 +1,90 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#include "OdinAudio/OdinPipelineDescriptor.h"
+
+#include "OdinVoice.h"
+#include "OdinAudio/Effects/OdinCustomEffect.h"
+
+namespace
+{
+    void ValidateSensitivity(const FOdinSensitivityConfig &Config, const TCHAR *Name, int32 SlotIndex, float Min, float Max, TArray<FString> &OutErrors)
+    {
+        if (!Config.Enabled) {
+            return;
+        }
+        if (Config.AttackThreshold < Min || Config.AttackThreshold > Max || Config.ReleaseThreshold < Min || Config.ReleaseThreshold > Max) {
+            OutErrors.Add(FString::Printf(TEXT("Slot %d: %s thresholds must be within [%.1f, %.1f]."), SlotIndex, Name, Min, Max));
+        }
+        if (Config.ReleaseThreshold > Config.AttackThreshold) {
+            OutErrors.Add(FString::Printf(TEXT("Slot %d: %s release threshold must not exceed the attack threshold."), SlotIndex, Name));
+        }
+    }
+} // namespace
+
+bool FOdinPipelineDescriptor::Compile(FOdinCompiledPipelineDescriptor &OutCompiled, TArray<FString> &OutErrors) const
+{
+    const int32 NumErrors = OutErrors.Num();
+    if (ApmSampleRate < 8000 || ApmSampleRate > 192000) {
+        OutErrors.Add(FString::Printf(TEXT("APM sample rate %d is out of range."), ApmSampleRate));
+    }
+
+    OutCompiled.Slots.Reset(Slots.Num());
+    OutCompiled.ApmSampleRate = ApmSampleRate;
+    OutCompiled.bApmStereo    = bApmStereo;
+    for (int32 Index = 0; Index < Slots.Num(); ++Index) {
+        const FOdinPipelineEffectSlot &Slot = Slots[Index];
+
+        FOdinCompiledPipelineDescriptor::FSlot Compiled;
+        Compiled.Type = Slot.Type;
+        switch (Slot.Type) {
+            case EOdinPipelineSlotType::Vad: {
+                ValidateSensitivity(Slot.VadConfig.VoiceActivity, TEXT("Voice activity"), Index, 0.0f, 1.0f, OutErrors);
+                ValidateSensitivity(Slot.VadConfig.VolumeGate, TEXT("Volume gate"), Index, -90.0f, 0.0f, OutErrors);
+                FOdinVadConfig Config = Slot.VadConfig;
+                Compiled.VadConfig    = Config;
+            } break;
+            case EOdinPipelineSlotType::Apm: {
+                FOdinApmConfig Config = Slot.ApmConfig;
+                Compiled.ApmConfig    = Config;
+            } break;
+            case EOdinPipelineSlotType::Custom: {
+                UClass *Class = Slot.CustomEffectClass.Get();
+                if (!Class) {
+                    OutErrors.Add(FString::Printf(TEXT("Slot %d: no custom effect class set."), Index));
+                } else if (Class->HasAnyClassFlags(CLASS_Abstract)) {
+                    OutErrors.Add(FString::Printf(TEXT("Slot %d: custom effect class %s is abstract."), Index, *Class->GetName()));
+                }
+                Compiled.CustomEffectClass = Class;
+            } break;
+        }
+        OutCompiled.Slots.Add(Compiled);
+    }
+    return OutErrors.Num() == NumErrors;
+}
+
+const FOdinCompiledPipelineDescriptor *UOdinPipelineDescriptorAsset::GetCompiled()
+{
+    if (!bIsCompiled) {
+        TArray<FString> Errors;
+        bIsValid    = Descriptor.Compile(Compiled, Errors);
+        bIsCompiled = true;
+        for (const FString &Error : Errors) {
+            ODIN_LOG(Error, "Invalid pipeline descriptor %s: %s", *GetName(), *Error);
+        }
+    }
+    return bIsValid ? &Compiled : nullptr;
+}
+
+bool UOdinPipelineDescriptorAsset::Validate(TArray<FString> &OutErrors) const
+{
+    FOdinCompiledPipelineDescriptor Unused;
+    return Descriptor.Compile(Unused, OutErrors);
+}
+
+#if WITH_EDITOR
+void UOdinPipelineDescriptorAsset::PostEditChangeProperty(FPropertyChangedEvent &PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    bIsCompiled = false;
+}
+#endif
@@ -0,0 +1,319 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#include "OdinAudio/OdinPipelineProcessCommandlet.h"
+
+#include "Audio.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "OdinVoice.h"
+#include "OdinAudio/OdinDecoder.h"
+#include "OdinAudio/OdinEncoder.h"
+#include "OdinAudio/OdinPipeline.h"
+#include "OdinAudio/OdinPipelineDescriptor.h"
+#include "OdinAudio/OdinRemixer.h"
+#include "OdinAudio/OdinResampler.h"
+#include "UObject/Package.h"
+
+namespace OdinPipelineProcess
+{
+    constexpr uint16 WaveFormatPcm   = 1;
+    constexpr uint16 WaveFormatFloat = 3;
+    constexpr int32  FrameMs         = 20;
+    constexpr int32  MaxDatagramSize = 1300;
+
+    /**
+     * @return false if a descriptor was passed but could not be loaded
+     */
+    bool LoadDescriptor(const FString& Params, const TCHAR* Key, UOdinPipelineDescriptorAsset*& OutDescriptor)
+    {
+        FString Path;
+        if (!FParse::Value(*Params, Key, Path)) {
+            OutDescriptor = nullptr;
+            return true;
+        }
+        OutDescriptor = LoadObject<UOdinPipelineDescriptorAsset>(nullptr, *Path);
+        if (!OutDescriptor) {
+            ODIN_LOG(Error, "OdinPipelineProcess: could not load pipeline descriptor %s.", *Path);
+            return false;
+        }
+        return true;
+    }
+
+    bool ApplyDescriptor(UOdinPipeline* Pipeline, UOdinPipelineDescriptorAsset* Descriptor)
+    {
+        if (!Descriptor) {
+            return true;
+        }
+        TArray<UOdinCustomEffect*> CustomEffects;
+        return Pipeline->ApplyDescriptorAsset(Descriptor, CustomEffects);
+    }
+
+    template <typename FunctionType> void Timed(FOdinTimingStats& Stats, FunctionType&& Function)
+    {
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        Function();
+        Stats.Record(FPlatformTime::Cycles64() - StartCycles);
+    }
+
+    void AppendRow(FString& Csv, const FString& File, const TCHAR* Stage, const FOdinTimingStats& Stats)
+    {
+        FOdinEffectTimingStats Result;
+        Stats.Get(Result);
+        Csv += FString::Printf(TEXT("%s,%s,%lld,%.3f,%.2f,%.2f,%.2f\n"), *File, Stage, Result.NumCalls, Result.NumCalls * Result.MeanUs / 1000.0, Result.MeanUs,
+                               Result.MaxUs, Result.P99Us);
+    }
+
+    void AppendRow(FString& Csv, const FString& File, const FString& Stage, const FOdinEffectTimingStats& Result)
+    {
+        Csv += FString::Printf(TEXT("%s,%s,%lld,%.3f,%.2f,%.2f,%.2f\n"), *File, *Stage, Result.NumCalls, Result.NumCalls * Result.MeanUs / 1000.0, Result.MeanUs,
+                               Result.MaxUs, Result.P99Us);
+    }
+} // namespace OdinPipelineProcess
+
+UOdinPipelineProcessCommandlet::UOdinPipelineProcessCommandlet()
+{
+    IsClient        = false;
+    IsServer        = false;
+    IsEditor        = false;
+    LogToConsole    = true;
+    ShowErrorCount  = true;
+    HelpDescription = TEXT("Processes WAV files offline through an Odin encoder and decoder pipeline and reports per-stage timing.");
+    HelpUsage       = TEXT("-run=OdinPipelineProcess -Input=<file or directory> -Output=<directory> [-EncoderDescriptor=<asset>] "
+                           "[-DecoderDescriptor=<asset>] [-SampleRate=48000] [-Stereo]");
+}
+
+int32 UOdinPipelineProcessCommandlet::Main(const FString& Params)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinPipelineProcessCommandlet::Main);
+
+    FString Input;
+    FString Output;
+    if (!FParse::Value(*Params, TEXT("Input="), Input) || !FParse::Value(*Params, TEXT("Output="), Output)) {
+        ODIN_LOG(Error, "OdinPipelineProcess: usage %s", *HelpUsage);
+        return 1;
+    }
+    FParse::Value(*Params, TEXT("SampleRate="), SampleRate);
+    bStereo = FParse::Param(*Params, TEXT("Stereo"));
+
+    if (!OdinPipelineProcess::LoadDescriptor(Params, TEXT("EncoderDescriptor="), EncoderDescriptor)
+        || !OdinPipelineProcess::LoadDescriptor(Params, TEXT("DecoderDescriptor="), DecoderDescriptor)) {
+        return 1;
+    }
+
+    TArray<FString> InputFiles;
+    const bool      bIsDirectory = IFileManager::Get().DirectoryExists(*Input);
+    if (bIsDirectory) {
+        IFileManager::Get().FindFilesRecursive(InputFiles, *Input, TEXT("*.wav"), true, false);
+        InputFiles.Sort();
+    } else {
+        InputFiles.Add(Input);
+    }
+    if (InputFiles.IsEmpty()) {
+        ODIN_LOG(Error, "OdinPipelineProcess: no WAV files found in %s.", *Input);
+        return 1;
+    }
+    IFileManager::Get().MakeDirectory(*Output, true);
+
+    // with a trailing separator, so MakePathRelativeTo treats it as a directory
+    const FString                   InputRoot = FPaths::ConvertRelativePathToFull(Input) / TEXT("");
+    TArray<TUniquePtr<FFileResult>> Results;
+    int32                           NumFailed = 0;
+    for (const FString& InputFile : InputFiles) {
+        // the output mirrors the input tree, so files of the same name in different subfolders neither overwrite each other
+        // nor share a row name in the report
+        FString RelativeFile = FPaths::GetCleanFilename(InputFile);
+        if (bIsDirectory) {
+            RelativeFile = FPaths::ConvertRelativePathToFull(InputFile);
+            FPaths::MakePathRelativeTo(RelativeFile, *InputRoot);
+        }
+        const FString OutputFile = FPaths::Combine(Output, RelativeFile);
+        IFileManager::Get().MakeDirectory(*FPaths::GetPath(OutputFile), true);
+
+        // the timing stats are atomic and can neither be copied nor moved, so only results of processed files are kept
+        TUniquePtr<FFileResult> Result = MakeUnique<FFileResult>();
+        Result->Name                   = RelativeFile;
+        if (!ProcessFile(InputFile, OutputFile, *Result)) {
+            ++NumFailed;
+            continue;
+        }
+        ODIN_LOG(Display, "OdinPipelineProcess: %s, %.1f s of audio in %.3f s (%.0fx realtime).", *Result->Name, Result->AudioSeconds, Result->ProcessSeconds,
+                 Result->ProcessSeconds > 0.0 ? Result->AudioSeconds / Result->ProcessSeconds : 0.0);
+        Results.Add(MoveTemp(Result));
+    }
+
+    WriteTimingReport(FPaths::Combine(Output, TEXT("OdinPipelineTiming.csv")), Results);
+    return NumFailed > 0 ? 1 : 0;
+}
+
+bool UOdinPipelineProcessCommandlet::ProcessFile(const FString& InputFile, const FString& OutputFile, FFileResult& OutResult)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinPipelineProcessCommandlet::ProcessFile);
+
+    TArray<float> Source;
+    int32         SourceChannels   = 0;
+    int32         SourceSampleRate = 0;
+    if (!ReadWav(InputFile, Source, SourceChannels, SourceSampleRate)) {
+        return false;
+    }
+
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+
+    // convert to the pipeline format in frames of the source, like audio arriving from a capture device
+    const int32    NumChannels = bStereo ? 2 : 1;
+    FOdinRemixer   Remixer(SourceChannels, NumChannels);
+    FOdinResampler Resampler(SourceSampleRate, SampleRate, NumChannels);
+    TArray<float>  Converted;
+    Converted.Reserve(static_cast<int32>(static_cast<int64>(Source.Num()) / SourceChannels * NumChannels * SampleRate / SourceSampleRate) + SampleRate);
+    const int32 SourceFrameSamples = SourceSampleRate * OdinPipelineProcess::FrameMs / 1000 * SourceChannels;
+    for (int32 Offset = 0; Offset < Source.Num(); Offset += SourceFrameSamples) {
+        const int32 NumSamples = FMath::Min(SourceFrameSamples, Source.Num() - Offset);
+        OdinPipelineProcess::Timed(OutResult.Convert, [&]() {
+            const TArrayView<const float> Remixed   = Remixer.Process(Source.GetData() + Offset, NumSamples);
+            const TArrayView<const float> Resampled = Resampler.Process(Remixed.GetData(), Remixed.Num() / NumChannels);
+            Converted.Append(Resampled.GetData(), Resampled.Num());
+        });
+    }
+    // the end of the file, the resampler still holds back the last input frames
+    const TArrayView<const float> Tail = Resampler.Flush();
+    Converted.Append(Tail.GetData(), Tail.Num());
+
+    UOdinEncoder* Encoder = UOdinEncoder::ConstructEncoder(GetTransientPackage(), 0, SampleRate, bStereo);
+    UOdinDecoder* Decoder = UOdinDecoder::ConstructDecoder(GetTransientPackage(), SampleRate, bStereo);
+    // both free calls accept null, so either one may have failed
+    ON_SCOPE_EXIT
+    {
+        UOdinEncoder::FreeEncoder(Encoder);
+        UOdinDecoder::FreeDecoder(Decoder);
+    };
+    if (!Encoder || !Decoder || !Decoder->GetNativeHandle()) {
+        ODIN_LOG(Error, "OdinPipelineProcess: could not create encoder or decoder for %s.", *OutResult.Name);
+        return false;
+    }
+
+    UOdinPipeline* EncoderPipeline = Encoder->GetOrCreatePipeline();
+    UOdinPipeline* DecoderPipeline = Decoder->GetOrCreatePipeline();
+    if (!OdinPipelineProcess::ApplyDescriptor(EncoderPipeline, EncoderDescriptor) || !OdinPipelineProcess::ApplyDescriptor(DecoderPipeline, DecoderDescriptor)) {
+        ODIN_LOG(Error, "OdinPipelineProcess: could not apply pipeline descriptors for %s.", *OutResult.Name);
+        return false;
+    }
+    EncoderPipeline->SetEffectTimingEnabled(true);
+    DecoderPipeline->SetEffectTimingEnabled(true);
+
+    // one decoder frame is popped for every encoder frame, so the output stays aligned with the input
+    const int32   FrameSamples = SampleRate * OdinPipelineProcess::FrameMs / 1000 * NumChannels;
+    TArray<float> Processed;
+    Processed.SetNumZeroed((Converted.Num() + FrameSamples - 1) / FrameSamples * FrameSamples);
+    Converted.SetNumZeroed(Processed.Num());
+    TArray<uint8> Datagram;
+    for (int32 Offset = 0; Offset < Converted.Num(); Offset += FrameSamples) {
+        OdinPipelineProcess::Timed(OutResult.EncoderPush, [&]() { Encoder->Push(Converted.GetData() + Offset, FrameSamples); });
+
+        for (;;) {
+            Datagram.SetNumUninitialized(OdinPipelineProcess::MaxDatagramSize);
+            uint32    NumBytes = Datagram.Num();
+            OdinError Result;
+            OdinPipelineProcess::Timed(OutResult.EncoderPop, [&]() {
+                FOdinPopTimingScope PopTiming(Encoder->GetHandle());
+                Result = odin_encoder_pop(Encoder->GetHandle(), Datagram.GetData(), &NumBytes);
+            });
+            if (Result != OdinError::ODIN_ERROR_SUCCESS) {
+                if (Result != OdinError::ODIN_ERROR_NO_DATA) {
+                    FOdinModule::LogErrorCode("Aborting OdinPipelineProcess due to invalid odin_encoder_pop call: %s", Result);
+                }
+                break;
+            }
+            Datagram.SetNum(NumBytes);
+            OdinPipelineProcess::Timed(OutResult.DecoderPush, [&]() { Decoder->Push(Datagram); });
+        }
+
+        bool bIsSilent = false;
+        OdinPipelineProcess::Timed(OutResult.DecoderPop, [&]() { Decoder->Pop(Processed.GetData() + Offset, FrameSamples, &bIsSilent); });
+    }
+
+    OutResult.ProcessSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+    OutResult.AudioSeconds   = static_cast<double>(Source.Num()) / SourceChannels / SourceSampleRate;
+    EncoderPipeline->GetEffectTimingStats(OutResult.EncoderEffects);
+    DecoderPipeline->GetEffectTimingStats(OutResult.DecoderEffects);
+    EncoderPipeline->SetEffectTimingEnabled(false);
+    DecoderPipeline->SetEffectTimingEnabled(false);
+
+    TArray<int16> Pcm;
+    Pcm.SetNumUninitialized(Processed.Num());
+    for (int32 Index = 0; Index < Processed.Num(); ++Index) {
+        Pcm[Index] = static_cast<int16>(FMath::Clamp(Processed[Index], -1.0f, 1.0f) * 32767.0f);
+    }
+    TArray<uint8> Wav;
+    SerializeWaveFile(Wav, reinterpret_cast<const uint8*>(Pcm.GetData()), Pcm.Num() * sizeof(int16), NumChannels, SampleRate);
+    if (!FFileHelper::SaveArrayToFile(Wav, *OutputFile)) {
+        ODIN_LOG(Error, "OdinPipelineProcess: could not write %s.", *OutputFile);
+        return false;
+    }
+    return true;
+}
+
+bool UOdinPipelineProcessCommandlet::ReadWav(const FString& InputFile, TArray<float>& OutSamples, int32& OutNumChannels, int32& OutSampleRate) const
+{
+    TArray<uint8> Data;
+    if (!FFileHelper::LoadFileToArray(Data, *InputFile)) {
+        ODIN_LOG(Error, "OdinPipelineProcess: could not read %s.", *InputFile);
+        return false;
+    }
+
+    FWaveModInfo WaveInfo;
+    FString      ErrorMessage;
+    if (!WaveInfo.ReadWaveInfo(Data.GetData(), Data.Num(), &ErrorMessage)) {
+        ODIN_LOG(Error, "OdinPipelineProcess: %s is no valid WAV file: %s", *InputFile, *ErrorMessage);
+        return false;
+    }
+
+    OutNumChannels           = *WaveInfo.pChannels;
+    OutSampleRate            = *WaveInfo.pSamplesPerSec;
+    const uint16 FormatTag   = *WaveInfo.pFormatTag;
+    const uint16 SampleBits  = *WaveInfo.pBitsPerSample;
+    const bool   bIsPcm16    = FormatTag == OdinPipelineProcess::WaveFormatPcm && SampleBits == 16;
+    const bool   bIsFloat32  = FormatTag == OdinPipelineProcess::WaveFormatFloat && SampleBits == 32;
+    if ((!bIsPcm16 && !bIsFloat32) || OutNumChannels <= 0 || OutSampleRate <= 0) {
+        ODIN_LOG(Error, "OdinPipelineProcess: %s has an unsupported format, expected 16 bit PCM or 32 bit float.", *InputFile);
+        return false;
+    }
+
+    const int32 NumSamples = WaveInfo.SampleDataSize / (SampleBits / 8);
+    OutSamples.SetNumUninitialized(NumSamples - NumSamples % OutNumChannels);
+    if (bIsPcm16) {
+        const int16* Samples = reinterpret_cast<const int16*>(WaveInfo.SampleDataStart);
+        for (int32 Index = 0; Index < OutSamples.Num(); ++Index) {
+            OutSamples[Index] = Samples[Index] / 32768.0f;
+        }
+    } else {
+        FMemory::Memcpy(OutSamples.GetData(), WaveInfo.SampleDataStart, OutSamples.Num() * sizeof(float));
+    }
+    return true;
+}
+
+void UOdinPipelineProcessCommandlet::WriteTimingReport(const FString& ReportFile, const TArray<TUniquePtr<FFileResult>>& Results) const
+{
+    FString Csv = TEXT("File,Stage,Calls,TotalMs,MeanUs,MaxUs,P99Us\n");
+    for (const TUniquePtr<FFileResult>& ResultPtr : Results) {
+        const FFileResult& Result = *ResultPtr;
+        OdinPipelineProcess::AppendRow(Csv, Result.Name, TEXT("Convert"), Result.Convert);
+        OdinPipelineProcess::AppendRow(Csv, Result.Name, TEXT("EncoderPush"), Result.EncoderPush);
+        OdinPipelineProcess::AppendRow(Csv, Result.Name, TEXT("EncoderPop"), Result.EncoderPop);
+        OdinPipelineProcess::AppendRow(Csv, Result.Name, TEXT("DecoderPush"), Result.DecoderPush);
+        OdinPipelineProcess::AppendRow(Csv, Result.Name, TEXT("DecoderPop"), Result.DecoderPop);
+        for (const FOdinEffectTimingStats& Effect : Result.EncoderEffects) {
+            OdinPipelineProcess::AppendRow(Csv, Result.Name, TEXT("Encoder/") + Effect.Name, Effect);
+        }
+        for (const FOdinEffectTimingStats& Effect : Result.DecoderEffects) {
+            OdinPipelineProcess::AppendRow(Csv, Result.Name, TEXT("Decoder/") + Effect.Name, Effect);
+        }
+    }
+
+    if (FFileHelper::SaveStringToFile(Csv, *ReportFile)) {
+        ODIN_LOG(Display, "OdinPipelineProcess: timing written to %s.", *ReportFile);
+    } else {
+        ODIN_LOG(Error, "OdinPipelineProcess: could not write %s.", *ReportFile);
+    }
+}
@@ -0,0 +1,220 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#include "OdinAudio/OdinPipelineTiming.h"
+
+#include "Misc/ScopeRWLock.h"
+
+namespace OdinPipelineTimingRegistry
+{
+    FRWLock& GetLock()
+    {
+        static FRWLock Lock;
+        return Lock;
+    }
+
+    TMap<const OdinPipeline*, FOdinPipelineTimingsRef>& GetEntries()
+    {
+        static TMap<const OdinPipeline*, FOdinPipelineTimingsRef> Entries;
+        return Entries;
+    }
+
+    // lets pop calls skip the lookup entirely while no pipeline is timed
+    std::atomic<int32> NumEntries = 0;
+
+    double ToNanoseconds(uint64 Cycles)
+    { return static_cast<double>(Cycles) * FPlatformTime::GetSecondsPerCycle64() * 1e9; }
+} // namespace OdinPipelineTimingRegistry
+
+FOdinTimingStats::FOdinTimingStats()
+{ Reset(); }
+
+void FOdinTimingStats::Record(uint64 Cycles)
+{
+    const uint64 Nanoseconds = static_cast<uint64>(OdinPipelineTimingRegistry::ToNanoseconds(Cycles));
+
+    NumCalls.fetch_add(1, std::memory_order_relaxed);
+    TotalNs.fetch_add(Nanoseconds, std::memory_order_relaxed);
+    Buckets[BucketIndex(Nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+
+    uint64 Max = MaxNs.load(std::memory_order_relaxed);
+    while (Nanoseconds > Max && !MaxNs.compare_exchange_weak(Max, Nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+void FOdinTimingStats::Reset()
+{
+    NumCalls.store(0, std::memory_order_relaxed);
+    TotalNs.store(0, std::memory_order_relaxed);
+    MaxNs.store(0, std::memory_order_relaxed);
+    for (std::atomic<uint32>& Bucket : Buckets) {
+        Bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+void FOdinTimingStats::Get(FOdinEffectTimingStats& OutStats) const
+{
+    const uint64 Calls = NumCalls.load(std::memory_order_relaxed);
+    const uint64 Max   = MaxNs.load(std::memory_order_relaxed);
+    OutStats.NumCalls  = static_cast<int64>(Calls);
+    OutStats.MeanUs    = Calls > 0 ? static_cast<float>(TotalNs.load(std::memory_order_relaxed) / 1000.0 / Calls) : 0.0f;
+    OutStats.MaxUs     = static_cast<float>(Max / 1000.0);
+    OutStats.P99Us     = 0.0f;
+
+    // buckets might be a few records ahead or behind of the counters while the pipeline is running
+    uint64 NumRecorded = 0;
+    for (const std::atomic<uint32>& Bucket : Buckets) {
+        NumRecorded += Bucket.load(std::memory_order_relaxed);
+    }
+    const uint64 Target     = (NumRecorded * 99 + 99) / 100;
+    uint64       Cumulative = 0;
+    for (int32 Index = 0; Index < NumBuckets && Target > 0; ++Index) {
+        Cumulative += Buckets[Index].load(std::memory_order_relaxed);
+        if (Cumulative >= Target) {
+            OutStats.P99Us = static_cast<float>(FMath::Min(BucketUpperBound(Index), Max) / 1000.0);
+            break;
+        }
+    }
+}
+
+int32 FOdinTimingStats::BucketIndex(uint64 Nanoseconds)
+{
+    if (Nanoseconds < NumSubBuckets) {
+        return static_cast<int32>(Nanoseconds);
+    }
+    const int32 Octave = static_cast<int32>(FMath::FloorLog2_64(Nanoseconds));
+    const int32 Sub    = static_cast<int32>(Nanoseconds >> (Octave - 3)) & (NumSubBuckets - 1);
+    return FMath::Min(NumSubBuckets + (Octave - 3) * NumSubBuckets + Sub, NumBuckets - 1);
+}
+
+uint64 FOdinTimingStats::BucketUpperBound(int32 Index)
+{
+    if (Index < NumSubBuckets) {
+        return Index + 1;
+    }
+    const int32 Octave = (Index - NumSubBuckets) / NumSubBuckets + 3;
+    const int32 Sub    = (Index - NumSubBuckets) % NumSubBuckets;
+    return static_cast<uint64>(NumSubBuckets + Sub + 1) << (Octave - 3);
+}
+
+FOdinPipelineTimings::FOdinPipelineTimings(const FString& InName)
+    : Name(InName)
+{
+#if COUNTERSTRACE_ENABLED
+    PopCounter = MakeUnique<FCountersTrace::FCounterFloat>(*FString::Printf(TEXT("Odin/Pipeline/%s/PopUs"), *Name), TraceCounterDisplayHint_None);
+#endif
+}
+
+FOdinPipelineTimings::~FOdinPipelineTimings() = default;
+
+void FOdinPipelineTimings::RecordPop(uint64 Cycles)
+{
+    PopStats.Record(Cycles);
+#if COUNTERSTRACE_ENABLED
+    PopCounter->Set(OdinPipelineTimingRegistry::ToNanoseconds(Cycles) / 1000.0);
+#endif
+}
+
+void FOdinPipelineTimings::Register(const OdinPipeline* Handle, FOdinPipelineTimings* Timings)
+{
+    if (!Handle || !Timings) {
+        return;
+    }
+    FRWScopeLock Lock(OdinPipelineTimingRegistry::GetLock(), SLT_Write);
+    OdinPipelineTimingRegistry::GetEntries().Add(Handle, Timings);
+    OdinPipelineTimingRegistry::NumEntries.store(OdinPipelineTimingRegistry::GetEntries().Num(), std::memory_order_relaxed);
+}
+
+void FOdinPipelineTimings::Unregister(const OdinPipeline* Handle, const FOdinPipelineTimings* Timings)
+{
+    FOdinPipelineTimingsRef Removed;
+    {
+        FRWScopeLock             Lock(OdinPipelineTimingRegistry::GetLock(), SLT_Write);
+        FOdinPipelineTimingsRef* Entry = OdinPipelineTimingRegistry::GetEntries().Find(Handle);
+        if (!Entry || Entry->GetReference() != Timings) {
+            return;
+        }
+        // release the reference outside of the lock, the timings might be destroyed with it
+        Removed = MoveTemp(*Entry);
+        OdinPipelineTimingRegistry::GetEntries().Remove(Handle);
+        OdinPipelineTimingRegistry::NumEntries.store(OdinPipelineTimingRegistry::GetEntries().Num(), std::memory_order_relaxed);
+    }
+}
+
+FOdinPipelineTimingsRef FOdinPipelineTimings::Find(const OdinPipeline* Handle)
+{
+    if (!Handle || OdinPipelineTimingRegistry::NumEntries.load(std::memory_order_relaxed) == 0) {
+        return FOdinPipelineTimingsRef();
+    }
+    FRWScopeLock                   Lock(OdinPipelineTimingRegistry::GetLock(), SLT_ReadOnly);
+    const FOdinPipelineTimingsRef* Entry = OdinPipelineTimingRegistry::GetEntries().Find(Handle);
+    return Entry ? *Entry : FOdinPipelineTimingsRef();
+}
+
+FOdinEffectTimer::FOdinEffectTimer(FOdinPipelineTimingsRef InTimings, OdinCustomEffectCallback InCallback, const void* InUserData, const FString& InName)
+    : Timings(MoveTemp(InTimings))
+    , Callback(InCallback)
+    , UserData(InUserData)
+    , Name(InName)
+{
+#if COUNTERSTRACE_ENABLED
+    // created before insertion, as the callback may run as soon as the effect is inserted
+    Counter = MakeUnique<FCountersTrace::FCounterFloat>(*FString::Printf(TEXT("Odin/Pipeline/%s/%s/Us"), *Timings->GetName(), *Name), TraceCounterDisplayHint_None);
+#endif
+}
+
+FOdinEffectTimer::~FOdinEffectTimer() = default;
+
+void FOdinEffectTimer::GetStats(FOdinEffectTimingStats& OutStats) const
+{
+    Stats.Get(OutStats);
+    OutStats.EffectId = static_cast<int32>(EffectId);
+    OutStats.Name     = Name;
+}
+
+void FOdinEffectTimer::FFICallback(float* Samples, uint32_t SamplesCount, bool* bIsSilent, const void* InUserData)
+{
+    if (!InUserData)
+        return;
+
+    FOdinEffectTimer* const Timer = const_cast<FOdinEffectTimer*>(static_cast<const FOdinEffectTimer*>(InUserData));
+    if (!Timer->Timings->IsEnabled()) {
+        Timer->Callback(Samples, SamplesCount, bIsSilent, Timer->UserData);
+        return;
+    }
+
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    Timer->Callback(Samples, SamplesCount, bIsSilent, Timer->UserData);
+    const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+
+    Timer->Stats.Record(Cycles);
+#if COUNTERSTRACE_ENABLED
+    Timer->Counter->Set(OdinPipelineTimingRegistry::ToNanoseconds(Cycles) / 1000.0);
+#endif
+}
+
+FOdinPopTimingScope::FOdinPopTimingScope(OdinEncoder* Encoder)
+{
+    if (Encoder && OdinPipelineTimingRegistry::NumEntries.load(std::memory_order_relaxed) > 0) {
+        Timings = FOdinPipelineTimings::Find(odin_encoder_get_pipeline(Encoder));
+    }
+    if (Timings.IsValid()) {
+        StartCycles = FPlatformTime::Cycles64();
+    }
+}
+
+FOdinPopTimingScope::FOdinPopTimingScope(OdinDecoder* Decoder)
+{
+    if (Decoder && OdinPipelineTimingRegistry::NumEntries.load(std::memory_order_relaxed) > 0) {
+        Timings = FOdinPipelineTimings::Find(odin_decoder_get_pipeline(Decoder));
+    }
+    if (Timings.IsValid()) {
+        StartCycles = FPlatformTime::Cycles64();
+    }
+}
+
+FOdinPopTimingScope::~FOdinPopTimingScope()
+{
+    if (Timings.IsValid()) {
+        Timings->RecordPop(FPlatformTime::Cycles64() - StartCycles);
+    }
+}
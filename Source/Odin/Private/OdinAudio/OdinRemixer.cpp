@@ -0,0 +1,177 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#include "OdinAudio/OdinRemixer.h"
+
+#include "Math/VectorRegister.h"
+
+namespace OdinRemixKernels
+{
+    void StereoToMono(const float* InSamples, float* OutSamples, const int32 NumFrames, int32, int32)
+    {
+        const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+
+        int32 Frame = 0;
+        for (; Frame + 4 <= NumFrames; Frame += 4) {
+            const VectorRegister4Float In0   = VectorLoad(InSamples + Frame * 2);
+            const VectorRegister4Float In1   = VectorLoad(InSamples + Frame * 2 + 4);
+            const VectorRegister4Float Left  = VectorShuffle(In0, In1, 0, 2, 0, 2);
+            const VectorRegister4Float Right = VectorShuffle(In0, In1, 1, 3, 1, 3);
+            VectorStore(VectorMultiply(VectorAdd(Left, Right), Half), OutSamples + Frame);
+        }
+        for (; Frame < NumFrames; ++Frame) {
+            OutSamples[Frame] = (InSamples[Frame * 2] + InSamples[Frame * 2 + 1]) * 0.5f;
+        }
+    }
+
+    void QuadToMono(const float* InSamples, float* OutSamples, const int32 NumFrames, int32, int32)
+    {
+        const VectorRegister4Float Quarter = VectorSetFloat1(0.25f);
+
+        int32 Frame = 0;
+        for (; Frame + 4 <= NumFrames; Frame += 4) {
+            const float*               In = InSamples + Frame * 4;
+            const VectorRegister4Float F0 = VectorLoad(In);
+            const VectorRegister4Float F1 = VectorLoad(In + 4);
+            const VectorRegister4Float F2 = VectorLoad(In + 8);
+            const VectorRegister4Float F3 = VectorLoad(In + 12);
+            // Horizontal sums of four frames, one frame per register.
+            const VectorRegister4Float S01 = VectorAdd(VectorShuffle(F0, F1, 0, 1, 0, 1), VectorShuffle(F0, F1, 2, 3, 2, 3));
+            const VectorRegister4Float S23 = VectorAdd(VectorShuffle(F2, F3, 0, 1, 0, 1), VectorShuffle(F2, F3, 2, 3, 2, 3));
+            const VectorRegister4Float Sum = VectorAdd(VectorShuffle(S01, S23, 0, 2, 0, 2), VectorShuffle(S01, S23, 1, 3, 1, 3));
+            VectorStore(VectorMultiply(Sum, Quarter), OutSamples + Frame);
+        }
+        for (; Frame < NumFrames; ++Frame) {
+            const float* In   = InSamples + Frame * 4;
+            OutSamples[Frame] = (In[0] + In[1] + In[2] + In[3]) * 0.25f;
+        }
+    }
+
+    // Averages the five full range channels, the LFE channel is dropped. Channel order is L, R, C, LFE, Ls, Rs.
+    void FivePointOneToMono(const float* InSamples, float* OutSamples, const int32 NumFrames, int32, int32)
+    {
+        constexpr float G = 0.2f;
+        // Two frames span three registers, so the gain pattern repeats every three registers.
+        const VectorRegister4Float G0 = MakeVectorRegisterFloat(G, G, G, 0.0f);
+        const VectorRegister4Float G1 = MakeVectorRegisterFloat(G, G, G, G);
+        const VectorRegister4Float G2 = MakeVectorRegisterFloat(G, 0.0f, G, G);
+
+        auto SumTwoFrames = [&](const float* In) {
+            const VectorRegister4Float P0 = VectorMultiply(VectorLoad(In), G0);
+            const VectorRegister4Float P1 = VectorMultiply(VectorLoad(In + 4), G1);
+            const VectorRegister4Float P2 = VectorMultiply(VectorLoad(In + 8), G2);
+            // Lanes 0 and 1 hold partial sums of the first frame, lanes 2 and 3 those of the second frame.
+            const VectorRegister4Float A = VectorAdd(VectorAdd(VectorShuffle(P0, P2, 0, 1, 0, 1), VectorShuffle(P0, P2, 2, 3, 2, 3)), P1);
+            return VectorAdd(A, VectorSwizzle(A, 1, 0, 3, 2));
+        };
+
+        int32 Frame = 0;
+        for (; Frame + 4 <= NumFrames; Frame += 4) {
+            const float*               In   = InSamples + Frame * 6;
+            const VectorRegister4Float Sum0 = SumTwoFrames(In);
+            const VectorRegister4Float Sum1 = SumTwoFrames(In + 12);
+            VectorStore(VectorShuffle(Sum0, Sum1, 0, 2, 0, 2), OutSamples + Frame);
+        }
+        for (; Frame < NumFrames; ++Frame) {
+            const float* In   = InSamples + Frame * 6;
+            OutSamples[Frame] = (In[0] + In[1] + In[2] + In[4] + In[5]) * G;
+        }
+    }
+
+    void MonoToStereo(const float* InSamples, float* OutSamples, const int32 NumFrames, int32, int32)
+    {
+        int32 Frame = 0;
+        for (; Frame + 4 <= NumFrames; Frame += 4) {
+            const VectorRegister4Float In = VectorLoad(InSamples + Frame);
+            VectorStore(VectorSwizzle(In, 0, 0, 1, 1), OutSamples + Frame * 2);
+            VectorStore(VectorSwizzle(In, 2, 2, 3, 3), OutSamples + Frame * 2 + 4);
+        }
+        for (; Frame < NumFrames; ++Frame) {
+            OutSamples[Frame * 2]     = InSamples[Frame];
+            OutSamples[Frame * 2 + 1] = InSamples[Frame];
+        }
+    }
+
+    // Upmixing repeats the input channels, downmixing averages all input channels folding onto the same output channel.
+    void Generic(const float* InSamples, float* OutSamples, const int32 NumFrames, const int32 NumInputChannels, const int32 NumOutputChannels)
+    {
+        if (NumOutputChannels >= NumInputChannels) {
+            for (int32 Frame = 0; Frame < NumFrames; ++Frame) {
+                const float* In  = InSamples + Frame * NumInputChannels;
+                float*       Out = OutSamples + Frame * NumOutputChannels;
+                for (int32 Channel = 0; Channel < NumOutputChannels; ++Channel) {
+                    Out[Channel] = In[Channel % NumInputChannels];
+                }
+            }
+            return;
+        }
+
+        for (int32 Frame = 0; Frame < NumFrames; ++Frame) {
+            const float* In  = InSamples + Frame * NumInputChannels;
+            float*       Out = OutSamples + Frame * NumOutputChannels;
+            for (int32 Channel = 0; Channel < NumOutputChannels; ++Channel) {
+                float Sum   = 0.0f;
+                int32 Count = 0;
+                for (int32 Source = Channel; Source < NumInputChannels; Source += NumOutputChannels) {
+                    Sum += In[Source];
+                    ++Count;
+                }
+                Out[Channel] = Sum / Count;
+            }
+        }
+    }
+
+    void Copy(const float* InSamples, float* OutSamples, const int32 NumFrames, const int32 NumInputChannels, int32)
+    { FMemory::Memcpy(OutSamples, InSamples, sizeof(float) * NumFrames * NumInputChannels); }
+} // namespace OdinRemixKernels
+
+FOdinRemixer::FOdinRemixer(const int32 InNumInputChannels, const int32 InNumOutputChannels)
+{ Init(InNumInputChannels, InNumOutputChannels); }
+
+void FOdinRemixer::Init(const int32 InNumInputChannels, const int32 InNumOutputChannels)
+{
+    NumInputChannels  = FMath::Max(1, InNumInputChannels);
+    NumOutputChannels = FMath::Max(1, InNumOutputChannels);
+    Kernel            = SelectKernel(NumInputChannels, NumOutputChannels);
+}
+
+FOdinRemixer::FRemixKernel FOdinRemixer::SelectKernel(const int32 InNumInputChannels, const int32 InNumOutputChannels)
+{
+    if (InNumInputChannels == InNumOutputChannels) {
+        return &OdinRemixKernels::Copy;
+    }
+    if (InNumOutputChannels == 1) {
+        switch (InNumInputChannels) {
+            case 2:
+                return &OdinRemixKernels::StereoToMono;
+            case 4:
+                return &OdinRemixKernels::QuadToMono;
+            case 6:
+                return &OdinRemixKernels::FivePointOneToMono;
+            default:
+                break;
+        }
+    }
+    if (InNumInputChannels == 1 && InNumOutputChannels == 2) {
+        return &OdinRemixKernels::MonoToStereo;
+    }
+    return &OdinRemixKernels::Generic;
+}
+
+TArrayView<const float> FOdinRemixer::Process(const float* InSamples, const int32 NumInputSamples)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FOdinRemixer::Process);
+    if (IsPassthrough()) {
+        return TArrayView<const float>(InSamples, NumInputSamples);
+    }
+
+    const int32 NumFrames        = NumInputSamples / NumInputChannels;
+    const int32 NumOutputSamples = NumFrames * NumOutputChannels;
+    if (Scratch.Num() < NumOutputSamples) {
+        Scratch.SetNumUninitialized(NumOutputSamples);
+    }
+    Kernel(InSamples, Scratch.GetData(), NumFrames, NumInputChannels, NumOutputChannels);
+    return TArrayView<const float>(Scratch.GetData(), NumOutputSamples);
+}
+
+void FOdinRemixer::Process(const float* InSamples, const int32 NumFrames, float* OutSamples) const
+{ Kernel(InSamples, OutSamples, NumFrames, NumInputChannels, NumOutputChannels); }
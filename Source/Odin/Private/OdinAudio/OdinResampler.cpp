@@ -0,0 +1,219 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#include "OdinAudio/OdinResampler.h"
+
+#include "Math/VectorRegister.h"
+
+namespace OdinResamplerKernels
+{
+    // side lobes of the window about 85 dB down, reached past the transition band
+    constexpr double KaiserBeta = 8.6;
+    // passband edge relative to the Nyquist frequency of the lower rate
+    constexpr double CutoffRatio = 0.9;
+
+    // zeroth order modified Bessel function of the first kind
+    double BesselI0(const double X)
+    {
+        double Sum  = 1.0;
+        double Term = 1.0;
+        for (int32 K = 1; K < 32; ++K) {
+            const double Half = X / (2.0 * K);
+            Term *= Half * Half;
+            Sum += Term;
+            if (Term < Sum * 1e-12) {
+                break;
+            }
+        }
+        return Sum;
+    }
+
+    float DotProduct(const float* Samples, const float* Coefficients, const int32 NumTaps)
+    {
+        VectorRegister4Float Sum = VectorZeroFloat();
+        for (int32 Tap = 0; Tap < NumTaps; Tap += 4) {
+            Sum = VectorMultiplyAdd(VectorLoad(Samples + Tap), VectorLoad(Coefficients + Tap), Sum);
+        }
+        alignas(16) float Lanes[4];
+        VectorStoreAligned(Sum, Lanes);
+        return (Lanes[0] + Lanes[1]) + (Lanes[2] + Lanes[3]);
+    }
+} // namespace OdinResamplerKernels
+
+FOdinResampler::FOdinResampler(int32 InInputSampleRate, int32 InOutputSampleRate, int32 InNumChannels, int32 InNumTaps)
+{ Init(InInputSampleRate, InOutputSampleRate, InNumChannels, InNumTaps); }
+
+void FOdinResampler::Init(int32 InInputSampleRate, int32 InOutputSampleRate, int32 InNumChannels, int32 InNumTaps)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FOdinResampler::Init);
+
+    InputSampleRate  = FMath::Max(InInputSampleRate, 1);
+    OutputSampleRate = FMath::Max(InOutputSampleRate, 1);
+    NumChannels      = FMath::Max(InNumChannels, 1);
+    Step             = static_cast<double>(InputSampleRate) / OutputSampleRate;
+
+    // the cutoff shrinks by the ratio when downsampling, the filter has to grow by it to keep the same transition band
+    const int32 TapScale = Step > 1.0 ? FMath::CeilToInt(Step) : 1;
+    NumTaps              = FMath::Max(Align(InNumTaps * TapScale, 4), 4);
+
+    // exact phases for rational ratios, i.e. the reduced output rate
+    const int32 Divisor = FMath::GreatestCommonDivisor(InputSampleRate, OutputSampleRate);
+    NumPhases           = FMath::Min(OutputSampleRate / Divisor, MaxPhases);
+
+    // normalized cutoff relative to the input rate, below the Nyquist frequency of the lower of both rates, i.e. scaled
+    // by OutputSampleRate / InputSampleRate when downsampling
+    const double Cutoff     = 0.5 * OdinResamplerKernels::CutoffRatio * FMath::Min(1.0, 1.0 / Step);
+    const double HalfLength = NumTaps / 2.0;
+    const double WindowNorm = OdinResamplerKernels::BesselI0(OdinResamplerKernels::KaiserBeta);
+
+    Coefficients.SetNumUninitialized((NumPhases + 1) * NumTaps);
+    for (int32 Phase = 0; Phase <= NumPhases; ++Phase) {
+        // the output lies Fraction frames behind the center tap NumTaps / 2 - 1
+        const double Fraction = static_cast<double>(Phase) / NumPhases;
+        float*       Filter   = Coefficients.GetData() + Phase * NumTaps;
+        double       Sum      = 0.0;
+        for (int32 Tap = 0; Tap < NumTaps; ++Tap) {
+            const double X      = Tap - (HalfLength - 1.0) - Fraction;
+            const double Sinc   = FMath::IsNearlyZero(X) ? 1.0 : FMath::Sin(UE_DOUBLE_PI * 2.0 * Cutoff * X) / (UE_DOUBLE_PI * 2.0 * Cutoff * X);
+            const double Ratio  = FMath::Clamp(X / HalfLength, -1.0, 1.0);
+            const double Window = OdinResamplerKernels::BesselI0(OdinResamplerKernels::KaiserBeta * FMath::Sqrt(1.0 - Ratio * Ratio)) / WindowNorm;
+            const double Value  = Sinc * Window;
+            Filter[Tap]         = static_cast<float>(Value);
+            Sum += Value;
+        }
+        // unity gain at DC for every phase
+        for (int32 Tap = 0; Tap < NumTaps; ++Tap) {
+            Filter[Tap] = static_cast<float>(Filter[Tap] / Sum);
+        }
+    }
+
+    Work.SetNum(NumChannels);
+    Reset();
+}
+
+void FOdinResampler::Reset()
+{
+    for (Audio::FAlignedFloatBuffer& Channel : Work) {
+        Channel.Reset();
+        Channel.AddZeroed(NumTaps - 1);
+    }
+    NextIndex    = 0;
+    NextFraction = 0.0;
+}
+
+int32 FOdinResampler::GetMaxOutputFrames(int32 NumInputFrames) const
+{
+    if (IsPassthrough()) {
+        return NumInputFrames;
+    }
+    return static_cast<int32>(FMath::CeilToDouble((NumInputFrames + 1) / Step)) + 1;
+}
+
+int32 FOdinResampler::Process(const float* InSamples, int32 NumInputFrames, float* OutSamples, int32 MaxOutputFrames)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FOdinResampler::Process);
+
+    if (NumInputFrames <= 0) {
+        return 0;
+    }
+    if (IsPassthrough()) {
+        const int32 NumFrames = FMath::Min(NumInputFrames, MaxOutputFrames);
+        FMemory::Memcpy(OutSamples, InSamples, NumFrames * NumChannels * sizeof(float));
+        return NumFrames;
+    }
+
+    // deinterleave behind the history, so every sub-filter reads contiguous samples
+    PrepareWork(NumInputFrames);
+    for (int32 Channel = 0; Channel < NumChannels; ++Channel) {
+        float* Dest = Work[Channel].GetData() + NumTaps - 1;
+        for (int32 Frame = 0; Frame < NumInputFrames; ++Frame) {
+            Dest[Frame] = InSamples[Frame * NumChannels + Channel];
+        }
+    }
+    return FilterWork(NumInputFrames, OutSamples, MaxOutputFrames);
+}
+
+void FOdinResampler::PrepareWork(int32 NumInputFrames)
+{
+    const int32 NumWork = NumTaps - 1 + NumInputFrames;
+    for (Audio::FAlignedFloatBuffer& ChannelWork : Work) {
+        // keep a multiple of 4 beyond the end readable for the last dot product
+        if (ChannelWork.Num() < NumWork + 4) {
+            ChannelWork.SetNumZeroed(NumWork + 4);
+        }
+    }
+}
+
+int32 FOdinResampler::FilterWork(int32 NumInputFrames, float* OutSamples, int32 MaxOutputFrames)
+{
+    const int32 NumHistory      = NumTaps - 1;
+    const int32 NumWork         = NumHistory + NumInputFrames;
+    int32       NumOutputFrames = 0;
+    while (NextIndex + NumTaps <= NumWork && NumOutputFrames < MaxOutputFrames) {
+        const int32  Phase  = static_cast<int32>(NextFraction * NumPhases + 0.5);
+        const float* Filter = Coefficients.GetData() + Phase * NumTaps;
+        float*       Out    = OutSamples + NumOutputFrames * NumChannels;
+        for (int32 Channel = 0; Channel < NumChannels; ++Channel) {
+            Out[Channel] = OdinResamplerKernels::DotProduct(Work[Channel].GetData() + NextIndex, Filter, NumTaps);
+        }
+        ++NumOutputFrames;
+
+        NextFraction += Step;
+        const int32 Advance = static_cast<int32>(NextFraction);
+        NextIndex += Advance;
+        NextFraction -= Advance;
+    }
+
+    // move the tail of this block to the front as history for the next one
+    const int32 NumConsumed = NumWork - NumHistory;
+    for (int32 Channel = 0; Channel < NumChannels; ++Channel) {
+        float* Data = Work[Channel].GetData();
+        FMemory::Memmove(Data, Data + NumConsumed, NumHistory * sizeof(float));
+    }
+    NextIndex -= NumConsumed;
+    return NumOutputFrames;
+}
+
+TArrayView<const float> FOdinResampler::Process(const float* InSamples, int32 NumInputFrames)
+{
+    if (IsPassthrough()) {
+        return TArrayView<const float>(InSamples, NumInputFrames * NumChannels);
+    }
+
+    const int32 MaxOutputFrames = GetMaxOutputFrames(NumInputFrames);
+    if (Scratch.Num() < MaxOutputFrames * NumChannels) {
+        Scratch.SetNumUninitialized(MaxOutputFrames * NumChannels);
+    }
+    const int32 NumOutputFrames = Process(InSamples, NumInputFrames, Scratch.GetData(), MaxOutputFrames);
+    return TArrayView<const float>(Scratch.GetData(), NumOutputFrames * NumChannels);
+}
+
+int32 FOdinResampler::Flush(float* OutSamples, int32 MaxOutputFrames)
+{
+    if (IsPassthrough()) {
+        return 0;
+    }
+
+    // the output lags the input by half the filter, silence moves the last input frames past the center tap
+    const int32 NumTailFrames = GetLatencyFrames();
+    PrepareWork(NumTailFrames);
+    for (Audio::FAlignedFloatBuffer& ChannelWork : Work) {
+        FMemory::Memzero(ChannelWork.GetData() + NumTaps - 1, NumTailFrames * sizeof(float));
+    }
+    const int32 NumOutputFrames = FilterWork(NumTailFrames, OutSamples, MaxOutputFrames);
+    Reset();
+    return NumOutputFrames;
+}
+
+TArrayView<const float> FOdinResampler::Flush()
+{
+    if (IsPassthrough()) {
+        return TArrayView<const float>();
+    }
+
+    const int32 MaxOutputFrames = GetMaxOutputFrames(GetLatencyFrames());
+    if (Scratch.Num() < MaxOutputFrames * NumChannels) {
+        Scratch.SetNumUninitialized(MaxOutputFrames * NumChannels);
+    }
+    const int32 NumOutputFrames = Flush(Scratch.GetData(), MaxOutputFrames);
+    return TArrayView<const float>(Scratch.GetData(), NumOutputFrames * NumChannels);
+}
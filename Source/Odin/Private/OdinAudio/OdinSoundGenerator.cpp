@@ -6,6 +6,8 @@
 #include "OdinVoice.h"
 #include "Components/SynthComponent.h"
 #include "OdinAudio/OdinDecoder.h"
+#include "OdinAudio/OdinAudioTap.h"
+#include "OdinAudio/OdinPipelineTiming.h"
 #include "OdinCore/include/odin.h"
 
 FOdinSoundGenerator::FOdinSoundGenerator()
@@ -21,6 +23,7 @@ void FOdinSoundGenerator::ResetConnectedDecoder()
     OdinDecoderHandle.Reset();
     FScopeLock HandleAccess(&NativeHandleAccessSection);
     NativeDecoderHandle = nullptr;
+    DecoderState.Reset();
 }
 
 void FOdinSoundGenerator::SetOdinDecoder(UOdinDecoder* InDecoder)
@@ -32,6 +35,7 @@ void FOdinSoundGenerator::SetOdinDecoder(UOdinDecoder* InDecoder)
         if (OdinDecoderHandle.IsValid()) {
             FScopeLock HandleAccess(&NativeHandleAccessSection);
             NativeDecoderHandle = reinterpret_cast<OdinDecoder*>(OdinDecoderHandle->GetHandle());
+            DecoderState        = InDecoder->GetState();
         } else {
             ODIN_LOG(Error, "Native Decoder Handle given in SetOdinDecoder is invalid, Generator won't be able to generate Audio.")
         }
@@ -62,7 +66,13 @@ int32 FOdinSoundGenerator::OnGenerateAudio(float* OutAudio, int32 NumSamples)
         TRACE_CPUPROFILER_EVENT_SCOPE(OdinSoundGenerator::OnGenerateAudio - odin_decoder_pop)
 
         FScopeLock HandleAccess(&NativeHandleAccessSection);
-        Result = odin_decoder_pop(NativeDecoderHandle, OutAudio, NumSamples, &bIsSilence);
+        {
+            FOdinPopTimingScope PopTiming(NativeDecoderHandle);
+            Result = odin_decoder_pop(NativeDecoderHandle, OutAudio, NumSamples, &bIsSilence);
+        }
+        if (DecoderState.IsValid()) {
+            DecoderState->RecordPop(Result, bIsSilence, NumSamples, SampleRate, ChannelCount);
+        }
         ODIN_LOG(VeryVerbose, "odin_decoder_pop called,  Result: %d, IsSilence %s", static_cast<int32>(Result), bIsSilence ? TEXT("True") : TEXT("False"));
     }
 
@@ -89,6 +99,15 @@ int32 FOdinSoundGenerator::OnGenerateAudio(float* OutAudio, int32 NumSamples)
         return NumSamples;
     }
 
+    if (NumGeneratedSamples > 0) {
+        TRACE_CPUPROFILER_EVENT_SCOPE(FOdinSoundGenerator::OnGenerateAudio - AudioTap Write);
+        // Only contended while taps are added or removed, writing into a tap itself never blocks.
+        FScopeLock Lock(&CriticalSectionAudioTaps);
+        for (const TSharedPtr<FOdinAudioTap, ESPMode::ThreadSafe>& AudioTap : AudioTaps) {
+            AudioTap->Write(OutAudio, NumGeneratedSamples, ChannelCount, SampleRate);
+        }
+    }
+
     if (NumGeneratedSamples > 0) {
         TRACE_CPUPROFILER_EVENT_SCOPE(FOdinSoundGenerator::OnGenerateAudio - AudioBufferListener Broadcast);
         FScopeLock Lock(&CriticalSectionAudioBufferListeners);
@@ -126,8 +145,31 @@ void FOdinSoundGenerator::RemoveAudioBufferListener(const TWeakPtr<IAudioBufferL
     AudioBufferListeners.Remove(InAudioBufferListener);
 }
 
+void FOdinSoundGenerator::AddAudioTap(const TSharedPtr<FOdinAudioTap, ESPMode::ThreadSafe>& InAudioTap)
+{
+    if (InAudioTap.IsValid()) {
+        FScopeLock Lock(&CriticalSectionAudioTaps);
+        AudioTaps.AddUnique(InAudioTap);
+    }
+}
+
+void FOdinSoundGenerator::RemoveAudioTap(const TSharedPtr<FOdinAudioTap, ESPMode::ThreadSafe>& InAudioTap)
+{
+    FScopeLock Lock(&CriticalSectionAudioTaps);
+    AudioTaps.Remove(InAudioTap);
+}
+
+void FOdinSoundGenerator::SetNumFramesPerCallback(const int32 InNumFrames)
+{ NumFramesPerCallback = FMath::Max(0, InNumFrames); }
+
+float FOdinSoundGenerator::GetPlaybackQuantumMs() const
+{ return SampleRate > 0 ? 1000.0f * GetDesiredNumSamplesToRenderPerCallback() / (SampleRate * ChannelCount) : 0.0f; }
+
 int32 FOdinSoundGenerator::GetDesiredNumSamplesToRenderPerCallback() const
 {
+    if (const int32 NumFrames = NumFramesPerCallback.load(); NumFrames > 0) {
+        return NumFrames * ChannelCount;
+    }
     constexpr int MS = 20;
     return SampleRate / 1000 * MS * ChannelCount;
 }
\ No newline at end of file
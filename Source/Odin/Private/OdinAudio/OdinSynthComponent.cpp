@@ -5,6 +5,7 @@
 #include "OdinVoice.h"
 #include "OdinAudio/OdinDecoder.h"
 #include "OdinAudio/OdinSoundGenerator.h"
+#include "OdinAudio/OdinAudioTap.h"
 #include "Async/Async.h"
 
 UOdinSynthComponent::UOdinSynthComponent(const FObjectInitializer& ObjectInitializer)
@@ -16,6 +17,12 @@ UOdinSynthComponent::UOdinSynthComponent(const FObjectInitializer& ObjectInitial
 bool UOdinSynthComponent::Init(int32& SampleRate)
 {
     if (Decoder) {
+        BindDecoderFormatChanged();
+        if (Decoder->bFollowAudioDeviceFormat) {
+            // Let the decoder resample once to the mixer rate instead of having the engine resample its output again.
+            TGuardValue<bool> MatchingFormatGuard(bIsMatchingDecoderFormat, true);
+            Decoder->MatchAudioDeviceFormat(this);
+        }
         NumChannels = Decoder->bStereo ? 2 : 1;
         SampleRate  = Decoder->SampleRate;
     } else {
@@ -40,7 +47,11 @@ ISoundGeneratorPtr UOdinSynthComponent::CreateSoundGenerator(const FSoundGenerat
     if (!OdinSoundGeneratorPtr.IsValid()) {
         OdinSoundGeneratorPtr = MakeShared<FOdinSoundGenerator, ESPMode::ThreadSafe>();
         CurrentAudioDeviceId.Set(InParams.AudioDeviceID);
+        for (const TSharedPtr<FOdinAudioTap, ESPMode::ThreadSafe>& AudioTap : AudioTaps) {
+            OdinSoundGeneratorPtr->AddAudioTap(AudioTap);
+        }
     }
+    OdinSoundGeneratorPtr->SetNumFramesPerCallback(bLowLatencyPlayback ? InParams.AudioMixerNumOutputFrames : 0);
     if (Decoder && OdinSoundGeneratorPtr.IsValid()) {
         OdinSoundGeneratorPtr->SetOdinDecoder(Decoder);
     } else {
@@ -52,6 +63,29 @@ ISoundGeneratorPtr UOdinSynthComponent::CreateSoundGenerator(const FSoundGenerat
 UOdinDecoder* UOdinSynthComponent::GetDecoder() const
 { return Decoder; }
 
+void UOdinSynthComponent::AddAudioTap(const TSharedPtr<FOdinAudioTap, ESPMode::ThreadSafe>& AudioTap)
+{
+    if (!AudioTap.IsValid()) {
+        return;
+    }
+    AudioTap->Start();
+    AudioTaps.AddUnique(AudioTap);
+    if (OdinSoundGeneratorPtr.IsValid()) {
+        OdinSoundGeneratorPtr->AddAudioTap(AudioTap);
+    }
+}
+
+void UOdinSynthComponent::RemoveAudioTap(const TSharedPtr<FOdinAudioTap, ESPMode::ThreadSafe>& AudioTap)
+{
+    AudioTaps.Remove(AudioTap);
+    if (OdinSoundGeneratorPtr.IsValid()) {
+        OdinSoundGeneratorPtr->RemoveAudioTap(AudioTap);
+    }
+}
+
+float UOdinSynthComponent::GetPlaybackQuantumMs() const
+{ return OdinSoundGeneratorPtr.IsValid() ? OdinSoundGeneratorPtr->GetPlaybackQuantumMs() : 0.0f; }
+
 UAudioComponent* UOdinSynthComponent::GetConnectedAudioComponent()
 { return GetAudioComponent(); }
 
@@ -61,6 +95,7 @@ void UOdinSynthComponent::SetDecoder(UOdinDecoder* InDecoder)
 
     if (InDecoder != Decoder) {
         Decoder = InDecoder;
+        BindDecoderFormatChanged();
 
         if (OdinSoundGeneratorPtr.IsValid()) {
             OdinSoundGeneratorPtr->SetOdinDecoder(Decoder);
@@ -94,8 +129,40 @@ void UOdinSynthComponent::BeginPlay()
     ODIN_LOG(Verbose, "%s", ANSI_TO_TCHAR(__FUNCTION__));
 }
 
+void UOdinSynthComponent::BindDecoderFormatChanged()
+{
+    if (FormatChangedBoundDecoder.Get() == Decoder) {
+        return;
+    }
+    if (FormatChangedBoundDecoder.IsValid()) {
+        FormatChangedBoundDecoder->OnFormatChangedNative.Remove(DecoderFormatChangedHandle);
+    }
+    DecoderFormatChangedHandle.Reset();
+    FormatChangedBoundDecoder = Decoder;
+    if (Decoder) {
+        DecoderFormatChangedHandle = Decoder->OnFormatChangedNative.AddUObject(this, &UOdinSynthComponent::HandleDecoderFormatChanged);
+    }
+}
+
+void UOdinSynthComponent::HandleDecoderFormatChanged(UOdinDecoder* ChangedDecoder)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinSynthComponent::HandleDecoderFormatChanged);
+    if (ChangedDecoder != Decoder) {
+        return;
+    }
+    // The generator caches the native handle, which is freed right after this event.
+    CloseSoundGenerator();
+    if (!bIsMatchingDecoderFormat && IsActive()) {
+        ODIN_LOG(Verbose, "UOdinSynthComponent: Restarting after decoder format changed to %d Hz.", ChangedDecoder->SampleRate);
+        RestartSynthComponent();
+    }
+}
+
 void UOdinSynthComponent::BeginDestroy()
 {
+    if (FormatChangedBoundDecoder.IsValid()) {
+        FormatChangedBoundDecoder->OnFormatChangedNative.Remove(DecoderFormatChangedHandle);
+    }
     CloseSoundGenerator();
     Super::BeginDestroy();
     ODIN_LOG(Verbose, "ODIN Destroy: %s", ANSI_TO_TCHAR(__FUNCTION__));
@@ -3,6 +3,7 @@
 #include "OdinRoom.h"
 #include "Async/TaskGraphInterfaces.h"
 #include "OdinAudio/OdinEncoder.h"
+#include "OdinAudio/OdinPipelineTiming.h"
 #include "OdinNative/OdinNativeBlueprint.h"
 #include "OdinNative/OdinNativeRpc.h"
 #include "OdinNative/OdinUtils.h"
@@ -196,6 +197,7 @@ bool UOdinRoom::SendAudio(UOdinEncoder *encoder)
             OdinError ret;
             {
                 TRACE_CPUPROFILER_EVENT_SCOPE(odin_encoder_pop);
+                FOdinPopTimingScope PopTiming(encoder->GetHandle());
                 ret = odin_encoder_pop(encoder->GetHandle(), bytes.GetData(), &length);
             }
             switch (ret) {
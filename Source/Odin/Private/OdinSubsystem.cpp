@@ -6,6 +6,10 @@
 #include "OdinRoom.h"
 #include "OdinVoice.h"
 #include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "AudioDevice.h"
+#include "AudioMixerDevice.h"
+#include "Async/Async.h"
 
 UOdinSubsystem* UOdinSubsystem::Get()
 { return GEngine ? GEngine->GetEngineSubsystem<UOdinSubsystem>() : nullptr; }
@@ -18,18 +22,47 @@ bool UOdinSubsystem::GlobalIsRoomValid(const OdinRoom* Handle)
     return false;
 }
 
+bool UOdinSubsystem::GetAudioDeviceFormat(const UObject* WorldContextObject, int32& OutSampleRate, int32& OutNumChannels)
+{
+    FAudioDeviceHandle AudioDevice;
+    if (const UWorld* World = GEngine && WorldContextObject
+                                  ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull)
+                                  : nullptr) {
+        AudioDevice = World->GetAudioDevice();
+    }
+    if (!AudioDevice.IsValid()) {
+        if (FAudioDeviceManager* AudioDeviceManager = FAudioDevice::GetAudioDeviceManager()) {
+            AudioDevice = AudioDeviceManager->GetActiveAudioDevice();
+        }
+    }
+    if (!AudioDevice.IsValid()) {
+        return false;
+    }
+
+    OutSampleRate  = FMath::RoundToInt(AudioDevice->GetSampleRate());
+    OutNumChannels = 2;
+    if (AudioDevice->IsAudioMixerEnabled()) {
+        const Audio::FMixerDevice* MixerDevice = static_cast<const Audio::FMixerDevice*>(AudioDevice.GetAudioDevice());
+        OutNumChannels                         = MixerDevice->GetNumDeviceChannels();
+    }
+    return OutSampleRate > 0;
+}
+
 void UOdinSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
     Super::Initialize(Collection);
     ODIN_LOG(Log, "Initialize Odin Registration Subsystem");
-    PushDataThread           = MakeUnique<FOdinAudioPushDataThread>();
+    PushDataThread           = MakeShared<FOdinAudioPushDataThread, ESPMode::ThreadSafe>();
     DatagramProcessingThread = MakeUnique<FOdinDatagramProcessingThread>();
+
+    AudioDeviceCreatedCallbackHandle = FAudioDeviceManagerDelegates::OnAudioDeviceCreated.AddUObject(this, &UOdinSubsystem::OnAudioDeviceCreated);
 }
 
 void UOdinSubsystem::Deinitialize()
 {
     Super::Deinitialize();
     ODIN_LOG(Log, "Deinitialize Odin Registration Subsystem");
+    FAudioDeviceManagerDelegates::OnAudioDeviceCreated.Remove(AudioDeviceCreatedCallbackHandle);
     if (PushDataThread.IsValid()) {
         PushDataThread->Exit();
         PushDataThread.Reset();
@@ -77,10 +110,27 @@ void UOdinSubsystem::UnlinkEncoder(OdinEncoder* Encoder)
     }
 }
 
-void UOdinSubsystem::PushAudioToEncoder(OdinEncoder* Encoder, TArray<float>&& Audio)
+void UOdinSubsystem::PushAudioToEncoder(OdinEncoder* Encoder, TArray<float>&& Audio, const FOdinAudioBufferPoolPtr& ReturnPool)
+{
+    if (PushDataThread.IsValid()) {
+        PushDataThread->PushAudioToEncoder(Encoder, MoveTemp(Audio), FOdinCaptureBlockInfo(), ReturnPool);
+    }
+}
+
+bool UOdinSubsystem::SwapEncoderHandle(OdinEncoder* OldHandle, OdinEncoder* NewHandle)
 {
     if (PushDataThread.IsValid()) {
-        PushDataThread->PushAudioToEncoder(Encoder, MoveTemp(Audio));
+        return PushDataThread->SwapEncoder(OldHandle, NewHandle);
+    }
+    return false;
+}
+
+void UOdinSubsystem::RetireEncoderHandle(OdinEncoder* Handle)
+{
+    if (PushDataThread.IsValid()) {
+        PushDataThread->RetireEncoder(Handle);
+    } else if (Handle) {
+        odin_encoder_free(Handle);
     }
 }
 
@@ -159,7 +209,7 @@ bool UOdinSubsystem::IsRoomRegistered(const OdinRoom* Handle) const
 void UOdinSubsystem::LinkDecoderToPeer(const UOdinDecoder* Decoder, OdinRoom* TargetRoom, const uint32 PeerId)
 {
     if (DatagramProcessingThread.IsValid() && IsValid(Decoder)) {
-        DatagramProcessingThread->LinkDecoderToPeer(Decoder->GetNativeHandle(), TargetRoom, PeerId);
+        DatagramProcessingThread->LinkDecoderToPeer(Decoder->GetNativeHandle(), TargetRoom, PeerId, Decoder->GetState());
     }
 }
 
@@ -210,6 +260,56 @@ void UOdinSubsystem::DeregisterDecoder(const OdinDecoder* Handle)
     }
 }
 
+void UOdinSubsystem::SwapDecoderHandle(OdinDecoder* OldHandle, OdinDecoder* NewHandle)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinSubsystem::SwapDecoderHandle);
+
+    if (DatagramProcessingThread.IsValid()) {
+        DatagramProcessingThread->SwapDecoderHandle(OldHandle, NewHandle);
+    }
+    {
+        FScopeLock                   DecoderObjectLock(&DecoderObjectsCS);
+        TWeakObjectPtr<UOdinDecoder> DecoderObject;
+        if (DecoderObjects.RemoveAndCopyValue(OldHandle, DecoderObject)) {
+            ODIN_LOG(Verbose, "Swap Odin Decoder handle %p with handle %p", OldHandle, NewHandle);
+            DecoderObjects.Add(NewHandle, DecoderObject);
+        }
+    }
+}
+
+void UOdinSubsystem::RetireDecoderHandle(OdinDecoder* Handle)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UOdinSubsystem::RetireDecoderHandle);
+
+    if (DatagramProcessingThread.IsValid()) {
+        DatagramProcessingThread->RetireDecoderHandle(Handle);
+    } else if (Handle) {
+        odin_decoder_free(Handle);
+    }
+}
+
+void UOdinSubsystem::OnAudioDeviceCreated(Audio::FDeviceId Id)
+{
+    TWeakObjectPtr<UOdinSubsystem> WeakThis = this;
+    // Decoders are UObjects and may only be recreated on the game thread.
+    AsyncTask(ENamedThreads::GameThread, [WeakThis, Id]() {
+        if (!WeakThis.IsValid()) {
+            return;
+        }
+        TArray<TWeakObjectPtr<UOdinDecoder>> Decoders;
+        {
+            FScopeLock DecoderObjectsLock(&WeakThis->DecoderObjectsCS);
+            WeakThis->DecoderObjects.GenerateValueArray(Decoders);
+        }
+        ODIN_LOG(Verbose, "Audio Device Created with id %u, checking %d decoders for format changes.", Id, Decoders.Num());
+        for (const TWeakObjectPtr<UOdinDecoder>& Decoder : Decoders) {
+            if (Decoder.IsValid() && Decoder->bFollowAudioDeviceFormat) {
+                Decoder->MatchAudioDeviceFormat(Decoder.Get());
+            }
+        }
+    });
+}
+
 TArray<OdinDecoder*> UOdinSubsystem::GetDecoderHandlesFor(OdinRoom* TargetRoom, uint32 PeerId) const
 {
     if (DatagramProcessingThread.IsValid()) {
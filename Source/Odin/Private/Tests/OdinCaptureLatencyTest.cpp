@@ -0,0 +1,116 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "OdinAudio/OdinAudioCapture.h"
+#include "OdinAudio/OdinAudioPushDataThread.h"
+#include "OdinAudio/OdinEncoder.h"
+#include "OdinCore/include/odin.h"
+#include "OdinLatencyTestHelpers.h"
+
+namespace OdinCaptureLatencyTest
+{
+    using namespace OdinLatencyTest;
+
+    constexpr int32  SampleRate      = 48000;
+    constexpr int32  FrameSamples    = SampleRate / 50;
+    constexpr int32  MaxDatagramSize = 1300;
+    constexpr int32  NumFrames       = 50;
+    constexpr double TimeoutSeconds  = 5.0;
+
+    /**
+     * Streams a continuous tone in real time into the capture sink of an encoder, in blocks of the device buffer size for
+     * the given latency like UOdinAudioCapture delivers them. The sink queues the blocks for the push thread, which moves
+     * them into the encoder on its own cadence, and the datagrams are popped as soon as the encoder completed them.
+     * @param Latency capture latency setting, converted to the device buffer size like OpenCaptureStream does
+     * @param OutSummary receives the time of every 20 ms frame from capturing its middle sample until its datagram was popped
+     * @return true if NumFrames datagrams were popped before the timeout
+     */
+    bool MeasureLatency(EOdinCaptureLatency Latency, FLatencySummary& OutSummary)
+    {
+        OdinEncoder* Encoder = nullptr;
+        if (odin_encoder_create(0, SampleRate, false, &Encoder) != OdinError::ODIN_ERROR_SUCCESS) {
+            return false;
+        }
+
+        // no room to send to, the datagrams are popped here instead
+        TSharedPtr<FOdinAudioPushDataThread, ESPMode::ThreadSafe> PushDataThread = MakeShared<FOdinAudioPushDataThread, ESPMode::ThreadSafe>();
+        PushDataThread->LinkEncoderWithoutRoom(Encoder);
+        FOdinEncoderCaptureSink Sink(PushDataThread, 1);
+        Sink.SetEncoderHandle(Encoder);
+        Sink.PrepareCapture(1, SampleRate);
+
+        const int32   BufferFrames = UOdinAudioCapture::GetNumFramesForLatency(SampleRate, Latency);
+        TArray<float> Block;
+        Block.SetNumUninitialized(BufferFrames);
+        TArray<uint8> Datagram;
+        Datagram.SetNumUninitialized(MaxDatagramSize);
+
+        const double StartTime         = FPlatformTime::Seconds();
+        int32        NumCapturedBlocks = 0;
+        int32        NumDatagrams      = 0;
+        while (NumDatagrams < NumFrames && FPlatformTime::Seconds() - StartTime < TimeoutSeconds) {
+            // the device hands out a block once its last frame was captured
+            const double Now = FPlatformTime::Seconds();
+            while ((NumCapturedBlocks + 1) * BufferFrames <= (Now - StartTime) * SampleRate) {
+                for (int32 Index = 0; Index < BufferFrames; ++Index) {
+                    Block[Index] = ToneSample(NumCapturedBlocks * BufferFrames + Index, SampleRate, 440.0f, 0.25f);
+                }
+                FOdinCaptureBlockInfo BlockInfo;
+                BlockInfo.StreamTime  = static_cast<double>(NumCapturedBlocks) * BufferFrames / SampleRate;
+                BlockInfo.ReceiveTime = Now;
+                Sink.OnCapturedAudio(Block.GetData(), BufferFrames, 1, SampleRate, BlockInfo);
+                ++NumCapturedBlocks;
+            }
+
+            // the tone is continuous, so every 20 ms frame is encoded into exactly one datagram
+            for (;;) {
+                uint32 NumBytes = Datagram.Num();
+                if (odin_encoder_pop(Encoder, Datagram.GetData(), &NumBytes) != OdinError::ODIN_ERROR_SUCCESS) {
+                    break;
+                }
+                const double CaptureTime = StartTime + (NumDatagrams + 0.5) * FrameSamples / SampleRate;
+                OutSummary.Add((FPlatformTime::Seconds() - CaptureTime) * 1000.0);
+                ++NumDatagrams;
+            }
+            FPlatformProcess::SleepNoStats(0.0005f);
+        }
+
+        PushDataThread->UnlinkEncoder(Encoder);
+        PushDataThread->Exit();
+        odin_encoder_free(Encoder);
+        return NumDatagrams >= NumFrames;
+    }
+} // namespace OdinCaptureLatencyTest
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOdinCaptureLatencyTest, "Odin.Audio.CaptureLatency",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FOdinCaptureLatencyTest::RunTest(const FString& Parameters)
+{
+    using namespace OdinCaptureLatencyTest;
+
+    const EOdinCaptureLatency Latencies[] = {EOdinCaptureLatency::Latency_5ms, EOdinCaptureLatency::Latency_10ms, EOdinCaptureLatency::Latency_20ms};
+
+    TestEqual(TEXT("Frames for 10 ms at 48 kHz"), UOdinAudioCapture::GetNumFramesForLatency(48000, EOdinCaptureLatency::Latency_10ms), 480);
+    TestEqual(TEXT("Frames for 20 ms at 44.1 kHz"), UOdinAudioCapture::GetNumFramesForLatency(44100, EOdinCaptureLatency::Latency_20ms), 882);
+
+    // the push thread wakes independently of the simulated device, so the frames sweep all phases between both
+    FLatencySummary Summaries[UE_ARRAY_COUNT(Latencies)];
+    for (int32 LatencyIndex = 0; LatencyIndex < UE_ARRAY_COUNT(Latencies); ++LatencyIndex) {
+        const int32 LatencyMs = static_cast<int32>(Latencies[LatencyIndex]);
+        if (!TestTrue(FString::Printf(TEXT("Frames encoded with %d ms capture latency"), LatencyMs), MeasureLatency(Latencies[LatencyIndex], Summaries[LatencyIndex]))) {
+            return false;
+        }
+        AddInfo(FString::Printf(TEXT("Capture to encoder latency with %d ms capture buffers: %s"), LatencyMs, *Summaries[LatencyIndex].ToString()));
+    }
+
+    TestTrue(TEXT("Smaller capture buffers reduce the capture to encoder latency"), Summaries[0].GetMeanMs() <= Summaries[2].GetMeanMs());
+    return true;
+}
+
+#endif
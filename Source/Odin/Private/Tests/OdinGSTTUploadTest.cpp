@@ -0,0 +1,169 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && ODIN_WITH_HTTP_SERVER_TESTS
+
+#include "HttpPath.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "OdinAudio/Effects/OdinNativeEffectChain.h"
+#include "OdinAudio/Effects/OdinRestGSTTEffect.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace OdinGSTTUploadTest
+{
+    constexpr uint32 FirstPort      = 18470;
+    constexpr uint32 NumPorts       = 16;
+    constexpr int32  SampleRate     = 48000;
+    constexpr int32  FrameSamples   = SampleRate / 50;
+    constexpr int32  ResampleRate   = 16000;
+    constexpr int32  NumUtterances  = 3;
+    constexpr int32  FramesPerTick  = 10;
+    constexpr double TimeoutSeconds = 10.0;
+
+    struct FReceivedSegment {
+        int32 Index      = INDEX_NONE;
+        int32 NumSamples = 0;
+    };
+
+    struct FState {
+        TStrongObjectPtr<UOdinRestGSTTEffect> Effect;
+        FOdinNativeEffectChainRef             Chain;
+        TSharedPtr<IHttpRouter>               Router;
+        FHttpRouteHandle                      RouteHandle;
+        uint32                                Port = 0;
+        // the stand-in endpoint is ticked on the game thread like the latent commands
+        TArray<FReceivedSegment> Received;
+        TArray<bool>             Schedule;
+        int32                    NextFrame = 0;
+        double                   StartTime = 0.0;
+    };
+
+    /**
+     * Activity of every 20 ms frame: leading silence for the pre-roll, then utterances of growing length, each followed by
+     * more silence than the hangover, so every utterance becomes one segment.
+     */
+    TArray<bool> BuildSchedule()
+    {
+        TArray<bool> Schedule;
+        Schedule.Init(false, 20);
+        for (int32 Utterance = 0; Utterance < NumUtterances; ++Utterance) {
+            for (int32 Frame = 0; Frame < (Utterance + 1) * 10; ++Frame) {
+                Schedule.Add(true);
+            }
+            Schedule.AddZeroed(50);
+        }
+        return Schedule;
+    }
+
+    /**
+     * @return samples at the upload rate expected for an utterance: 200 ms pre-roll, the utterance and 600 ms hangover
+     */
+    int32 ExpectedSegmentSamples(int32 Utterance)
+    { return (200 + (Utterance + 1) * 200 + 600) * ResampleRate / 1000; }
+
+    bool HandleUpload(const TSharedRef<FState>& State, const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+    {
+        FReceivedSegment Segment;
+        for (const TPair<FString, TArray<FString>>& Header : Request.Headers) {
+            if (Header.Key.Equals(TEXT("X-Odin-Segment"), ESearchCase::IgnoreCase) && Header.Value.Num() > 0) {
+                Segment.Index = FCString::Atoi(*Header.Value[0]);
+            }
+        }
+        // 16 bit mono WAV with a 44 byte header
+        Segment.NumSamples = FMath::Max(Request.Body.Num() - 44, 0) / 2;
+        State->Received.Add(Segment);
+        OnComplete(FHttpServerResponse::Create(FString::Printf(TEXT("segment %d"), Segment.Index), TEXT("text/plain")));
+        return true;
+    }
+} // namespace OdinGSTTUploadTest
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOdinGSTTUploadTest, "Odin.Effects.GSTTUpload", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOdinGSTTUploadTest::RunTest(const FString& Parameters)
+{
+    using namespace OdinGSTTUploadTest;
+
+    // with listeners enabled, a router is only returned once its listener is actually bound, so a taken port moves on to the next
+    TSharedRef<FState> State = MakeShared<FState>();
+    FHttpServerModule::Get().StartAllListeners();
+    for (uint32 Port = FirstPort; Port < FirstPort + NumPorts && !State->Router.IsValid(); ++Port) {
+        State->Router = FHttpServerModule::Get().GetHttpRouter(Port, true);
+        State->Port   = Port;
+    }
+    if (!State->Router.IsValid()) {
+        AddWarning(FString::Printf(TEXT("Could not bind the HTTP stand-in to any port from %u to %u, skipping."), FirstPort, FirstPort + NumPorts - 1));
+        return true;
+    }
+    auto Handler = [State](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) { return HandleUpload(State, Request, OnComplete); };
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 4
+    State->RouteHandle = State->Router->BindRoute(FHttpPath(TEXT("/odin-gstt-test")), EHttpServerRequestVerbs::VERB_POST, FHttpRequestHandler::CreateLambda(Handler));
+#else
+    State->RouteHandle = State->Router->BindRoute(FHttpPath(TEXT("/odin-gstt-test")), EHttpServerRequestVerbs::VERB_POST, FHttpRequestHandler(Handler));
+#endif
+
+    // hosted in a chain, the effect runs without a pipeline or room
+    State->Effect.Reset(NewObject<UOdinRestGSTTEffect>());
+    State->Effect->SampleRate        = SampleRate;
+    State->Effect->ResampleRate      = ResampleRate;
+    State->Effect->UploadEndpoint    = FString::Printf(TEXT("http://127.0.0.1:%u/odin-gstt-test"), State->Port);
+    State->Effect->MaxPendingUploads = NumUtterances;
+    State->Chain                     = new FOdinNativeEffectChain();
+    if (!TestTrue(TEXT("Effect hosted in the chain"), State->Chain->InsertCustomEffect(INDEX_NONE, State->Effect.Get()).IsValid())) {
+        State->Router->UnbindRoute(State->RouteHandle);
+        return false;
+    }
+    TestFalse(TEXT("Streaming does not start before the first frame"), State->Effect->IsStreaming());
+
+    State->Schedule  = BuildSchedule();
+    State->StartTime = FPlatformTime::Seconds();
+
+    // feeds the frames in bursts, the first frame starts the streamer lazily
+    ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([State]() {
+        TArray<float> Frame;
+        Frame.SetNumUninitialized(FrameSamples);
+        for (int32 Burst = 0; Burst < FramesPerTick && State->NextFrame < State->Schedule.Num(); ++Burst, ++State->NextFrame) {
+            const bool bIsActive = State->Schedule[State->NextFrame];
+            for (int32 Index = 0; Index < FrameSamples; ++Index) {
+                const int32 Position = State->NextFrame * FrameSamples + Index;
+                Frame[Index]         = bIsActive ? 0.3f * FMath::Sin(2.0f * PI * 300.0f * Position / SampleRate) : 0.0f;
+            }
+            bool bIsSilent = !bIsActive;
+            State->Chain->Process(Frame.GetData(), FrameSamples, bIsSilent);
+        }
+        return State->NextFrame >= State->Schedule.Num();
+    }));
+
+    ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State]() {
+        if (State->Received.Num() < NumUtterances && FPlatformTime::Seconds() - State->StartTime < TimeoutSeconds) {
+            return false;
+        }
+
+        TestTrue(TEXT("Streaming started with the first processed frame"), State->Effect->IsStreaming());
+        TestEqual(TEXT("Every utterance was delivered as one segment"), State->Received.Num(), NumUtterances);
+        TestEqual(TEXT("No segment was dropped"), State->Effect->GetStreamingStats().NumDroppedSegments, static_cast<int64>(0));
+
+        // uploads may overtake each other, the segment header restores the order
+        State->Received.Sort([](const FReceivedSegment& A, const FReceivedSegment& B) { return A.Index < B.Index; });
+        const int32 Tolerance = 2 * ResampleRate / 50;
+        for (int32 Utterance = 0; Utterance < State->Received.Num(); ++Utterance) {
+            const FReceivedSegment& Segment = State->Received[Utterance];
+            TestEqual(FString::Printf(TEXT("Segment %d carries its index"), Utterance), Segment.Index, Utterance);
+            AddInfo(FString::Printf(TEXT("Segment %d: %d samples, expected %d"), Segment.Index, Segment.NumSamples, ExpectedSegmentSamples(Utterance)));
+            TestTrue(FString::Printf(TEXT("Segment %d holds its utterance"), Utterance),
+                     FMath::Abs(Segment.NumSamples - ExpectedSegmentSamples(Utterance)) <= Tolerance);
+        }
+
+        State->Router->UnbindRoute(State->RouteHandle);
+        State->Chain.SafeRelease();
+        State->Effect.Reset();
+        return true;
+    }));
+    return true;
+}
+
+#endif
@@ -0,0 +1,44 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace OdinLatencyTest
+{
+    /**
+     * Outcome of a single latency measurement.
+     */
+    struct FLatencyResult {
+        bool   bDetected = false;
+        double LatencyMs = 0.0;
+    };
+
+    /**
+     * Mean and maximum of the measurements of one configuration.
+     */
+    struct FLatencySummary {
+        int32  NumResults = 0;
+        double SumMs      = 0.0;
+        double MaxMs      = 0.0;
+
+        void Add(double LatencyMs)
+        {
+            ++NumResults;
+            SumMs += LatencyMs;
+            MaxMs = FMath::Max(MaxMs, LatencyMs);
+        }
+
+        double GetMeanMs() const
+        { return NumResults > 0 ? SumMs / NumResults : 0.0; }
+
+        FString ToString() const
+        { return FString::Printf(TEXT("mean %.2f ms, max %.2f ms over %d measurements"), GetMeanMs(), MaxMs, NumResults); }
+    };
+
+    /**
+     * @return sample of a sine tone at the given position of the stream
+     */
+    inline float ToneSample(int32 Position, int32 SampleRate, float Frequency, float Amplitude)
+    { return Amplitude * FMath::Sin(2.0f * PI * Frequency * Position / SampleRate); }
+} // namespace OdinLatencyTest
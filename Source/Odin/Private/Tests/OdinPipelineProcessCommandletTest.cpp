@@ -0,0 +1,130 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Audio.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "OdinAudio/OdinPipelineProcessCommandlet.h"
+
+namespace OdinPipelineProcessCommandletTest
+{
+    constexpr int32 OutputSampleRate = 48000;
+
+    struct FCorpusFile {
+        const TCHAR* Name;
+        int32        SampleRate;
+        int32        NumChannels;
+        float        Seconds;
+    };
+
+    // mono and stereo at the pipeline rate and at rates the commandlet has to resample, the subfolder repeats a file name
+    // with different content, so its output and report row must not collide with the one at the root
+    const FCorpusFile Corpus[] = {
+        {TEXT("tone_48k_mono.wav"), 48000, 1, 1.0f},
+        {TEXT("tone_44k_stereo.wav"), 44100, 2, 0.5f},
+        {TEXT("tone_16k_mono.wav"), 16000, 1, 0.75f},
+        {TEXT("Sub/tone_48k_mono.wav"), 16000, 2, 0.25f},
+    };
+
+    /**
+     * Writes a 16 bit PCM WAV with a 440 Hz tone, every channel a little louder than the previous one.
+     */
+    bool WriteToneWav(const FString& Path, const FCorpusFile& File)
+    {
+        const int32   NumFrames = static_cast<int32>(File.SampleRate * File.Seconds);
+        TArray<int16> Pcm;
+        Pcm.SetNumUninitialized(NumFrames * File.NumChannels);
+        for (int32 Frame = 0; Frame < NumFrames; ++Frame) {
+            const float Sample = FMath::Sin(2.0f * PI * 440.0f * Frame / File.SampleRate);
+            for (int32 Channel = 0; Channel < File.NumChannels; ++Channel) {
+                Pcm[Frame * File.NumChannels + Channel] = static_cast<int16>(Sample * (0.2f + 0.1f * Channel) * 32767.0f);
+            }
+        }
+        TArray<uint8> Wav;
+        SerializeWaveFile(Wav, reinterpret_cast<const uint8*>(Pcm.GetData()), Pcm.Num() * sizeof(int16), File.NumChannels, File.SampleRate);
+        return FFileHelper::SaveArrayToFile(Wav, *Path);
+    }
+
+    /**
+     * @return frames of a WAV file, INDEX_NONE if it could not be read
+     */
+    int32 ReadNumFrames(const FString& Path, int32& OutSampleRate)
+    {
+        TArray<uint8> Data;
+        FWaveModInfo  WaveInfo;
+        if (!FFileHelper::LoadFileToArray(Data, *Path) || !WaveInfo.ReadWaveInfo(Data.GetData(), Data.Num())) {
+            return INDEX_NONE;
+        }
+        OutSampleRate = *WaveInfo.pSamplesPerSec;
+        return WaveInfo.SampleDataSize / (*WaveInfo.pBitsPerSample / 8) / *WaveInfo.pChannels;
+    }
+
+    int32 RunCommandlet(const FString& Input, const FString& Output)
+    {
+        UOdinPipelineProcessCommandlet* Commandlet = NewObject<UOdinPipelineProcessCommandlet>();
+        return Commandlet->Main(FString::Printf(TEXT("-Input=\"%s\" -Output=\"%s\" -SampleRate=%d"), *Input, *Output, OutputSampleRate));
+    }
+} // namespace OdinPipelineProcessCommandletTest
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOdinPipelineProcessCommandletTest, "Odin.Audio.PipelineProcessCommandlet",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOdinPipelineProcessCommandletTest::RunTest(const FString& Parameters)
+{
+    using namespace OdinPipelineProcessCommandletTest;
+
+    const FString Root   = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("OdinPipelineProcess"));
+    const FString Input  = FPaths::Combine(Root, TEXT("Input"));
+    const FString Output = FPaths::Combine(Root, TEXT("Output"));
+    IFileManager::Get().DeleteDirectory(*Root, false, true);
+    IFileManager::Get().MakeDirectory(*Input, true);
+
+    for (const FCorpusFile& File : Corpus) {
+        const FString Path = FPaths::Combine(Input, File.Name);
+        IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+        if (!TestTrue(FString::Printf(TEXT("Corpus file %s written"), File.Name), WriteToneWav(Path, File))) {
+            return false;
+        }
+    }
+
+    TestEqual(TEXT("Commandlet succeeds on a valid corpus"), RunCommandlet(Input, Output), 0);
+
+    for (const FCorpusFile& File : Corpus) {
+        int32       SampleRate = 0;
+        const int32 NumFrames  = ReadNumFrames(FPaths::Combine(Output, File.Name), SampleRate);
+        // the output is padded to whole 20 ms frames, so it is never shorter than the input
+        const int32 MinFrames = static_cast<int32>(OutputSampleRate * File.Seconds);
+        AddInfo(FString::Printf(TEXT("%s: %d frames at %d Hz, input %.2f s"), File.Name, NumFrames, SampleRate, File.Seconds));
+        TestEqual(FString::Printf(TEXT("%s written at the pipeline rate"), File.Name), SampleRate, OutputSampleRate);
+        TestTrue(FString::Printf(TEXT("%s covers the whole input"), File.Name), NumFrames >= MinFrames && NumFrames <= MinFrames + OutputSampleRate / 25);
+    }
+
+    // every row starts on a new line after the header, so a file at the root does not match the row of its namesake in a subfolder
+    FString Csv;
+    TestTrue(TEXT("Timing report written"), FFileHelper::LoadFileToString(Csv, *FPaths::Combine(Output, TEXT("OdinPipelineTiming.csv"))));
+    for (const FCorpusFile& File : Corpus) {
+        TestTrue(FString::Printf(TEXT("Timing report lists %s"), File.Name), Csv.Contains(FString::Printf(TEXT("\n%s,EncoderPush,"), File.Name)));
+    }
+
+    // a broken file fails the run, but the other files are still processed and reported
+    const TCHAR* BrokenName = TEXT("broken.wav");
+    FFileHelper::SaveStringToFile(TEXT("not a wave file"), *FPaths::Combine(Input, BrokenName));
+    AddExpectedError(TEXT("is no valid WAV file"), EAutomationExpectedErrorFlags::Contains, 1);
+    TestEqual(TEXT("Commandlet fails on a corpus with a broken file"), RunCommandlet(Input, Output), 1);
+
+    Csv.Reset();
+    FFileHelper::LoadFileToString(Csv, *FPaths::Combine(Output, TEXT("OdinPipelineTiming.csv")));
+    TestFalse(TEXT("Timing report skips the broken file"), Csv.Contains(BrokenName));
+    for (const FCorpusFile& File : Corpus) {
+        TestTrue(FString::Printf(TEXT("Timing report still lists %s"), File.Name), Csv.Contains(FString::Printf(TEXT("\n%s,EncoderPush,"), File.Name)));
+    }
+
+    IFileManager::Get().DeleteDirectory(*Root, false, true);
+    return true;
+}
+
+#endif
@@ -0,0 +1,149 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "OdinAudio/OdinDecoder.h"
+#include "OdinAudio/OdinSoundGenerator.h"
+#include "OdinCore/include/odin.h"
+#include "OdinLatencyTestHelpers.h"
+#include "UObject/Package.h"
+
+namespace OdinPlaybackLatencyTest
+{
+    using namespace OdinLatencyTest;
+
+    constexpr int32 SampleRate      = 48000;
+    constexpr int32 FrameSamples    = SampleRate / 50;
+    constexpr int32 MixerFrames     = 256;
+    constexpr int32 NumFrames       = 50;
+    constexpr int32 OnsetFrame      = 25;
+    constexpr int32 MaxDatagramSize = 1300;
+    constexpr float OnsetThreshold  = 0.05f;
+
+    /**
+     * Encodes a tone burst starting at the beginning of OnsetFrame into datagrams, one array per 20 ms frame.
+     */
+    bool EncodeBurst(TArray<TArray<TArray<uint8>>>& OutFrames)
+    {
+        OdinEncoder* Encoder = nullptr;
+        if (odin_encoder_create(0, SampleRate, false, &Encoder) != OdinError::ODIN_ERROR_SUCCESS) {
+            return false;
+        }
+
+        TArray<float> Samples;
+        Samples.SetNumUninitialized(FrameSamples);
+        OutFrames.SetNum(NumFrames);
+        for (int32 Frame = 0; Frame < NumFrames; ++Frame) {
+            for (int32 Index = 0; Index < FrameSamples; ++Index) {
+                const int32 Position = Frame * FrameSamples + Index;
+                Samples[Index]       = Frame >= OnsetFrame ? ToneSample(Position, SampleRate, 1000.0f, 0.5f) : 0.0f;
+            }
+            odin_encoder_push(Encoder, Samples.GetData(), Samples.Num());
+
+            for (;;) {
+                TArray<uint8> Datagram;
+                Datagram.SetNumUninitialized(MaxDatagramSize);
+                uint32 NumBytes = Datagram.Num();
+                if (odin_encoder_pop(Encoder, Datagram.GetData(), &NumBytes) != OdinError::ODIN_ERROR_SUCCESS) {
+                    break;
+                }
+                Datagram.SetNum(NumBytes);
+                OutFrames[Frame].Add(MoveTemp(Datagram));
+            }
+        }
+        odin_encoder_free(Encoder);
+        return true;
+    }
+
+    /**
+     * Plays the datagrams through a sound generator driven like the audio mixer does: every MixerFrames a callback consumes
+     * one mixer buffer, the generator wrapper renders blocks of the desired size whenever its buffer runs short. The
+     * datagram of every frame arrives once the frame is complete, shifted by the given phase against the mixer clock.
+     * @return time from the arrival of the first datagram containing the burst until its first sample is rendered
+     */
+    FLatencyResult MeasureLatency(const TArray<TArray<TArray<uint8>>>& Frames, bool bLowLatency, double PhaseMs)
+    {
+        FLatencyResult Result;
+        UOdinDecoder*  Decoder = UOdinDecoder::ConstructDecoder(GetTransientPackage(), SampleRate, false);
+        if (!Decoder || !Decoder->GetNativeHandle()) {
+            return Result;
+        }
+
+        FOdinSoundGenerator Generator;
+        Generator.SetOdinDecoder(Decoder);
+        Generator.SetNumFramesPerCallback(bLowLatency ? MixerFrames : 0);
+        const int32 DesiredSamples = Generator.GetDesiredNumSamplesToRenderPerCallback();
+
+        const double  OnsetArrival = (OnsetFrame + 1) * FrameSamples / static_cast<double>(SampleRate) + PhaseMs / 1000.0;
+        TArray<float> WrapperBuffer;
+        TArray<float> Block;
+        Block.SetNumUninitialized(DesiredSamples);
+        int32 NextFrame = 0;
+
+        const int32 NumCallbacks = (NumFrames + 10) * FrameSamples / MixerFrames;
+        for (int32 Callback = 0; Callback < NumCallbacks && !Result.bDetected; ++Callback) {
+            const double CallbackTime = Callback * MixerFrames / static_cast<double>(SampleRate);
+            while (NextFrame < Frames.Num() && (NextFrame + 1) * FrameSamples / static_cast<double>(SampleRate) + PhaseMs / 1000.0 <= CallbackTime) {
+                for (const TArray<uint8>& Datagram : Frames[NextFrame]) {
+                    Decoder->Push(Datagram);
+                }
+                ++NextFrame;
+            }
+
+            while (WrapperBuffer.Num() < MixerFrames) {
+                Generator.OnGenerateAudio(Block.GetData(), DesiredSamples);
+                WrapperBuffer.Append(Block);
+            }
+            for (int32 Index = 0; Index < MixerFrames; ++Index) {
+                if (CallbackTime >= OnsetArrival && FMath::Abs(WrapperBuffer[Index]) > OnsetThreshold) {
+                    Result.bDetected = true;
+                    Result.LatencyMs = (CallbackTime + Index / static_cast<double>(SampleRate) - OnsetArrival) * 1000.0;
+                    break;
+                }
+            }
+            WrapperBuffer.RemoveAt(0, MixerFrames);
+        }
+
+        Generator.Close();
+        UOdinDecoder::FreeDecoder(Decoder);
+        return Result;
+    }
+} // namespace OdinPlaybackLatencyTest
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOdinPlaybackLatencyTest, "Odin.Audio.PlaybackLatency",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FOdinPlaybackLatencyTest::RunTest(const FString& Parameters)
+{
+    using namespace OdinPlaybackLatencyTest;
+
+    TArray<TArray<TArray<uint8>>> Frames;
+    if (!TestTrue(TEXT("Encoded the tone burst"), EncodeBurst(Frames))) {
+        return false;
+    }
+
+    // the phase between network arrivals and mixer callbacks decides how long a datagram waits, so it is swept
+    constexpr int32 NumPhases = 8;
+    FLatencySummary Summaries[2];
+    for (int32 Mode = 0; Mode < 2; ++Mode) {
+        for (int32 Phase = 0; Phase < NumPhases; ++Phase) {
+            const double         PhaseMs = 20.0 * Phase / NumPhases;
+            const FLatencyResult Result  = MeasureLatency(Frames, Mode == 1, PhaseMs);
+            if (!TestTrue(FString::Printf(TEXT("Burst rendered (%s, phase %.1f ms)"), Mode == 1 ? TEXT("low latency") : TEXT("20 ms"), PhaseMs),
+                          Result.bDetected)) {
+                return false;
+            }
+            Summaries[Mode].Add(Result.LatencyMs);
+        }
+        AddInfo(FString::Printf(TEXT("Receive to speaker latency with %s playback quantum: %s"),
+                                Mode == 1 ? *FString::Printf(TEXT("%d frame"), MixerFrames) : TEXT("20 ms"), *Summaries[Mode].ToString()));
+    }
+
+    const double ToleranceMs = 1000.0 * MixerFrames / SampleRate;
+    TestTrue(TEXT("Low latency playback does not add latency"), Summaries[1].GetMeanMs() <= Summaries[0].GetMeanMs() + ToleranceMs);
+    return true;
+}
+
+#endif
@@ -0,0 +1,198 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/PlatformTime.h"
+#include "OdinAudio/OdinResampler.h"
+
+namespace OdinResamplerTest
+{
+    constexpr float ToneFrequency = 1000.0f;
+    constexpr float ToneAmplitude = 0.5f;
+    constexpr int32 NumIterations = 2000;
+
+    struct FConversion {
+        int32 InputSampleRate;
+        int32 OutputSampleRate;
+        int32 NumChannels;
+        // highest accepted THD+N, ratios without exact phases are limited by the phase quantization
+        double MaxThdNDb;
+    };
+
+    const FConversion Conversions[] = {
+        {48000, 16000, 1, -85.0}, {16000, 48000, 1, -85.0}, {44100, 48000, 2, -85.0}, {48000, 44100, 1, -85.0}, {22050, 48000, 1, -60.0},
+    };
+
+    /**
+     * @return one second of an interleaved sine with the same phase on every channel
+     */
+    TArray<float> MakeTone(int32 SampleRate, int32 NumChannels, float Frequency)
+    {
+        TArray<float> Tone;
+        Tone.SetNumUninitialized(SampleRate * NumChannels);
+        for (int32 Frame = 0; Frame < SampleRate; ++Frame) {
+            const float Sample = ToneAmplitude * static_cast<float>(FMath::Sin(2.0 * UE_DOUBLE_PI * Frequency * Frame / SampleRate));
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel) {
+                Tone[Frame * NumChannels + Channel] = Sample;
+            }
+        }
+        return Tone;
+    }
+
+    /**
+     * Converts the input in 20 ms blocks like a stream and flushes the filter at the end.
+     */
+    TArray<float> Convert(FOdinResampler& Resampler, const TArray<float>& Input)
+    {
+        const int32   NumChannels = Resampler.GetNumChannels();
+        const int32   BlockFrames = Resampler.GetInputSampleRate() / 50;
+        const int32   NumFrames   = Input.Num() / NumChannels;
+        TArray<float> Output;
+        for (int32 Frame = 0; Frame < NumFrames; Frame += BlockFrames) {
+            const TArrayView<const float> Block = Resampler.Process(Input.GetData() + Frame * NumChannels, FMath::Min(BlockFrames, NumFrames - Frame));
+            Output.Append(Block.GetData(), Block.Num());
+        }
+        const TArrayView<const float> Tail = Resampler.Flush();
+        Output.Append(Tail.GetData(), Tail.Num());
+        return Output;
+    }
+
+    /**
+     * @return first output frame past the startup of the filter
+     */
+    int32 GetSettledFrames(const FOdinResampler& Resampler)
+    {
+        return FMath::CeilToInt(static_cast<double>(Resampler.GetNumTaps()) * Resampler.GetOutputSampleRate() / Resampler.GetInputSampleRate()) + 1;
+    }
+
+    /**
+     * Fits the tone to one channel past the filter startup and tail. The analyzed range covers whole 20 ms windows, so
+     * the tone spans whole periods and sine, cosine and mean are orthogonal.
+     * @return energy of everything but the tone relative to the tone in dB
+     */
+    double MeasureThdN(const TArray<float>& Output, int32 NumChannels, int32 Channel, int32 SampleRate, int32 SettledFrames)
+    {
+        const int32 NumFrames = Output.Num() / NumChannels;
+        const int32 Window    = SampleRate / 50;
+        const int32 NumUsed   = (NumFrames - 2 * SettledFrames) / Window * Window;
+        if (NumUsed <= 0) {
+            return 0.0;
+        }
+
+        double Mean = 0.0;
+        for (int32 Frame = SettledFrames; Frame < SettledFrames + NumUsed; ++Frame) {
+            Mean += Output[Frame * NumChannels + Channel];
+        }
+        Mean /= NumUsed;
+
+        double SinSum = 0.0;
+        double CosSum = 0.0;
+        for (int32 Frame = SettledFrames; Frame < SettledFrames + NumUsed; ++Frame) {
+            const double Phase  = 2.0 * UE_DOUBLE_PI * ToneFrequency * Frame / SampleRate;
+            const double Sample = Output[Frame * NumChannels + Channel] - Mean;
+            SinSum += Sample * FMath::Sin(Phase);
+            CosSum += Sample * FMath::Cos(Phase);
+        }
+        const double SinGain = 2.0 * SinSum / NumUsed;
+        const double CosGain = 2.0 * CosSum / NumUsed;
+
+        double ToneEnergy     = 0.0;
+        double ResidualEnergy = 0.0;
+        for (int32 Frame = SettledFrames; Frame < SettledFrames + NumUsed; ++Frame) {
+            const double Phase = 2.0 * UE_DOUBLE_PI * ToneFrequency * Frame / SampleRate;
+            const double Tone  = SinGain * FMath::Sin(Phase) + CosGain * FMath::Cos(Phase);
+            const double Error = Output[Frame * NumChannels + Channel] - Mean - Tone;
+            ToneEnergy += Tone * Tone;
+            ResidualEnergy += Error * Error;
+        }
+        return 10.0 * FMath::LogX(10.0, FMath::Max(ResidualEnergy, 1e-30) / FMath::Max(ToneEnergy, 1e-30));
+    }
+
+    /**
+     * @return level of the settled output relative to the input tone in dB
+     */
+    double MeasureLevelDb(const TArray<float>& Output, int32 NumChannels, int32 SettledFrames)
+    {
+        const int32 NumFrames = Output.Num() / NumChannels;
+        double      Energy    = 0.0;
+        int32       NumUsed   = 0;
+        for (int32 Frame = SettledFrames; Frame < NumFrames - SettledFrames; ++Frame, ++NumUsed) {
+            Energy += FMath::Square(static_cast<double>(Output[Frame * NumChannels]));
+        }
+        const double InputEnergy = 0.5 * ToneAmplitude * ToneAmplitude;
+        return NumUsed > 0 ? 10.0 * FMath::LogX(10.0, FMath::Max(Energy / NumUsed, 1e-30) / InputEnergy) : 0.0;
+    }
+} // namespace OdinResamplerTest
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOdinResamplerQualityTest, "Odin.Audio.ResamplerQuality", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOdinResamplerQualityTest::RunTest(const FString& Parameters)
+{
+    using namespace OdinResamplerTest;
+
+    for (const FConversion& Conversion : Conversions) {
+        const FString  Name = FString::Printf(TEXT("%d Hz to %d Hz, %d channels"), Conversion.InputSampleRate, Conversion.OutputSampleRate, Conversion.NumChannels);
+        FOdinResampler Resampler(Conversion.InputSampleRate, Conversion.OutputSampleRate, Conversion.NumChannels);
+        const int32    SettledFrames = GetSettledFrames(Resampler);
+
+        const TArray<float> Input  = MakeTone(Conversion.InputSampleRate, Conversion.NumChannels, ToneFrequency);
+        const TArray<float> Output = Convert(Resampler, Input);
+
+        // with the flushed tail, every input frame reaches the output, shifted by the filter latency
+        const int32 NumOutputFrames   = Output.Num() / Conversion.NumChannels;
+        const int32 NumExpectedFrames = Conversion.OutputSampleRate;
+        TestTrue(Name + TEXT(": flushed output covers the whole input"),
+                 NumOutputFrames >= NumExpectedFrames && NumOutputFrames <= NumExpectedFrames + Resampler.GetMaxOutputFrames(Resampler.GetLatencyFrames()));
+
+        for (int32 Channel = 0; Channel < Conversion.NumChannels; ++Channel) {
+            const double ThdN = MeasureThdN(Output, Conversion.NumChannels, Channel, Conversion.OutputSampleRate, SettledFrames);
+            AddInfo(FString::Printf(TEXT("%s, channel %d: THD+N %.1f dB at %.0f Hz, %d taps"), *Name, Channel, ThdN, ToneFrequency, Resampler.GetNumTaps()));
+            TestTrue(FString::Printf(TEXT("%s, channel %d: THD+N below %.0f dB"), *Name, Channel, Conversion.MaxThdNDb), ThdN < Conversion.MaxThdNDb);
+        }
+
+        // a tone a quarter above the output Nyquist frequency has to be filtered instead of folding back into the band
+        const float AliasFrequency = 0.5f * Conversion.OutputSampleRate * 1.25f;
+        if (Conversion.InputSampleRate > Conversion.OutputSampleRate && AliasFrequency < 0.45f * Conversion.InputSampleRate) {
+            FOdinResampler      AliasResampler(Conversion.InputSampleRate, Conversion.OutputSampleRate, Conversion.NumChannels);
+            const TArray<float> AliasOutput = Convert(AliasResampler, MakeTone(Conversion.InputSampleRate, Conversion.NumChannels, AliasFrequency));
+            const double        AliasDb     = MeasureLevelDb(AliasOutput, Conversion.NumChannels, SettledFrames);
+            AddInfo(FString::Printf(TEXT("%s: %.0f Hz attenuated by %.1f dB"), *Name, AliasFrequency, -AliasDb));
+            TestTrue(FString::Printf(TEXT("%s: aliasing below -80 dB"), *Name), AliasDb < -80.0);
+        }
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOdinResamplerThroughputTest, "Odin.Audio.ResamplerThroughput", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FOdinResamplerThroughputTest::RunTest(const FString& Parameters)
+{
+    using namespace OdinResamplerTest;
+
+    for (const FConversion& Conversion : Conversions) {
+        FOdinResampler      Resampler(Conversion.InputSampleRate, Conversion.OutputSampleRate, Conversion.NumChannels);
+        const TArray<float> Input       = MakeTone(Conversion.InputSampleRate, Conversion.NumChannels, ToneFrequency);
+        const int32         BlockFrames = Conversion.InputSampleRate / 50;
+        const int32         NumBlocks   = Input.Num() / Conversion.NumChannels / BlockFrames;
+
+        // 20 ms blocks like the capture and pipeline paths, cycling through the second of input
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        int64        NumOutput   = 0;
+        for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration) {
+            const int32 Block = Iteration % NumBlocks;
+            NumOutput += Resampler.Process(Input.GetData() + Block * BlockFrames * Conversion.NumChannels, BlockFrames).Num();
+        }
+        const double Seconds      = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+        const double AudioSeconds = NumIterations / 50.0;
+
+        AddInfo(FString::Printf(TEXT("%d Hz to %d Hz, %d channels, %d taps: %.0f ns per 20 ms block, %.0fx realtime"), Conversion.InputSampleRate,
+                                Conversion.OutputSampleRate, Conversion.NumChannels, Resampler.GetNumTaps(), Seconds * 1.0e9 / NumIterations,
+                                AudioSeconds / FMath::Max(Seconds, 1e-9)));
+        TestTrue(TEXT("Resampler produced output"), NumOutput > 0);
+    }
+    return true;
+}
+
+#endif
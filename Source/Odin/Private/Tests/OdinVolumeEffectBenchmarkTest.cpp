@@ -0,0 +1,115 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "DSP/FloatArrayMath.h"
+#include "HAL/PlatformTime.h"
+#include "OdinAudio/Effects/OdinVolumeEffect.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#if PLATFORM_WINDOWS
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace OdinVolumeEffectBenchmarkTest
+{
+    constexpr int32 SampleRate    = 48000;
+    constexpr int32 FrameSamples  = SampleRate / 50;
+    constexpr int32 NumIterations = 20000;
+
+#if PLATFORM_CPU_X86_FAMILY
+    const TCHAR* CycleUnit = TEXT("TSC cycles");
+    uint64       ReadCycles()
+    { return __rdtsc(); }
+#else
+    // without a readable cycle counter the platform timer is used, its ticks are coarser than CPU cycles
+    const TCHAR* CycleUnit = TEXT("timer ticks");
+    uint64       ReadCycles()
+    { return FPlatformTime::Cycles64(); }
+#endif
+
+    /**
+     * Parameters of the previous implementation. Volatile, so the gain cannot be folded or hoisted out of the frame loop and
+     * is evaluated for every frame like it was on the pipeline thread.
+     */
+    struct FVolumeParameters {
+        volatile float SampleScale   = 2.0f;
+        volatile float ScaleExponent = 1.0f;
+        volatile bool  VolumeLog10   = false;
+    };
+
+    /**
+     * Copies a 20 ms frame and runs the kernel on the copy NumIterations times, so every run sees the same input.
+     * @return mean cycles per sample, including the copy
+     */
+    template <typename KernelType> double MeasureCyclesPerSample(const TArray<float>& Source, TArray<float>& Work, KernelType&& Kernel)
+    {
+        Work.SetNumUninitialized(Source.Num());
+        const uint64 StartCycles = ReadCycles();
+        for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration) {
+            FMemory::Memcpy(Work.GetData(), Source.GetData(), Source.Num() * sizeof(float));
+            Kernel(TArrayView<float>(Work));
+        }
+        return static_cast<double>(ReadCycles() - StartCycles) / (static_cast<double>(NumIterations) * Source.Num());
+    }
+} // namespace OdinVolumeEffectBenchmarkTest
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOdinVolumeEffectBenchmarkTest, "Odin.Audio.VolumeEffectBenchmark",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FOdinVolumeEffectBenchmarkTest::RunTest(const FString& Parameters)
+{
+    using namespace OdinVolumeEffectBenchmarkTest;
+
+    // the segmented exponential ramp has to stay close to a per-sample exponential ramp
+    TArray<float> Ramp;
+    Ramp.Init(1.0f, FrameSamples);
+    UOdinVolumeEffect::ApplyExponentialRamp(Ramp, 0.1f, 2.0f);
+    float MaxDeviationDb = 0.0f;
+    for (int32 Index = 0; Index < FrameSamples; ++Index) {
+        const float Exact = 0.1f * FMath::Pow(20.0f, static_cast<float>(Index) / FrameSamples);
+        MaxDeviationDb    = FMath::Max(MaxDeviationDb, FMath::Abs(20.0f * FMath::LogX(10.0f, Ramp[Index] / Exact)));
+    }
+    AddInfo(FString::Printf(TEXT("Segmented exponential ramp deviates at most %.3f dB from the exact ramp"), MaxDeviationDb));
+    TestTrue(TEXT("Segmented exponential ramp stays within 0.5 dB of the exact ramp"), MaxDeviationDb < 0.5f);
+    TestTrue(TEXT("Segmented exponential ramp ends at the target gain"), FMath::IsNearlyEqual(Ramp.Last(), 2.0f, 0.01f));
+
+    TArray<float> Source;
+    Source.SetNumUninitialized(FrameSamples);
+    for (int32 Index = 0; Index < FrameSamples; ++Index) {
+        Source[Index] = 0.25f * FMath::Sin(2.0f * PI * 440.0f * Index / SampleRate);
+    }
+    TArray<float> Work;
+
+    // the copy alone is subtracted from every kernel
+    const double CopyCycles = MeasureCyclesPerSample(Source, Work, [](TArrayView<float>) {});
+    // the previous implementation, the gain evaluated from the parameters per frame and applied in a scalar loop
+    FVolumeParameters Parameters;
+    const double      ScalarCycles = MeasureCyclesPerSample(Source, Work, [&Parameters](TArrayView<float> Samples) {
+        const float SampleScale = Parameters.SampleScale;
+        if (FMath::IsNearlyEqual(SampleScale, 0.0, 0.001)) {
+            return;
+        }
+        const float Gain = Parameters.VolumeLog10 ? FMath::LogX(10, SampleScale) * 20.0 : FMath::Pow(SampleScale, Parameters.ScaleExponent);
+        for (float& Sample : Samples) {
+            Sample *= Gain;
+        }
+    });
+    const double ConstantCycles = MeasureCyclesPerSample(Source, Work, [](TArrayView<float> Samples) { Audio::ArrayMultiplyByConstantInPlace(Samples, 2.0f); });
+    const double FadeCycles     = MeasureCyclesPerSample(Source, Work, [](TArrayView<float> Samples) { Audio::ArrayFade(Samples, 0.5f, 2.0f); });
+    const double SegmentedCycles =
+        MeasureCyclesPerSample(Source, Work, [](TArrayView<float> Samples) { UOdinVolumeEffect::ApplyExponentialRamp(Samples, 0.5f, 2.0f); });
+
+    AddInfo(FString::Printf(TEXT("Volume in %s per sample of a %d sample frame: scalar %.3f, constant gain %.3f, linear ramp (ArrayFade) %.3f, "
+                                 "segmented exponential ramp %.3f"),
+                            CycleUnit, FrameSamples, FMath::Max(ScalarCycles - CopyCycles, 0.0), FMath::Max(ConstantCycles - CopyCycles, 0.0),
+                            FMath::Max(FadeCycles - CopyCycles, 0.0), FMath::Max(SegmentedCycles - CopyCycles, 0.0)));
+    return true;
+}
+
+#endif
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "OdinCustomEffect.h"
+#include "OdinAudio/OdinSeqLock.h"
 
 #include "OdinActivityEffect.generated.h"
 
@@ -9,10 +10,51 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOdinActivityEffectCallback, const
 
 class UOdinPipeline;
 
+/**
+ * Audio levels of the latest frame processed by an activity effect.
+ */
+USTRUCT(BlueprintType)
+struct ODIN_API FOdinAudioLevels {
+    GENERATED_BODY()
+
+    /**
+     * Highest absolute sample value of the frame, 1 is full scale.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|State")
+    float Peak = 0.0f;
+    /**
+     * Root mean square of the frame, 1 is full scale.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|State")
+    float Rms = 0.0f;
+    /**
+     * Peak in decibels relative to full scale.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|State")
+    float PeakDbfs = -120.0f;
+    /**
+     * RMS in decibels relative to full scale.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|State")
+    float RmsDbfs = -120.0f;
+    /**
+     * Whether the frame was not flagged as silent by previous effects, e.g. the VAD.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|State")
+    bool bIsActive = false;
+    /**
+     * Increases with every processed frame, unchanged values mean no audio passed the pipeline since the last read.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|State")
+    int64 Sequence = 0;
+};
+
 /**
  * Codec-Effect for the odin audio pipeline.
  * The effect will invoke activity event and field based on the silent flag.
  * Event is dispatched to the GameThread.
+ * Additionally measures peak and RMS of every frame with vectorized kernels and publishes them through a sequence lock,
+ * so talking indicators and VU meters can poll the levels of all peers each tick without task dispatches or sample copies.
  */
 UCLASS(ClassGroup = Odin)
 class ODIN_API UOdinActivityEffect : public UOdinCustomEffect
@@ -31,12 +73,34 @@ class ODIN_API UOdinActivityEffect : public UOdinCustomEffect
               Category = "Odin|Audio Pipeline|Effects")
     static UOdinActivityEffect* ConstructActivityEffect(UObject* WorldContextObject);
 
+    /**
+     * Reads the levels of the latest frame. Usable from any thread, never blocks the pipeline.
+     * @return peak, RMS and activity of the latest frame
+     */
+    UFUNCTION(BlueprintPure, Category = "Odin|Audio Pipeline|State")
+    FOdinAudioLevels GetLevels() const;
+
     UPROPERTY(BlueprintAssignable, Category = "Odin|Audio Pipeline|Events")
     FOdinActivityEffectCallback ActivityCallback;
+    /**
+     * Toggles the level measurement on the pipeline thread.
+     */
+    UPROPERTY(BlueprintReadWrite, Category = "Odin|Audio Pipeline|State")
+    bool bMeasureLevels = true;
     UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|State")
     bool                                           HasActivity;
     TOdinCustomEffectUserData<UOdinActivityEffect> UserData;
 
   private:
     virtual void BeginDestroy() override;
+
+    struct FLevelSnapshot {
+        float Peak      = 0.0f;
+        float Rms       = 0.0f;
+        bool  bIsActive = false;
+    };
+
+    void PublishLevels(const TArrayView<float>& InSamples, bool bIsActive);
+
+    TOdinSeqLock<FLevelSnapshot> Levels;
 };
\ No newline at end of file
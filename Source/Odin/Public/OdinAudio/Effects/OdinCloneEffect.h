@@ -2,18 +2,48 @@
 #pragma once
 
 #include "OdinCustomEffect.h"
-#include "SampleBuffer.h"
-#include "OdinCloneEffect.generated.h"
+#include "Containers/Ticker.h"
+#include "DSP/Dsp.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+
+#include <atomic>
 
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOdinCloneEffectResponse, FString, response);
+#include "OdinCloneEffect.generated.h"
 
 class UOdinPipeline;
+class UOdinCloneEffect;
+
+/**
+ * @class FOdinCloneDrainThread
+ *
+ * Worker that drains the ring of a clone effect in a fixed interval and hands the batch to a native handler.
+ */
+class ODIN_API FOdinCloneDrainThread : public FRunnable
+{
+  public:
+    FOdinCloneDrainThread(UOdinCloneEffect* InEffect, float InDrainIntervalMs);
+    virtual ~FOdinCloneDrainThread() override;
+
+    void Start();
+
+    virtual uint32 Run() override;
+    virtual void   Exit() override;
+
+  private:
+    UOdinCloneEffect*           Effect;
+    FThreadSafeBool             bIsRunning;
+    TUniquePtr<FRunnableThread> Thread;
+    FEvent*                     DrainEvent;
+    float                       DrainIntervalMs;
+};
 
 /**
  * Codec-Effect for the odin audio pipeline.
- * The effect will invoke Callback function with a copy of samples buffer
- * and if bound to the delegate, a clone of that buffer.
- * Callback will be called on the GameThread by default.
+ * The effect copies the samples of every pipeline frame into a preallocated ring without allocating or dispatching a
+ * task. Consumers drain the ring in batches, by default once per game tick on the GameThread, invoking Callback and the
+ * delegate with all samples gathered since the last tick. Alternatively a native handler can drain it on a worker thread.
+ * If consumers fall behind, new samples are dropped and counted.
  */
 UCLASS(ClassGroup = Odin)
 class ODIN_API UOdinCloneEffect : public UOdinCustomEffect
@@ -21,7 +51,13 @@ class ODIN_API UOdinCloneEffect : public UOdinCustomEffect
     GENERATED_BODY()
 
   public:
+    /**
+     * Called on the drain thread with a batch of interleaved samples. The view is only valid during the call.
+     */
+    typedef TFunction<void(TArrayView<const float> Samples, int32 SampleRate, int32 NumChannels)> FOdinCloneSampleHandler;
+
     UOdinCloneEffect(const FObjectInitializer& PCIP);
+    virtual void PostInitProperties() override;
     virtual void CustomEffect(const TArrayView<float>& InSamples, bool*& bIsSilent,
                               TOdinCustomEffectUserData<UOdinCustomEffect>* const InUserData) const override;
 
@@ -31,10 +67,10 @@ class ODIN_API UOdinCloneEffect : public UOdinCustomEffect
     FOdinDispatchCloneCallbackDelegate OnDispatchCloneCallbackBP;
 
     /**
-     * Callback function on copy of samples in GameThread
-     * @param Buffer the buffer copy of samples
+     * Callback function on a batch of cloned samples in GameThread
+     * @param Samples all samples gathered since the last game tick, reused between calls
      */
-    virtual void Callback(Audio::TSampleBuffer<float> Buffer) const;
+    virtual void Callback(const TArray<float>& Samples) const;
 
     UFUNCTION(BlueprintCallable,
               meta     = (DisplayName = "Construct Clone Effect", ToolTip = "Creates a effect that dispatch a copy of samples to the game thread.",
@@ -42,8 +78,32 @@ class ODIN_API UOdinCloneEffect : public UOdinCustomEffect
               Category = "Odin|Audio Pipeline|Effects")
     static UOdinCloneEffect* ConstructCloneEffect(UObject* WorldContextObject);
 
-    UPROPERTY(BlueprintAssignable, Category = "Odin|Events")
-    FOdinCloneEffectResponse PostResponse;
+    /**
+     * Resizes the ring holding cloned samples until they are drained. Only possible while the effect is not part of a pipeline.
+     * @param Milliseconds buffered audio at the current SampleRate and channel count
+     * @return true if the ring was resized
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Pipeline|Effects")
+    bool SetBufferCapacityMs(float Milliseconds);
+
+    /**
+     * @return Number of samples dropped because the ring was full.
+     */
+    UFUNCTION(BlueprintPure, Category = "Odin|Audio Pipeline|State")
+    int64 GetDroppedSampleCount() const;
+
+    /**
+     * Drains the ring once per game tick and invokes Callback and OnDispatchCloneCallbackBP. This is the default.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Pipeline|Effects")
+    void DeliverOnGameThread();
+
+    /**
+     * Drains the ring on a dedicated worker thread and invokes the handler instead of the GameThread callbacks.
+     * @param Handler native consumer of the cloned samples
+     * @param DrainIntervalMs interval in which the worker drains the ring
+     */
+    void DeliverOnWorkerThread(FOdinCloneSampleHandler Handler, float DrainIntervalMs = 20.0f);
 
     UPROPERTY(BlueprintReadWrite, Category = "Odin|Effect")
     int32 SampleRate = 48000;
@@ -53,8 +113,29 @@ class ODIN_API UOdinCloneEffect : public UOdinCustomEffect
     TOdinCustomEffectUserData<UOdinCloneEffect> UserData;
 
   protected:
-    virtual void DispatchClone(UOdinCloneEffect* Self, const TArrayView<float>& Samples, ENamedThreads::Type Target) const;
+    friend class FOdinCloneDrainThread;
+
+    /**
+     * Copies the samples into the ring. Runs on the pipeline thread, never allocates or blocks.
+     */
+    virtual void DispatchClone(UOdinCloneEffect* Self, const TArrayView<float>& Samples);
+
+    /**
+     * Moves all buffered samples into the drain buffer and hands them to the active consumer.
+     */
+    void Drain();
 
   private:
+    bool TickDrain(float DeltaTime);
+    void StopDelivery();
     virtual void BeginDestroy() override;
-};
\ No newline at end of file
+
+    Audio::TCircularAudioBuffer<float> Ring;
+    std::atomic<uint64>                NumDroppedSamples = 0;
+
+    // consumer only
+    TArray<float>                     DrainBuffer;
+    FOdinCloneSampleHandler           WorkerHandler;
+    FTSTicker::FDelegateHandle        TickerHandle;
+    TUniquePtr<FOdinCloneDrainThread> DrainThread;
+};
@@ -5,6 +5,8 @@
 #include "OdinCore/include/odin.h"
 #include "UObject/Object.h"
 
+#include <atomic>
+
 #include "OdinCustomEffect.generated.h"
 
 template <class T> struct ODIN_API TOdinCustomEffectUserData {
@@ -62,6 +64,12 @@ class ODIN_API UOdinCustomEffect : public UObject
     inline void SetParent(TWeakObjectPtr<UOdinPipeline> InPipeline)
     { this->Pipeline = InPipeline; }
 
+    /**
+     * @return true while the effect runs in a pipeline, either in its own slot or hosted by a native effect chain
+     */
+    inline bool IsAttached() const
+    { return this->Pipeline.IsValid() || NumChainHosts.load(std::memory_order_relaxed) > 0; }
+
     UFUNCTION(BlueprintCallable, meta = (DisplayName = "Detach Effect", ToolTip = "Try to remove this effect from parent pipeline"),
               Category = "Odin|Audio Pipeline")
     bool RemoveSelfFromParent();
@@ -84,6 +92,9 @@ class ODIN_API UOdinCustomEffect : public UObject
     };
 
   protected:
+    friend class FOdinCustomEffectHost;
+
     TWeakObjectPtr<UOdinPipeline> Pipeline;
+    std::atomic<int32>            NumChainHosts = 0;
     virtual void                  BeginDestroy() override;
 };
\ No newline at end of file
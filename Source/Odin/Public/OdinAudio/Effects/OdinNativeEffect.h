@@ -0,0 +1,54 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OdinCore/include/odin.h"
+#include "Templates/RefCounting.h"
+
+/**
+ * Native codec-effect for the odin audio pipeline.
+ *
+ * Lightweight alternative to UOdinCustomEffect for high-rate DSP written in C++. The native pipeline calls Process with
+ * the raw sample span directly, without resolving weak object pointers or touching the UObject system on the audio path.
+ * Effects are reference counted, UOdinPipeline holds a reference for as long as the effect is inserted.
+ *
+ * Like custom effects, Process runs on the thread popping from the encoder or decoder and blocks that pop call.
+ * @remarks Implementations must be thread-safe towards their game thread setters, e.g. by using atomics.
+ */
+class ODIN_API IOdinNativeEffect : public FRefCountBase
+{
+  public:
+    /**
+     * Processes one pipeline frame in place.
+     * @param Samples interleaved f32 samples
+     * @param NumSamples number of samples in the frame
+     * @param bIsSilent flag if the frame is considered silent, can be changed for following effects
+     */
+    virtual void Process(float* Samples, uint32 NumSamples, bool& bIsSilent) = 0;
+
+    /**
+     * @return Name used in logs and statistics.
+     */
+    virtual const TCHAR* GetName() const
+    { return TEXT("NativeEffect"); }
+
+    /**
+     * @return true if the effect runs the given effect as part of its own processing, used to reject cycles.
+     */
+    virtual bool ContainsEffect(const IOdinNativeEffect* Effect) const
+    { return false; }
+
+    /**
+     * Callback registered with odin_pipeline_insert_custom_effect, the user data is the effect itself.
+     */
+    static void FFICallback(float* Samples, uint32_t SamplesCount, bool* bIsSilent, const void* InUserData)
+    {
+        if (!InUserData || !bIsSilent)
+            return;
+
+        IOdinNativeEffect* const Effect = const_cast<IOdinNativeEffect*>(static_cast<const IOdinNativeEffect*>(InUserData));
+        Effect->Process(Samples, SamplesCount, *bIsSilent);
+    }
+};
+
+typedef TRefCountPtr<IOdinNativeEffect> FOdinNativeEffectRef;
@@ -0,0 +1,103 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+#pragma once
+
+#include "OdinNativeEffect.h"
+
+#include <atomic>
+
+class UOdinCustomEffect;
+
+/**
+ * Native effect running an ordered list of native effects within a single pipeline callback.
+ *
+ * Every effect inserted into a pipeline is a separate callback slot of the native library. Stacking several effects in
+ * one chain saves a transition per effect and frame, and reordering or bypassing effects only changes plugin memory
+ * instead of calling odin_pipeline_move_effect or odin_pipeline_remove_effect. Custom effects like volume, mute, activity
+ * and clone can be hosted in the chain as well.
+ *
+ * The chain is changed from the game thread and processed on the pipeline thread. Every edit publishes a new immutable
+ * snapshot of the entries with an atomic pointer swap, so processing never locks. Replaced snapshots are released on
+ * the game thread once no pipeline thread reads them anymore.
+ */
+class ODIN_API FOdinNativeEffectChain : public IOdinNativeEffect
+{
+  public:
+    FOdinNativeEffectChain();
+    virtual ~FOdinNativeEffectChain() override;
+
+    virtual void Process(float* Samples, uint32 NumSamples, bool& bIsSilent) override;
+
+    virtual const TCHAR* GetName() const override
+    { return TEXT("NativeEffectChain"); }
+
+    virtual bool ContainsEffect(const IOdinNativeEffect* Effect) const override;
+
+    /**
+     * Inserts an effect into the chain.
+     * @param Index position in the chain, INDEX_NONE appends at the end
+     * @param Effect effect to run, the chain keeps a reference
+     * @return true if the effect was inserted, false if it was invalid, already part of the chain or would run itself
+     */
+    bool Insert(int32 Index, FOdinNativeEffectRef Effect);
+
+    /**
+     * Hosts a custom effect in the chain instead of a pipeline slot of its own. The chain only holds the effect weakly,
+     * keep it referenced for as long as it is part of the chain.
+     * @param Index position in the chain, INDEX_NONE appends at the end
+     * @param Effect effect to run, must not be inserted into a pipeline directly
+     * @return the chain entry of the effect, used with Remove, Move and SetBypass, or null if the effect was not inserted
+     */
+    FOdinNativeEffectRef InsertCustomEffect(int32 Index, UOdinCustomEffect* Effect);
+
+    /**
+     * @return true if the effect was part of the chain
+     */
+    bool Remove(const FOdinNativeEffectRef& Effect);
+
+    /**
+     * Moves an effect to a new position.
+     * @return true if the effect was part of the chain
+     */
+    bool Move(const FOdinNativeEffectRef& Effect, int32 NewIndex);
+
+    /**
+     * Skips or resumes an effect without removing it from the chain.
+     * @return true if the effect was part of the chain
+     */
+    bool SetBypass(const FOdinNativeEffectRef& Effect, bool bBypass);
+
+    bool IsBypassed(const FOdinNativeEffectRef& Effect) const;
+
+    /**
+     * @return The effects in processing order.
+     */
+    TArray<FOdinNativeEffectRef> GetEffects() const;
+
+    int32 Num() const;
+
+  private:
+    struct FEntry {
+        FOdinNativeEffectRef              Effect;
+        TWeakObjectPtr<UOdinCustomEffect> CustomEffect;
+        bool                              bBypass = false;
+    };
+
+    typedef TArray<FEntry> FSnapshot;
+
+    int32 IndexOf(const FOdinNativeEffectRef& Effect) const;
+    /**
+     * Publishes a copy of the entries to the pipeline thread and releases the snapshots it no longer reads. Requires ChainCS.
+     */
+    void Publish();
+    void ReleaseRetiredSnapshots();
+
+    // game thread edits, guarded against each other
+    mutable FCriticalSection ChainCS;
+    TArray<FEntry>           Entries;
+    TArray<const FSnapshot*> RetiredSnapshots;
+
+    std::atomic<const FSnapshot*> Snapshot;
+    mutable std::atomic<int32>    NumReaders = 0;
+};
+
+typedef TRefCountPtr<FOdinNativeEffectChain> FOdinNativeEffectChainRef;
@@ -2,18 +2,152 @@
 #pragma once
 
 #include "OdinCustomEffect.h"
-#include "SampleBuffer.h"
-#include "Sound/SampleBufferIO.h"
-#include "Engine/TimerHandle.h"
+#include "DSP/Dsp.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "OdinAudio/OdinRemixer.h"
+#include "OdinAudio/OdinResampler.h"
+
+#include <atomic>
+
 #include "OdinRestGSTTEffect.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOdinRestGSTTEffectResponse, FString, response);
 
 class UOdinPipeline;
+class UOdinRestGSTTEffect;
+
+/**
+ * Statistics of the speech-to-text streaming of an UOdinRestGSTTEffect.
+ */
+USTRUCT(BlueprintType)
+struct ODIN_API FOdinGSTTStats {
+    GENERATED_BODY()
+
+    /**
+     * Utterances or utterance chunks cut by the segmenter.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Effects")
+    int64 NumSegments = 0;
+    /**
+     * Segments posted to the endpoint.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Effects")
+    int64 NumUploads = 0;
+    /**
+     * Segments dropped because too many uploads were still pending.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Effects")
+    int64 NumDroppedSegments = 0;
+    /**
+     * Pipeline frames dropped because the segmenter thread fell behind.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Effects")
+    int64 NumOverflowFrames = 0;
+};
+
+/**
+ * Settings of the speech-to-text streaming, copied when streaming starts.
+ */
+struct FOdinGSTTStreamSettings {
+    FString Endpoint;
+    FString ContentType;
+    int32   ResampleRate      = 16000;
+    float   MaxSegmentSeconds = 3.0f;
+    float   PreRollMs         = 200.0f;
+    float   HangoverMs        = 600.0f;
+    int32   MaxPendingUploads = 2;
+    bool    bWriteWav         = false;
+};
+
+/**
+ * @class FOdinGSTTStreamer
+ *
+ * Streaming backend of UOdinRestGSTTEffect. The pipeline thread writes every frame together with its silent flag into
+ * preallocated rings. A worker thread drains them, converts the audio to mono at the upload sample rate and cuts
+ * utterances based on the flag, i.e. on a preceding VAD effect. Utterances are limited to a maximum length, encoded as
+ * 16 bit WAV and posted with a bounded number of pending uploads, so memory stays bounded even if the endpoint stalls.
+ * Uploads may complete out of order, every request carries the index of its segment in the X-Odin-Segment header.
+ */
+class ODIN_API FOdinGSTTStreamer : public FRunnable
+{
+  public:
+    /**
+     * @param InOwner effect receiving responses and segment callbacks on the game thread
+     * @param InCapacityMs audio the rings hold until the worker drains them
+     */
+    FOdinGSTTStreamer(UOdinRestGSTTEffect* InOwner, float InCapacityMs = 1000.0f);
+    virtual ~FOdinGSTTStreamer() override;
+
+    /**
+     * Stores a pipeline frame. Runs on the pipeline thread, never allocates or blocks.
+     */
+    void Write(const float* Samples, int32 NumSamples, int32 NumChannels, int32 SampleRate, bool bIsActive);
+
+    /**
+     * Starts the worker thread with the given settings, restarting it if it was already running.
+     */
+    void Start(const FOdinGSTTStreamSettings& InSettings);
+
+    bool IsRunning() const
+    { return bIsRunning; }
+
+    FOdinGSTTStats GetStats() const;
+
+    virtual uint32 Run() override;
+    virtual void   Exit() override;
+
+  private:
+    struct FFrameHeader {
+        int32 NumSamples  = 0;
+        int32 NumChannels = 1;
+        int32 SampleRate  = 48000;
+        bool  bIsActive   = false;
+    };
+
+    void Drain();
+    void ProcessFrame(const FFrameHeader& Header, const float* Samples);
+    void AppendToSegment(TArrayView<const float> Samples);
+    void FinishSegment();
+    void Upload(TArray<uint8>&& Wav, int32 Index);
+
+    TWeakObjectPtr<UOdinRestGSTTEffect> Owner;
+
+    // written by the pipeline thread, drained by the worker
+    Audio::TCircularAudioBuffer<float>        SampleRing;
+    Audio::TCircularAudioBuffer<FFrameHeader> HeaderRing;
+    const int32                               MaxFrameSamples;
+
+    // worker thread only
+    FOdinGSTTStreamSettings            Settings;
+    TArray<float>                      FrameBuffer;
+    FOdinRemixer                       Remixer;
+    FOdinResampler                     Resampler;
+    Audio::TCircularAudioBuffer<float> PreRoll;
+    TArray<int16>                      Segment;
+    int32                              MaxSegmentSamples = 0;
+    int32                              HangoverSamples   = 0;
+    int32                              SilentSamples     = 0;
+    bool                               bInSegment        = false;
+    int32                              SegmentIndex      = 0;
+
+    TSharedPtr<std::atomic<int32>, ESPMode::ThreadSafe> PendingUploads;
+    std::atomic<uint64>                                 NumSegments        = 0;
+    std::atomic<uint64>                                 NumUploads         = 0;
+    std::atomic<uint64>                                 NumDroppedSegments = 0;
+    std::atomic<uint64>                                 NumOverflowFrames  = 0;
+
+    FCriticalSection            StartCS;
+    FThreadSafeBool             bIsRunning;
+    TUniquePtr<FRunnableThread> Thread;
+    FEvent*                     DrainEvent;
+};
 
 /**
  * Codec-Effect for the odin audio pipeline.
- * The effect will cache audio in a file based on a timer.
+ * The effect streams audio to a speech-to-text endpoint. Utterances are cut on a worker thread based on the silent flag
+ * of preceding effects, usually a VAD effect, and posted as 16 bit mono WAV. Without a VAD, audio is sent in chunks of
+ * Timer seconds. The pipeline thread only copies samples into a preallocated ring.
  * Used in a remote web sample check for speech-to-text content check.
  * @deprecated This will be included or replaced by the 4Players/ue-filter-plugin extension.
  */
@@ -24,9 +158,16 @@ class ODIN_API UOdinRestGSTTEffect : public UOdinCustomEffect
 
   public:
     UOdinRestGSTTEffect(const class FObjectInitializer& PCIP);
+    virtual void PostInitProperties() override;
     virtual void CustomEffect(const TArrayView<float>& InSamples, bool*& bIsSilent,
                               TOdinCustomEffectUserData<UOdinCustomEffect>* const InUserData) const override;
 
+    /**
+     * Called on the GameThread for every cut segment.
+     * @param Buffer mono samples at ResampleRate
+     * @param Name file name of the segment
+     * @param NameSpace folder of the segment
+     */
     virtual void Callback(Audio::FAlignedFloatBuffer Buffer, FString Name, FString NameSpace) const {}
 
     UFUNCTION(BlueprintCallable,
@@ -35,6 +176,20 @@ class ODIN_API UOdinRestGSTTEffect : public UOdinCustomEffect
               Category = "Odin|Audio Pipeline|Effects")
     static UOdinRestGSTTEffect* ConstructRestGSTTEffect(UObject* WorldContextObject);
 
+    /**
+     * (Re)starts the streaming worker with the current settings. Without a call, streaming starts on the game thread once
+     * the pipeline processed the first frame, using the settings at that time. Call it again after changing ResampleRate,
+     * Timer or the upload settings.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Effects")
+    void StartStreaming();
+
+    UFUNCTION(BlueprintPure, Category = "Odin|Effects")
+    bool IsStreaming() const;
+
+    UFUNCTION(BlueprintPure, Category = "Odin|Effects")
+    FOdinGSTTStats GetStreamingStats() const;
+
     void PostRequest(const FString& Endpoint, const FString& Payload, const FString& ContentType);
     bool Remix(const float* InAudio, int32 NumSamples, int32 NumChannels, int32 SourceSampleRate, int32 TargetSampleRate, Audio::FAlignedFloatBuffer& OutAudio);
 
@@ -47,18 +202,47 @@ class ODIN_API UOdinRestGSTTEffect : public UOdinCustomEffect
     int32 ResampleRate = 16000;
     UPROPERTY(BlueprintReadWrite, Category = "Odin|Effects")
     bool bStereo = false;
+    /**
+     * Maximum length of a segment in seconds, longer utterances are sent in chunks.
+     */
     UPROPERTY(BlueprintReadWrite, Category = "Odin|Effects")
     float Timer = 3;
+    /**
+     * Endpoint every segment is posted to as WAV, e.g. a local stand-in like 'http://127.0.0.1:8080/transcribe'. Segments
+     * are only passed to Callback if empty.
+     */
+    UPROPERTY(BlueprintReadWrite, Category = "Odin|Effects")
+    FString UploadEndpoint;
+    UPROPERTY(BlueprintReadWrite, Category = "Odin|Effects")
+    FString UploadContentType = TEXT("audio/wav");
+    /**
+     * Audio before the start of an utterance that is included in the segment.
+     */
+    UPROPERTY(BlueprintReadWrite, Category = "Odin|Effects")
+    float PreRollMs = 200.0f;
+    /**
+     * Silence after which an utterance is considered finished.
+     */
+    UPROPERTY(BlueprintReadWrite, Category = "Odin|Effects")
+    float HangoverMs = 600.0f;
+    /**
+     * Uploads that may be in flight at the same time, further segments are dropped.
+     */
+    UPROPERTY(BlueprintReadWrite, Category = "Odin|Effects")
+    int32 MaxPendingUploads = 2;
 
     TOdinCustomEffectUserData<UOdinRestGSTTEffect> UserData;
 
   protected:
-    bool         WriteWav = false;
-    FTimerHandle TimerHandle;
-    void         TimerCallback();
+    friend class FOdinGSTTStreamer;
+
+    /**
+     * Writes every segment as WAV file into the saved directory, on the worker thread.
+     */
+    bool WriteWav = false;
 
   private:
-    Audio::TSampleBuffer<float> AudioBuffer;
-    Audio::FSoundWavePCMWriter  Writer;
-    virtual void                BeginDestroy() override;
-};
\ No newline at end of file
+    TUniquePtr<FOdinGSTTStreamer> Streamer;
+    mutable std::atomic<bool>     bStartRequested = false;
+    virtual void                  BeginDestroy() override;
+};
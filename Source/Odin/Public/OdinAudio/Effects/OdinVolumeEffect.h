@@ -3,15 +3,25 @@
 
 #include "OdinCustomEffect.h"
 
+#include <atomic>
+
 #include "OdinVolumeEffect.generated.h"
 
 class UOdinPipeline;
 
+UENUM(BlueprintType)
+enum class EOdinVolumeRamp : uint8 {
+    Linear      UMETA(DisplayName = "Linear"),
+    Exponential UMETA(DisplayName = "Exponential"),
+};
+
 /**
  * Codec-Effect for the odin audio pipeline.
  * The effect will mutate samples buffer with logarithmic or exponental scale.
  * Provides a simple way for an audio boost functionality.
  * For more complex amplitude checkout dBFS and override the custom effect function.
+ * The gain is computed once whenever a parameter changes. The pipeline thread ramps from the previous to the new gain
+ * across the next frame, so changing the volume does not cause clicks.
  */
 UCLASS(ClassGroup = Odin)
 class ODIN_API UOdinVolumeEffect : public UOdinCustomEffect
@@ -20,6 +30,11 @@ class ODIN_API UOdinVolumeEffect : public UOdinCustomEffect
 
   public:
     UOdinVolumeEffect(const class FObjectInitializer& PCIP);
+    virtual void PostInitProperties() override;
+    virtual void PostLoad() override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 
     virtual void CustomEffect(const TArrayView<float>& InSamples, bool*& bIsSilent,
                               TOdinCustomEffectUserData<UOdinCustomEffect>* const InUSerData) const override;
@@ -30,16 +45,57 @@ class ODIN_API UOdinVolumeEffect : public UOdinCustomEffect
               Category = "Odin|Audio Pipeline|Effects")
     static UOdinVolumeEffect* ConstructVolumeEffect(UObject* WorldContextObject, float scale = 1.0f);
 
-    UPROPERTY(BlueprintReadWrite, Category = "Odin|Audio Pipeline|State")
-    float SampleScale = 2.0;
-    UPROPERTY(BlueprintReadWrite, Category = "Odin|Audio Pipeline|State")
-    float ScaleExponent = 1.0;
+    UFUNCTION(BlueprintSetter, Category = "Odin|Audio Pipeline|State")
+    void SetSampleScale(float NewSampleScale);
+    UFUNCTION(BlueprintGetter, Category = "Odin|Audio Pipeline|State")
+    float GetSampleScale() const;
+    UFUNCTION(BlueprintSetter, Category = "Odin|Audio Pipeline|State")
+    void SetScaleExponent(float NewScaleExponent);
+    UFUNCTION(BlueprintGetter, Category = "Odin|Audio Pipeline|State")
+    float GetScaleExponent() const;
+    UFUNCTION(BlueprintSetter, Category = "Odin|Audio Pipeline|State")
+    void SetVolumeLog10(bool bNewVolumeLog10);
+    UFUNCTION(BlueprintGetter, Category = "Odin|Audio Pipeline|State")
+    bool GetVolumeLog10() const;
+
+    /**
+     * @return The gain applied to the samples once the current ramp finished.
+     */
+    UFUNCTION(BlueprintPure, Category = "Odin|Audio Pipeline|State")
+    float GetTargetGain() const;
+
+    /**
+     * Ramps the samples from StartGain to EndGain with a constant gain ratio per segment of 32 samples, i.e. linear on a
+     * decibel scale. Both gains must be positive.
+     */
+    static void ApplyExponentialRamp(const TArrayView<float>& InSamples, float StartGain, float EndGain);
 
+    /**
+     * Shape of the ramp from the previous to the new gain. Exponential ramps sound more even for large volume changes.
+     */
     UPROPERTY(BlueprintReadWrite, Category = "Odin|Audio Pipeline|State")
-    bool VolumeLog10 = false;
+    EOdinVolumeRamp Ramp = EOdinVolumeRamp::Linear;
 
     TOdinCustomEffectUserData<UOdinVolumeEffect> UserData;
 
   private:
     virtual void BeginDestroy() override;
+
+    /**
+     * Computes the gain from the current parameters and publishes it to the pipeline thread. Runs whenever the parameters
+     * may have changed without their setters, i.e. after initialization, loading and editing.
+     */
+    void UpdateTargetGain();
+
+    UPROPERTY(BlueprintGetter = GetSampleScale, BlueprintSetter = SetSampleScale, Category = "Odin|Audio Pipeline|State")
+    float SampleScale = 2.0;
+    UPROPERTY(BlueprintGetter = GetScaleExponent, BlueprintSetter = SetScaleExponent, Category = "Odin|Audio Pipeline|State")
+    float ScaleExponent = 1.0;
+    UPROPERTY(BlueprintGetter = GetVolumeLog10, BlueprintSetter = SetVolumeLog10, Category = "Odin|Audio Pipeline|State")
+    bool VolumeLog10 = false;
+
+    std::atomic<float> TargetGain = 2.0f;
+    // pipeline thread only
+    mutable float CurrentGain     = 0.0f;
+    mutable bool  bHasCurrentGain = false;
 };
\ No newline at end of file
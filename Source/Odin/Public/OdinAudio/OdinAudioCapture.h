@@ -5,9 +5,11 @@
 #include "AudioCapture.h"
 #include "CoreMinimal.h"
 #include "Runtime/Launch/Resources/Version.h"
-#include "Tickable.h"
+#include "Async/Future.h"
 
 #include "AudioDeviceNotificationSubsystem.h"
+#include "OdinCaptureSink.h"
+#include "OdinCaptureWatchdog.h"
 
 #include "OdinAudioCapture.generated.h"
 
@@ -31,14 +33,65 @@ struct ODIN_API FOdinCaptureDeviceInfo {
     FAudioCaptureDeviceInfo AudioCaptureInfo = FAudioCaptureDeviceInfo();
 };
 
+/**
+ * Capture timing statistics of a single capture device, accumulated over all streams opened on it.
+ */
+USTRUCT(BlueprintType)
+struct ODIN_API FOdinCaptureStats {
+    GENERATED_BODY()
+
+    /**
+     * @brief The internal id of the device, empty for the default device.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Capture")
+    FString DeviceId;
+    /**
+     * @brief Number of blocks delivered by the device.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Capture")
+    int64 NumBlocks = 0;
+    /**
+     * @brief Number of blocks the device flagged with an overflow, i.e. audio lost inside the driver.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Capture")
+    int64 NumOverflows = 0;
+    /**
+     * @brief Number of blocks whose stream time skipped ahead of the previous block, i.e. the device lost audio without
+     * reporting an overflow.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Capture")
+    int64 NumStreamDiscontinuities = 0;
+    /**
+     * @brief Smoothed deviation in milliseconds between the callback intervals and the stream time advance.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Capture")
+    float JitterMs = 0.0f;
+    /**
+     * @brief Largest single deviation in milliseconds between a callback interval and the stream time advance.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Capture")
+    float MaxJitterMs = 0.0f;
+};
+
 DECLARE_DYNAMIC_DELEGATE_TwoParams(FGetCaptureDeviceDelegate, const TArray<FOdinCaptureDeviceInfo>&, OutDevices, const FOdinCaptureDeviceInfo&, CurrentDevice);
 
 DECLARE_DYNAMIC_DELEGATE_OneParam(FChangeCaptureDeviceDelegate, bool, bSuccess);
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FCaptureDeviceChange);
 
+/**
+ * Capture buffer duration requested from the platform capture stream. Shorter buffers reduce the capture to encoder
+ * latency at the cost of more frequent capture callbacks.
+ */
+UENUM(BlueprintType)
+enum class EOdinCaptureLatency : uint8 {
+    Latency_5ms  = 5 UMETA(DisplayName = "5 ms"),
+    Latency_10ms = 10 UMETA(DisplayName = "10 ms"),
+    Latency_20ms = 20 UMETA(DisplayName = "20 ms"),
+};
+
 UCLASS(ClassGroup = (Odin), Blueprintable, BlueprintType)
-class ODIN_API UOdinAudioCapture : public UAudioCapture, public FTickableGameObject
+class ODIN_API UOdinAudioCapture : public UAudioCapture
 {
     GENERATED_BODY()
 
@@ -46,14 +99,49 @@ class ODIN_API UOdinAudioCapture : public UAudioCapture, public FTickableGameObj
     /**
      * @brief Returns all available capture devices with the device id. Only usable in GameThread.
      *
-     * IMPORTANT! Should not be used in tick or on a regular basis because it could lead to
-     * stuttering.
+     * The device list is cached and only enumerated again after the Audio Device Notification
+     * Subsystem reported a device change, or RefreshCaptureDevices was called.
      *
      * @param OutDevices All available capture devices
      */
     UFUNCTION(BlueprintPure, Category = "Odin|Audio Capture")
     void GetCaptureDevicesAvailable(TArray<FOdinCaptureDeviceInfo>& OutDevices);
 
+    /**
+     * @brief Enumerates the platform capture devices and updates the cached device list.
+     *
+     * IMPORTANT! Should not be used in tick or on a regular basis because it could lead to
+     * stuttering.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Capture")
+    void RefreshCaptureDevices();
+
+    /**
+     * @brief Version of the cached device list, incremented on every enumeration. Can be used to
+     * detect whether a device list shown in UI has to be rebuilt.
+     * @return current device list version
+     */
+    UFUNCTION(BlueprintPure, Category = "Odin|Audio Capture")
+    int32 GetCaptureDevicesVersion() const;
+
+    /**
+     * @brief Looks up a capture device by its id in the cached device list.
+     * @param DeviceId The id of the capture device.
+     * @param OutDevice The found device info.
+     * @return True, if the device is available.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Capture")
+    bool FindCaptureDeviceById(FString DeviceId, FOdinCaptureDeviceInfo& OutDevice);
+
+    /**
+     * @brief Looks up a capture device by its name in the cached device list.
+     * @param DeviceName The name of the capture device. Needs to be an exact match.
+     * @param OutDevice The found device info.
+     * @return True, if the device is available.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Capture")
+    bool FindCaptureDeviceByName(FName DeviceName, FOdinCaptureDeviceInfo& OutDevice);
+
     /**
      * @brief Returns info on the current capture device. Only usable in GameThread.
      *
@@ -74,7 +162,7 @@ class ODIN_API UOdinAudioCapture : public UAudioCapture, public FTickableGameObj
 
     /**
      * @brief Updates the capture device and restarts the capture stream of the Audio Capture
-     * object. Only usable in GameThread.
+     * object. Only usable in GameThread. Fails while an asynchronous device change is pending.
      *
      * IMPORTANT! Should not be used in tick or on a regular basis because it could lead to
      * stuttering.
@@ -86,15 +174,53 @@ class ODIN_API UOdinAudioCapture : public UAudioCapture, public FTickableGameObj
     void ChangeCaptureDeviceById(FString NewDeviceId, bool& bSuccess);
 
     /**
-     * @brief Starts Capturing Audio and returns whether capturing was started successfully.
+     * @brief Asynchronous version of ChangeCaptureDeviceById. Device enumeration and the stream reopen run on a background
+     * task, so the game thread does not stall while the platform opens the device. While the stream is down, native
+     * capture sinks and generator delegates receive silence for the gap. Only callable in GameThread.
+     *
+     * @param NewDeviceId The id of the targeted capture device.
+     * @param OnChangeCompleted Executed on the game thread once the change is completed.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Capture", meta = (AutoCreateRefTerm = "OnChangeCompleted"))
+    void AsyncChangeCaptureDeviceById(FString NewDeviceId, const FChangeCaptureDeviceDelegate& OnChangeCompleted);
+
+    /**
+     * @brief Asynchronous version of ChangeCaptureDeviceByName, see AsyncChangeCaptureDeviceById. Only callable in
+     * GameThread.
+     *
+     * @param DeviceName The name of the targeted capture device. Needs to be an exact match.
+     * @param OnChangeCompleted Executed on the game thread once the change is completed.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Capture", meta = (AutoCreateRefTerm = "OnChangeCompleted"))
+    void AsyncChangeCaptureDeviceByName(FName DeviceName, const FChangeCaptureDeviceDelegate& OnChangeCompleted);
+
+    /**
+     * @brief Asynchronous version of RestartCapturing. Reopens the stream of the currently selected device, or the
+     * Default Device if none was selected, on a background task. Only callable in GameThread.
+     *
+     * @param OnChangeCompleted Executed on the game thread once the restart is completed.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Capture", meta = (AutoCreateRefTerm = "OnChangeCompleted"))
+    void AsyncRestartCapturing(const FChangeCaptureDeviceDelegate& OnChangeCompleted);
+
+    /**
+     * @brief Starts Capturing Audio and returns whether capturing was started successfully. Fails while an asynchronous
+     * device change is pending, the change starts the stream itself.
      * @param bSuccess True if capturing was started successfully.
      */
     UFUNCTION(BlueprintCallable, Category = "Odin|Audio Capture")
     void StartCapturing(bool& bSuccess);
 
+    /**
+     * @brief Stops Capturing Audio. While an asynchronous device change is pending, the stream is stopped once the change
+     * completed. Prefer this over StopCapturingAudio, which does not wait for a pending change.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Capture")
+    void StopCapturing();
+
     /**
      * @brief Updates the capture device and restarts the capture stream of the Audio Capture
-     * object. Only usable in GameThread.
+     * object. Only usable in GameThread. Fails while an asynchronous device change is pending.
      *
      * IMPORTANT! Should not be used in tick or on a regular basis because it could lead to
      * stuttering.
@@ -107,21 +233,75 @@ class ODIN_API UOdinAudioCapture : public UAudioCapture, public FTickableGameObj
 
     /**
      * @brief Get whether the stream is currently open. Only usable in GameThread.
-     * @return Returns true if capturing audio
+     * @return Returns true if capturing audio, false while an asynchronous device change is pending
      */
     UFUNCTION(BlueprintPure, Category = "Odin|Audio Capture")
     bool IsStreamOpen() const;
 
     /**
      * @brief Get the stream time of the audio capture stream. Only usable in GameThread.
-     * @return Time the stream was active.
+     * @return Time the stream was active, 0 while an asynchronous device change is pending.
      */
     UFUNCTION(BlueprintPure, Category = "Odin|Audio Capture")
     float GetStreamTime() const;
 
+    /**
+     * @brief Sets the capture buffer duration requested on the next stream (re)start.
+     * @param NewCaptureLatency requested buffer duration
+     */
+    UFUNCTION(BlueprintSetter, Category = "Odin|Audio Capture")
+    void SetCaptureLatency(EOdinCaptureLatency NewCaptureLatency);
+
+    /**
+     * @brief Gets the capture buffer duration requested from the platform.
+     */
+    UFUNCTION(BlueprintGetter, Category = "Odin|Audio Capture")
+    EOdinCaptureLatency GetCaptureLatency() const;
+
+    /**
+     * @brief Number of frames per capture callback the platform actually delivers. Can differ from
+     * the requested CaptureLatency, since devices are free to choose their own buffer size.
+     * @return frames of the latest capture callback or 0 if nothing was captured yet
+     */
+    UFUNCTION(BlueprintPure, Category = "Odin|Audio Capture")
+    int32 GetMeasuredCaptureBufferFrames() const;
+
+    /**
+     * @brief Duration of the latest capture callback buffer in milliseconds.
+     * @return measured buffer duration or 0 if nothing was captured yet
+     */
+    UFUNCTION(BlueprintPure, Category = "Odin|Audio Capture")
+    float GetMeasuredCaptureBufferMs() const;
+
+    /**
+     * @brief Capture timing statistics of the current capture device. Usable from any thread.
+     * @return overflow counts and jitter of the device
+     */
+    UFUNCTION(BlueprintPure, Category = "Odin|Audio Capture")
+    FOdinCaptureStats GetCaptureStats() const;
+
+    /**
+     * @brief Capture timing statistics of a device that was used by this capture object before.
+     * @param DeviceId id of the device, empty for the default device
+     * @param OutStats receives the statistics
+     * @return true if the device was used
+     */
+    UFUNCTION(BlueprintPure, Category = "Odin|Audio Capture")
+    bool GetCaptureStatsForDevice(const FString& DeviceId, FOdinCaptureStats& OutStats) const;
+
+    /**
+     * @brief Number of frames a capture buffer of the given duration holds. Frames are per channel,
+     * so this does not depend on the channel count of the device.
+     * @param SampleRate sample rate of the capture device
+     * @param Latency buffer duration
+     * @return number of frames
+     */
+    static int32 GetNumFramesForLatency(int32 SampleRate, EOdinCaptureLatency Latency)
+    { return SampleRate * static_cast<int32>(Latency) / 1000; }
+
     /**
      * @brief Restart the stream, using CurrentSelectedDeviceIndex as the new capture device. Only
-     * usable in GameThread.
+     * usable in GameThread. Fails while an asynchronous device change is pending.
      */
     UFUNCTION(BlueprintCallable, Category = "Odin|Audio Capture")
     bool RestartCapturing(bool bAutomaticallyStartCapture = true);
@@ -135,13 +315,32 @@ class ODIN_API UOdinAudioCapture : public UAudioCapture, public FTickableGameObj
 
     /**
      * Sets automatic recognition of capture device disconnects (i.e. if a capture device was
-     * removed). Can accidentally recognize disconnects if app experiences large frame times
-     * (greater than AllowedTimeWithoutStreamUpdate value)
+     * removed). Disconnects are detected by a background watchdog and do not depend on the
+     * frame rate.
      * @param bTryRecognizing New value for whether automatic recognition of disconnects is active.
      */
     UFUNCTION(BlueprintInternalUseOnly, BlueprintCallable, Category = "Odin|Audio Capture")
     void SetTryRecognizingDeviceDisconnected(bool bTryRecognizing);
 
+    /**
+     * Registers a native sink, which receives every captured block directly on the capture thread. A sink is only
+     * registered once, the capture object keeps it alive until it is removed.
+     * @param Sink   native capture consumer
+     */
+    void AddCaptureSink(FOdinCaptureSinkPtr Sink);
+    /**
+     * Removes a previously registered native sink. After this returns the sink will not be invoked anymore.
+     * @param Sink   native capture consumer
+     * @return true if the sink was registered
+     */
+    bool RemoveCaptureSink(const FOdinCaptureSinkPtr& Sink);
+    /**
+     * Lets a registered sink reallocate its buffers for the format of the current device, e.g. after its settings changed.
+     * The sink is not invoked by the capture thread meanwhile. Only usable in GameThread.
+     * @param Sink   native capture consumer
+     */
+    void PrepareCaptureSink(const FOdinCaptureSinkPtr& Sink);
+
     /**
      * @brief Will be called, if ODIN recognizes that the selected capture device does not supply
      * data anymore, i.e. if a microphone was unplugged. ODIN will wait for
@@ -157,6 +356,13 @@ class ODIN_API UOdinAudioCapture : public UAudioCapture, public FTickableGameObj
     UPROPERTY(BlueprintAssignable, Category = "Odin|Audio Capture")
     FCaptureDeviceChange OnDefaultDeviceChanged;
 
+    /**
+     * @brief Will be called, if the system reported an added, removed or changed audio device. The
+     * cached device list is enumerated again on next access.
+     */
+    UPROPERTY(BlueprintAssignable, Category = "Odin|Audio Capture")
+    FCaptureDeviceChange OnCaptureDevicesChanged;
+
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FCaptureDeviceChangedWithDetails, const FOdinCaptureDeviceInfo&, PreviousDevice, const FOdinCaptureDeviceInfo&,
                                                  NewDevice);
 
@@ -166,41 +372,52 @@ class ODIN_API UOdinAudioCapture : public UAudioCapture, public FTickableGameObj
     UPROPERTY(BlueprintAssignable, Category = "Odin|Audio Capture")
     FCaptureDeviceChangedWithDetails OnCaptureDeviceChanged;
 
-#pragma region FTickableGameObject
-    virtual void Tick(float DeltaTime) override;
-
-    virtual bool IsTickable() const override;
-
-    virtual ETickableTickType GetTickableTickType() const override
-    { return ETickableTickType::Conditional; }
-
-    virtual TStatId GetStatId() const override
-    { RETURN_QUICK_DECLARE_CYCLE_STAT(UOdinAudioCapture, STATGROUP_Tickables); }
-
-    virtual bool IsTickableWhenPaused() const override
-    { return true; }
-
-    virtual bool IsTickableInEditor() const override
-    { return false; }
-#pragma endregion
-
   protected:
     virtual void BeginDestroy() override;
     virtual void PostInitProperties() override;
 
     void HandleDefaultDeviceChanged(EAudioDeviceChangedRole AudioDeviceChangedRole, FString DeviceId);
+    void HandleDeviceListChanged(FString DeviceId);
+    /**
+     * Called on the game thread after the watchdog detected a stalled capture stream, restarts capturing
+     * asynchronously with the Default Device.
+     */
+    void HandleCaptureStalled();
+    void HandleDeviceStateChanged(FString DeviceId, EAudioDeviceChangedState NewState);
+    void InvalidateCaptureDevices();
 
     /**
-     * @brief Actual capture device implementation. Will take a device check function as input.
-     * This function should take a FOdinCaptureDeviceInfo as input and return a bool. It should
-     * return true, if the input is the device we'd like to change to.
+     * Identifies a capture device by id or, if DeviceName is set, by name. An empty query refers to the Default Device.
+     * Asynchronous changes take the buffer duration from the query, as CaptureLatency may only be read on the game thread.
+     */
+    struct FCaptureDeviceQuery {
+        FString             DeviceId;
+        FName               DeviceName;
+        EOdinCaptureLatency CaptureLatency = EOdinCaptureLatency::Latency_20ms;
+
+        bool IsDefaultDevice() const
+        { return DeviceId.IsEmpty() && DeviceName.IsNone(); }
+    };
+
+    /**
+     * @brief Actual capture device implementation. Looks up the queried device in the cached device
+     * list and restarts the capture stream with it.
      *
-     * @tparam DeviceCheck Function taking a FOdinCaptureDeviceInfo as input and returning bool.
-     * @param DeviceCheckFunction This is used to check, whether the currently looked at device is
-     * the device we'd like to change to.
+     * @param Query The device we'd like to change to.
      * @return True, if the device was changed successfully
      */
-    template <typename DeviceCheck> bool ChangeCaptureDevice(const DeviceCheck& DeviceCheckFunction);
+    bool ChangeCaptureDevice(const FCaptureDeviceQuery& Query);
+
+    /**
+     * Enumerates the platform devices into the cache, if it was invalidated or if forced. May run on any thread.
+     * @return true if the cache was updated
+     */
+    bool UpdateCaptureDeviceCache(bool bForce);
+    /**
+     * Looks up a device in the cache, updating the cache first if it was invalidated. May run on any thread.
+     * @return true if the device was found
+     */
+    bool FindCaptureDevice(const FCaptureDeviceQuery& Query, int32& OutDeviceIndex, FOdinCaptureDeviceInfo& OutDevice);
 
     void InitializeGenerator();
 
@@ -209,6 +426,51 @@ class ODIN_API UOdinAudioCapture : public UAudioCapture, public FTickableGameObj
 
     void TryRetrieveDefaultDevice();
 
+    /**
+     * Result of a device change prepared on a background task and applied on the game thread.
+     */
+    struct FCaptureDeviceChangeResult {
+        bool                   bSuccess         = false;
+        bool                   bStreamReopened  = false;
+        bool                   bIsDefaultDevice = false;
+        int32                  DeviceIndex      = INDEX_NONE;
+        FOdinCaptureDeviceInfo Device;
+    };
+
+    /**
+     * Starts an asynchronous device change.
+     * @param Query the device to change to
+     * @param bForceReopen reopen the stream even if the device is already selected
+     * @param OnChangeCompleted executed on the game thread once the change is completed
+     */
+    void RunAsyncCaptureDeviceChange(FCaptureDeviceQuery Query, bool bForceReopen, FChangeCaptureDeviceDelegate OnChangeCompleted);
+    /**
+     * Resolves the targeted device and reopens the stream without starting it, so the generator can take the format of the
+     * new device first. Does not touch any UPROPERTY and may run on any thread.
+     */
+    FCaptureDeviceChangeResult ReopenCaptureStream(const FCaptureDeviceQuery& Query, bool bForceReopen, const FString& CurrentDeviceId);
+    void CompleteCaptureDeviceChange(const FCaptureDeviceChangeResult& Result, FChangeCaptureDeviceDelegate OnChangeCompleted);
+
+    /**
+     * Opens the capture stream on the given device. May run on any thread.
+     * @param Latency requested buffer duration, snapshot of CaptureLatency taken on the game thread
+     * @return true if the stream was opened
+     */
+    bool OpenCaptureStream(int32 DeviceIndex, const FOdinCaptureDeviceInfo& Device, EOdinCaptureLatency Latency);
+    /**
+     * Enumerates the platform capture devices without a thread check.
+     */
+    void EnumerateCaptureDevices(TArray<FOdinCaptureDeviceInfo>& OutDevices);
+
+    /**
+     * Passes a captured block on to the native capture sinks and the generator delegates.
+     */
+    void DispatchCapturedAudio(const float* AudioData, int32 NumFrames, int32 InNumChannels, int32 InSampleRate, const FOdinCaptureBlockInfo& BlockInfo);
+    /**
+     * Emits silence for the time the capture stream was down while reopening, capped by MaxCaptureGapFillSeconds.
+     */
+    void FillCaptureGap(int32 BlockFrames, int32 InNumChannels, int32 InSampleRate);
+
     /**
      * Handles the audio generation logic triggered by the native Audio Capture Implementation
      * callback.
@@ -216,8 +478,21 @@ class ODIN_API UOdinAudioCapture : public UAudioCapture, public FTickableGameObj
      * @param AudioData Pointer to the raw audio data buffer.
      * @param NumFrames Number of audio frames in the buffer.
      * @param InNumChannels Number of channels in the audio stream.
+     * @param InSampleRate Sample rate of the audio stream.
+     * @param StreamTime Stream time of the block reported by the device.
+     * @param bOverFlow Whether the device lost audio before this block.
+     */
+    void OnCaptureCallback(const float* AudioData, int32 NumFrames, int32 InNumChannels, int32 InSampleRate, double StreamTime, bool bOverFlow);
+
+    /**
+     * Updates overflow, discontinuity and jitter statistics with a block received from the device.
+     */
+    void RecordCaptureTiming(const FOdinCaptureBlockInfo& BlockInfo, int32 NumFrames, int32 InSampleRate);
+    /**
+     * Stores the statistics of the previous device and continues with the statistics of the given device.
      */
-    void OnCaptureCallback(const float* AudioData, int32 NumFrames, int32 InNumChannels);
+    void BeginCaptureStats(const FString& DeviceId);
+    FOdinCaptureStats SnapshotCaptureStats() const;
 
     /**
      * @brief The index of the currently selected device. -1 and 0 both refer to the Default Device.
@@ -239,10 +514,23 @@ class ODIN_API UOdinAudioCapture : public UAudioCapture, public FTickableGameObj
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Odin|Audio Capture")
     float AllowedTimeForStreamSetup = 3.0f;
 
+    /**
+     * @brief The capture buffer duration requested from the platform, applied on the next stream
+     * (re)start.
+     */
+    UPROPERTY(EditAnywhere, BlueprintGetter = GetCaptureLatency, BlueprintSetter = SetCaptureLatency, Category = "Odin|Audio Capture")
+    EOdinCaptureLatency CaptureLatency = EOdinCaptureLatency::Latency_20ms;
+
+    /**
+     * @brief The maximum amount of silence in seconds, which is emitted to bridge the gap while the capture stream is
+     * reopened asynchronously.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Odin|Audio Capture", meta = (ClampMin = "0.0"))
+    float MaxCaptureGapFillSeconds = 0.5f;
+
     /**
      * Activates / Decativates automatically trying to recognize, if a capture device was removed or
-     * not. Can accidentally recognize disconnects if app experiences large frame times (greater
-     * than AllowedTimeWithoutStreamUpdate value).
+     * not. Recognition runs on a background watchdog, independent of the frame rate.
      */
     UPROPERTY(BlueprintGetter = GetTryRecognizingDeviceDisconnected, BlueprintSetter = SetTryRecognizingDeviceDisconnected, Category = "Odin|Audio Capture")
     bool bTryRecognizingDeviceDisconnect = true;
@@ -262,7 +550,42 @@ class ODIN_API UOdinAudioCapture : public UAudioCapture, public FTickableGameObj
     UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Capture")
     FOdinCaptureDeviceInfo CurrentSelectedDevice;
 
-    double          LastStreamTime            = -1.0f;
-    double          TimeWithoutStreamUpdate   = 0.0f;
+    // while set, a background task owns AudioCapture and the game thread must not use it
     FThreadSafeBool IsCurrentlyChangingDevice = false;
+    // StopCapturing was called during an asynchronous device change, game thread only
+    bool bStopAfterDeviceChange = false;
+
+    TUniquePtr<FOdinCaptureWatchdog> Watchdog;
+
+    FCriticalSection            CaptureSinksCS;
+    TArray<FOdinCaptureSinkPtr> CaptureSinks;
+
+    mutable FCriticalSection       CaptureDeviceCacheCS;
+    TArray<FOdinCaptureDeviceInfo> CachedCaptureDevices;
+    TMap<FString, int32>           CachedDeviceIndexById;
+    TMap<FName, int32>             CachedDeviceIndexByName;
+    std::atomic<uint32>            CaptureDeviceCacheVersion = 0;
+    std::atomic<bool>              bCaptureDeviceCacheDirty  = true;
+
+    TFuture<void>     PendingDeviceChange;
+    std::atomic<bool> bFillCaptureGap = false;
+
+    std::atomic<int32> MeasuredBufferFrames     = 0;
+    std::atomic<int32> MeasuredBufferSampleRate = 0;
+
+    std::atomic<uint64> CaptureBlockCount         = 0;
+    std::atomic<uint64> CaptureOverflowCount      = 0;
+    std::atomic<uint64> CaptureDiscontinuityCount = 0;
+    std::atomic<float>  CaptureJitterMs           = 0.0f;
+    std::atomic<float>  CaptureMaxJitterMs        = 0.0f;
+
+    mutable FCriticalSection         CaptureStatsCS;
+    FString                          CaptureStatsDeviceId;
+    TMap<FString, FOdinCaptureStats> CaptureStatsByDevice;
+
+    // capture thread only
+    TArray<float> CaptureGapSilence;
+    double        LastCaptureReceiveTime  = 0.0;
+    double        LastCaptureStreamTime   = 0.0;
+    double        LastCaptureBlockSeconds = 0.0;
 };
\ No newline at end of file
@@ -3,8 +3,19 @@
 #include "CoreMinimal.h"
 #include "HAL/Runnable.h"
 #include "HAL/ThreadSafeBool.h"
+#include "Containers/CircularQueue.h"
 #include "Containers/Queue.h"
 #include "odin.h"
+#include "OdinCaptureSink.h"
+
+#include <atomic>
+
+/**
+ * Sample buffers the push thread hands back to a producer once their audio was pushed, so producers on a steady cadence
+ * reuse their allocations. The push thread is the only writer and the producer the only reader.
+ */
+typedef TCircularQueue<TArray<float>>                         FOdinAudioBufferPool;
+typedef TSharedPtr<FOdinAudioBufferPool, ESPMode::ThreadSafe> FOdinAudioBufferPoolPtr;
 
 /**
  * @class FOdinAudioPushDataThread
@@ -22,6 +33,13 @@ class FOdinAudioPushDataThread : public FRunnable
      * @param TargetRoom A pointer to the target room object.
      */
     void LinkEncoder(OdinEncoder* Encoder, OdinRoom* TargetRoom);
+    /**
+     * Links an encoder without a room. Queued audio is pushed into the encoder like for a linked room, but its datagrams
+     * are left to the owner, e.g. for encoders popped through UOdinEncoder::Pop.
+     *
+     * @param Encoder A pointer to the encoder object.
+     */
+    void LinkEncoderWithoutRoom(OdinEncoder* Encoder);
     /**
      * Unlinks an encoder from its associated room by using the encoder's handle.
      *
@@ -35,27 +53,90 @@ class FOdinAudioPushDataThread : public FRunnable
      *
      * @param TargetEncoder The encoder to which the audio data belongs.
      * @param Audio The audio data buffer to be processed.
+     * @param BlockInfo Capture timing of the audio, if it was captured from a device.
+     * @param ReturnPool Optional pool the emptied audio buffer is returned to after it was pushed.
+     */
+    void PushAudioToEncoder(OdinEncoder* TargetEncoder, TArray<float>&& Audio, const FOdinCaptureBlockInfo& BlockInfo = FOdinCaptureBlockInfo(),
+                            const FOdinAudioBufferPoolPtr& ReturnPool = nullptr);
+
+    /**
+     * Capture timing of the blocks pushed to encoders. Overflows are reported by the capture device, while the queue delay
+     * covers the time between receiving a block from the device and pushing it into the encoder inside the plugin.
      */
-    void PushAudioToEncoder(OdinEncoder* TargetEncoder, TArray<float>&& Audio);
+    struct FOdinPushStats {
+        uint64 NumPushedBlocks   = 0;
+        uint64 NumOverflowBlocks = 0;
+        uint64 NumGapFillBlocks  = 0;
+        float  MeanQueueDelayMs  = 0.0f;
+        float  MaxQueueDelayMs   = 0.0f;
+        double LastStreamTime    = 0.0;
+    };
+
+    /**
+     * @return Capture timing statistics of all pushed blocks.
+     */
+    FOdinPushStats GetPushStats() const;
+
+    /**
+     * Hands the room link of an encoder over to a replacement encoder at the next frame boundary. Audio still queued for
+     * the old encoder is redirected to the new one, the remaining datagrams of the old encoder are sent and the old
+     * encoder is freed on the push thread afterwards.
+     *
+     * @param OldEncoder The encoder to retire, ownership is transferred to the push thread on success.
+     * @param NewEncoder The replacement encoder.
+     * @return True if the push thread took over the old encoder; otherwise, false and the caller still owns it.
+     */
+    bool SwapEncoder(OdinEncoder* OldEncoder, OdinEncoder* NewEncoder);
+    /**
+     * Retires an encoder without a replacement, e.g. if a swap was rejected. Everything the encoder already completed is
+     * still sent, frames queued for it afterwards are dropped and it is freed on the push thread after the same grace
+     * period as a swapped encoder. If the push thread is not running, the encoder is freed immediately.
+     *
+     * @param Encoder The encoder to retire, ownership is transferred to the push thread.
+     */
+    void RetireEncoder(OdinEncoder* Encoder);
 
     virtual uint32 Run() override;
     virtual void   Exit() override;
 
   private:
+    void        StartThread();
     void        CleanupLinks();
+    void        ApplyEncoderSwaps(TArray<uint8>& DatagramBuffer);
+    void        ReleaseRetiredEncoders(bool bForce);
     void        PushQueuedAudio();
+    void        RecordPushedBlock(const FOdinCaptureBlockInfo& BlockInfo);
     void        PopAllEncoders(TArray<uint8>& DatagramBuffer);
     static void SendDatagramToRoom(OdinRoom* TargetRoom, TArray<uint8>& DatagramBuffer, uint32 NumSamples);
 
     struct FOdinEncoderAudioFrame {
-        OdinEncoder*  EncoderHandle;
-        TArray<float> Audio;
+        OdinEncoder*            EncoderHandle;
+        TArray<float>           Audio;
+        FOdinCaptureBlockInfo   BlockInfo;
+        FOdinAudioBufferPoolPtr ReturnPool;
+    };
+
+    struct FOdinEncoderSwap {
+        OdinEncoder* OldEncoder;
+        OdinEncoder* NewEncoder;
+        int32        GraceCycles;
     };
 
     TQueue<FOdinEncoderAudioFrame, EQueueMode::Mpsc> AudioPushQueue;
+    TQueue<FOdinEncoderSwap, EQueueMode::Mpsc>       EncoderSwapQueue;
+    // push thread only, retired encoders keep redirecting late frames until their grace cycles ran out
+    TArray<FOdinEncoderSwap> RetiredEncoders;
+
+    std::atomic<uint64> NumPushedBlocks   = 0;
+    std::atomic<uint64> NumOverflowBlocks = 0;
+    std::atomic<uint64> NumGapFillBlocks  = 0;
+    std::atomic<float>  MeanQueueDelayMs  = 0.0f;
+    std::atomic<float>  MaxQueueDelayMs   = 0.0f;
+    std::atomic<double> LastStreamTime    = 0.0;
 
     FCriticalSection              EncoderRoomLinkCS;
     TMap<OdinEncoder*, OdinRoom*> EncoderRoomLinks;
+    TSet<OdinEncoder*>            EncodersWithoutRoom;
     FThreadSafeBool               bIsRunning;
     TUniquePtr<FRunnableThread>   Thread;
     FEvent*                       PushEvent;
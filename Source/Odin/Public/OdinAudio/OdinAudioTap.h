@@ -0,0 +1,81 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DSP/Dsp.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+
+#include <atomic>
+
+/**
+ * @class FOdinAudioTap
+ *
+ * Receives copies of decoded audio on the render thread and hands them to a consumer on a background thread.
+ * The render thread only copies into a preallocated single-producer/single-consumer ring and never waits on the consumer.
+ * If the consumer falls behind, blocks that do not fit into the ring are dropped and counted as overflow.
+ */
+class ODIN_API FOdinAudioTap : public FRunnable
+{
+  public:
+    /**
+     * Called on the tap thread with a batch of interleaved samples.
+     */
+    typedef TFunction<void(TArrayView<const float> Samples, int32 NumChannels, int32 SampleRate)> FOdinAudioTapConsumer;
+
+    /**
+     * @param InConsumer Function invoked on the tap thread with all samples drained from the ring.
+     * @param InCapacityInSamples Size of the ring in interleaved samples, one second of stereo 48 kHz audio by default.
+     * @param InDrainIntervalMs Interval in which the tap thread drains the ring.
+     */
+    explicit FOdinAudioTap(FOdinAudioTapConsumer InConsumer, int32 InCapacityInSamples = 96000, float InDrainIntervalMs = 10);
+    virtual ~FOdinAudioTap() override;
+
+    /**
+     * Starts the tap thread. Samples written before the tap was started are kept until the ring is full.
+     */
+    void Start();
+
+    /**
+     * Copies a block of decoded audio into the ring. Safe to call from the render thread, never blocks.
+     * @param Samples interleaved float buffer
+     * @param NumSamples number of interleaved samples
+     * @param InNumChannels channels of the interleaved buffer
+     * @param InSampleRate sample rate of the buffer
+     * @return true if the block was written, false if it was dropped due to overflow
+     */
+    bool Write(const float* Samples, int32 NumSamples, int32 InNumChannels, int32 InSampleRate);
+
+    /**
+     * @return Number of samples dropped because the consumer did not keep up.
+     */
+    uint64 GetNumOverflowedSamples() const
+    { return NumOverflowedSamples.load(std::memory_order_relaxed); }
+
+    /**
+     * @return Number of samples written into the ring.
+     */
+    uint64 GetNumWrittenSamples() const
+    { return NumWrittenSamples.load(std::memory_order_relaxed); }
+
+    virtual uint32 Run() override;
+    virtual void   Exit() override;
+
+  private:
+    void Drain();
+
+    FOdinAudioTapConsumer              Consumer;
+    Audio::TCircularAudioBuffer<float> Ring;
+    TArray<float>                      DrainBuffer;
+
+    std::atomic<int32>  NumChannels          = 1;
+    std::atomic<int32>  SampleRate           = 48000;
+    std::atomic<uint64> NumOverflowedSamples = 0;
+    std::atomic<uint64> NumWrittenSamples    = 0;
+
+    FThreadSafeBool             bIsRunning;
+    TUniquePtr<FRunnableThread> Thread;
+    FEvent*                     DrainEvent;
+    float                       DrainIntervalMs;
+};
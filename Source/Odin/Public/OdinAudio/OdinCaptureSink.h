@@ -0,0 +1,62 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Timing information of a single captured block, carried along with the audio into the encoder queue.
+ */
+struct FOdinCaptureBlockInfo {
+    /**
+     * Stream time in seconds reported by the capture device for this block, 0 for blocks not coming from a device.
+     */
+    double StreamTime = 0.0;
+    /**
+     * Platform time in seconds at which the block was received from the device.
+     */
+    double ReceiveTime = 0.0;
+    /**
+     * The device reported an overflow, i.e. audio was lost inside the driver before this block.
+     */
+    bool bOverflow = false;
+    /**
+     * The block is silence emitted by the plugin to bridge a gap while the capture stream was reopened.
+     */
+    bool bGapFill = false;
+};
+
+/**
+ * @class IOdinCaptureSink
+ *
+ * Native consumer of captured audio, registered directly on a UOdinAudioCapture. Sinks are invoked on the capture thread
+ * for every block delivered by the platform capture stream, before the UAudioGenerator delegates are notified.
+ * Implementations must not touch UObjects and should avoid locking or allocating in OnCapturedAudio.
+ */
+class ODIN_API IOdinCaptureSink
+{
+  public:
+    virtual ~IOdinCaptureSink() = default;
+
+    /**
+     * Called on the capture thread with a block of captured audio.
+     * @param AudioData interleaved samples
+     * @param NumFrames number of frames in AudioData
+     * @param NumChannels number of interleaved channels
+     * @param SampleRate sample rate of the capture stream
+     * @param BlockInfo stream time and overflow state of the block
+     */
+    virtual void OnCapturedAudio(const float* AudioData, int32 NumFrames, int32 NumChannels, int32 SampleRate, const FOdinCaptureBlockInfo& BlockInfo) = 0;
+
+    /**
+     * Called before the capture stream is opened and when the sink is registered or refreshed. No block is delivered to
+     * the sink while this runs, so buffers depending on the stream format are allocated here instead of on the capture
+     * thread.
+     * @param NumChannels number of interleaved channels of the stream
+     * @param SampleRate sample rate of the stream
+     */
+    virtual void PrepareCapture(int32 NumChannels, int32 SampleRate)
+    {}
+};
+
+typedef TSharedPtr<IOdinCaptureSink, ESPMode::ThreadSafe> FOdinCaptureSinkPtr;
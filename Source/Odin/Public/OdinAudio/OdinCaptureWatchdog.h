@@ -0,0 +1,77 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+
+#include <atomic>
+
+/**
+ * @class FOdinCaptureWatchdog
+ *
+ * Detects stalled capture streams, e.g. after a microphone was unplugged. The capture callback only stores an atomic
+ * timestamp, a low frequency background thread compares it against the allowed timeouts and invokes the stall handler
+ * once per armed stream. Detection is therefore independent of the game thread tick rate.
+ */
+class ODIN_API FOdinCaptureWatchdog : public FRunnable
+{
+  public:
+    /**
+     * Called on the watchdog thread once a stall was detected. The watchdog is disarmed before the handler is invoked.
+     */
+    typedef TFunction<void()> FOdinCaptureStallHandler;
+
+    /**
+     * @param InStallHandler Function invoked on the watchdog thread if the armed stream stalls.
+     * @param InCheckIntervalMs Interval in which the watchdog thread checks the stream.
+     */
+    explicit FOdinCaptureWatchdog(FOdinCaptureStallHandler InStallHandler, float InCheckIntervalMs = 250);
+    virtual ~FOdinCaptureWatchdog() override;
+
+    /**
+     * Starts watching a newly opened stream, starting the watchdog thread on first use.
+     * @param InStallTimeoutSeconds allowed time without a capture callback
+     * @param InSetupTimeoutSeconds additional time a freshly opened stream may take until the first callback
+     */
+    void Arm(float InStallTimeoutSeconds, float InSetupTimeoutSeconds);
+
+    /**
+     * Stops watching the stream until it is armed again.
+     */
+    void Disarm();
+
+    /**
+     * Stores the time of the latest capture callback. Safe to call from the capture thread, never blocks.
+     */
+    void NotifyCallback()
+    { LastCallbackTime.store(FPlatformTime::Seconds(), std::memory_order_relaxed); }
+
+    /**
+     * @return Platform time in seconds of the latest capture callback or 0 if there was none yet.
+     */
+    double GetLastCallbackTime() const
+    { return LastCallbackTime.load(std::memory_order_relaxed); }
+
+    virtual uint32 Run() override;
+    virtual void   Exit() override;
+
+  private:
+    void Check();
+
+    FOdinCaptureStallHandler StallHandler;
+
+    std::atomic<double> LastCallbackTime    = 0.0;
+    std::atomic<double> ArmedTime           = 0.0;
+    std::atomic<float>  StallTimeoutSeconds = 1.0f;
+    std::atomic<float>  SetupTimeoutSeconds = 3.0f;
+    std::atomic<bool>   bIsArmed            = false;
+
+    FCriticalSection            StartCS;
+    FThreadSafeBool             bIsRunning;
+    TUniquePtr<FRunnableThread> Thread;
+    FEvent*                     CheckEvent;
+    float                       CheckIntervalMs;
+};
@@ -5,6 +5,7 @@
 #include "HAL/ThreadSafeBool.h"
 #include "Containers/Queue.h"
 #include "odin.h"
+#include "OdinAudio/OdinDecoderState.h"
 
 typedef TPair<OdinRoom*, uint32> FDecoderIdentifier;
 
@@ -19,8 +20,9 @@ class FOdinDatagramProcessingThread : public FRunnable
      * @param DecoderHandle The decoder to link.
      * @param TargetRoom The room the peer belongs to.
      * @param PeerId The unique identifier of the peer.
+     * @param DecoderState Optional state of the decoder, updated after each datagram pushed to the decoder.
      */
-    void LinkDecoderToPeer(OdinDecoder* DecoderHandle, OdinRoom* TargetRoom, const uint32 PeerId);
+    void LinkDecoderToPeer(OdinDecoder* DecoderHandle, OdinRoom* TargetRoom, const uint32 PeerId, const FOdinDecoderStatePtr& DecoderState = nullptr);
 
     /**
      * Removes a decoder from all peer associations.
@@ -28,6 +30,20 @@ class FOdinDatagramProcessingThread : public FRunnable
      */
     void UnlinkDecoder(const OdinDecoder* DecoderHandle);
 
+    /**
+     * Replaces a decoder in all of its peer associations, e.g. after it was recreated with a new format.
+     * @param OldHandle The decoder to replace.
+     * @param NewHandle The decoder taking over the peer associations.
+     */
+    void SwapDecoderHandle(const OdinDecoder* OldHandle, OdinDecoder* NewHandle);
+
+    /**
+     * Frees a decoder that was replaced by SwapDecoderHandle once the thread finished pushing to it. Targets copied
+     * before the swap are only used until the end of the current processing pass, the handle is freed after it.
+     * @param DecoderHandle The replaced decoder, no longer linked to any peer.
+     */
+    void RetireDecoderHandle(OdinDecoder* DecoderHandle);
+
     /**
      * Retrieves all decoders currently associated with a specific peer in a room.
      * @param TargetRoom The room the peer belongs to.
@@ -50,6 +66,10 @@ class FOdinDatagramProcessingThread : public FRunnable
     virtual void   Exit() override;
 
   private:
+    typedef TPair<OdinDecoder*, FOdinDecoderStatePtr> FDecoderTarget;
+    void GetDecoderTargetsFor(OdinRoom* TargetRoom, uint32 PeerId, TArray<FDecoderTarget>& OutTargets) const;
+    void FreeRetiredDecoders();
+
     struct FOdinDatagramEvent {
         OdinRoom*     Handle;
         uint32        PeerId;
@@ -60,8 +80,10 @@ class FOdinDatagramProcessingThread : public FRunnable
 
     mutable FCriticalSection                     DecoderHandlesCS;
     TMap<FDecoderIdentifier, TSet<OdinDecoder*>> RegisteredDecoderHandles;
+    TMap<const OdinDecoder*, FOdinDecoderStatePtr> DecoderStates;
 
     TQueue<FOdinDatagramEvent, EQueueMode::Mpsc> DatagramQueue;
+    TQueue<OdinDecoder*, EQueueMode::Mpsc>        RetiredDecoders;
 
     FThreadSafeBool             bIsRunning;
     TUniquePtr<FRunnableThread> Thread;
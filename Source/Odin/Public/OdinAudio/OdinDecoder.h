@@ -10,10 +10,44 @@
 #include "OdinCore/include/odin.h"
 #include "OdinNative/OdinNativeHandle.h"
 #include "OdinNative/OdinNativeBlueprint.h"
+#include "OdinAudio/OdinDecoderState.h"
 #include "UObject/StrongObjectPtr.h"
 
 #include "OdinDecoder.generated.h"
 
+/**
+ * Playout statistics of a decoder, used to tune network buffering.
+ */
+USTRUCT(BlueprintType)
+struct ODIN_API FOdinDecoderPlayoutStats {
+    GENERATED_BODY()
+
+    /** Number of pop calls on the decoder. */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|Stats")
+    int64 Pops = 0;
+    /** Number of pops that returned no data. */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|Stats")
+    int64 Underruns = 0;
+    /** Number of pops that produced audible audio without received audio left to play. */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|Stats")
+    int64 ConcealedFrames = 0;
+    /** Number of samples delivered by the decoder. */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|Stats")
+    int64 DeliveredSamples = 0;
+    /** Number of delivered samples without real audio data. */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|Stats")
+    int64 SilentSamples = 0;
+    /** Number of voice packets pushed into the decoder. */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|Stats")
+    int64 ReceivedPackets = 0;
+    /** Share of delivered samples without real audio data, between 0 and 1. */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|Stats")
+    float SilenceRatio = 0.0f;
+    /** Received audio that was not played yet, in milliseconds. */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|Stats")
+    float BufferedMs = 0.0f;
+};
+
 /**
  * Represents a decoder for media streams from remote voice chat clients, which encapsulates all
  * the components required to process incoming audio streams.
@@ -47,6 +81,18 @@ class ODIN_API UOdinDecoder : public UObject
               Category = "Odin|Audio Pipeline")
     static UOdinDecoder *ConstructDecoder(UObject *WorldContextObject, int32 SampleRate = 48000, bool bUseStereo = false);
 
+    /**
+     * Create uobject decoder matching the sample rate of the active audio device. The decoder follows the device format and is
+     * recreated in place whenever a new audio device becomes active, so playback is never resampled twice.
+     * @param WorldContextObject   context lifetime object, used to resolve the audio device of its world
+     * @param bUseStereo   channels interleaved, only applied if the audio device has at least two output channels
+     * @return uobject decoder or null
+     */
+    UFUNCTION(BlueprintCallable,
+              meta     = (DisplayName = "Construct Decoder For Audio Device", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"),
+              Category = "Odin|Audio Pipeline")
+    static UOdinDecoder *ConstructDecoderForAudioDevice(UObject *WorldContextObject, bool bUseStereo = false);
+
     /**
      * Internally Creates a new instance of an ODIN decoder with default settings used to process the remote
      * media stream. Will re-setup
@@ -64,6 +110,30 @@ class ODIN_API UOdinDecoder : public UObject
 
     static bool FreeDecoderInternal(OdinDecoder *DecoderHandle);
 
+    /**
+     * Recreates the internal decoder with a different format while keeping all peer links and registrations intact.
+     * Effects of the pipeline are recreated in the new decoder and keep their UOdinPipeline and effect references. The
+     * old handle is freed by the datagram thread once every listener of OnFormatChangedNative released it.
+     * @param NewSampleRate   samplerate for f32bit
+     * @param bNewStereo   channels interleaved
+     * @return true if the decoder now uses the requested format
+     */
+    bool ReconfigureFormat(int32 NewSampleRate, bool bNewStereo);
+
+    /**
+     * Recreates the internal decoder to match the format of the given world's audio device, see ReconfigureFormat.
+     * @param WorldContextObject   context object to resolve the audio device, falls back to the active device
+     * @return true if the decoder now matches the audio device
+     */
+    bool MatchAudioDeviceFormat(const UObject *WorldContextObject = nullptr);
+
+    DECLARE_MULTICAST_DELEGATE_OneParam(FOdinDecoderFormatChanged, UOdinDecoder *);
+    /**
+     * Invoked on the game thread after the internal decoder was recreated with a new format, before the old handle is freed.
+     * Anything caching the native handle has to drop it while handling this event.
+     */
+    FOdinDecoderFormatChanged OnFormatChangedNative;
+
     /**
      * Returns an object to the pointer of the internal ODIN audio pipeline instance used by the given decoder.
      */
@@ -124,6 +194,52 @@ class ODIN_API UOdinDecoder : public UObject
 
     UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Positions", ToolTip = "Get the positions registered in the decoder"), Category = "Odin|Audio Pipeline")
     TArray<FOdinPosition> GetPositions(FOdinChannelMask ChannelMask) const;
+
+    /**
+     * Copies the positions of the most recently received voice packet from the cache, which is refreshed by the datagram
+     * processing thread. Does not allocate and does not call into the native decoder.
+     * @param OutPositions   receives up to OutPositions.Num() positions
+     * @param InOutVersion   version the caller already knows, updated to the version of the copied positions
+     * @return number of copied positions, or INDEX_NONE if the positions did not change since InOutVersion
+     */
+    int32 GetCachedPositions(TArrayView<FOdinPosition> OutPositions, uint32 &InOutVersion) const;
+
+    /**
+     * Returns the cached positions of the most recently received voice packet if they changed since the given version.
+     * Allows skipping peers whose positions did not change without calling into the native decoder.
+     * @param SinceVersion   version returned by a previous call, 0 to always retrieve the positions
+     * @param Positions   cached positions, only filled if they changed
+     * @param Version   version of the cached positions
+     * @return true if the positions changed since SinceVersion
+     */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Get Cached Positions", ToolTip = "Get the cached positions if they changed since the given version"),
+              Category = "Odin|Audio Pipeline")
+    bool GetCachedPositionsChangedSince(int64 SinceVersion, TArray<FOdinPosition> &Positions, int64 &Version) const;
+
+    /**
+     * Returns the version of the cached positions, which increases every time the positions of received voice packets change.
+     */
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Cached Positions Version"), Category = "Odin|Audio Pipeline")
+    int64 GetCachedPositionsVersion() const;
+
+    /**
+     * Sets the channel mask used to cache positions of received voice packets, all channels by default.
+     */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Set Cached Positions Channel Mask"), Category = "Odin|Audio Pipeline")
+    void SetCachedPositionsChannelMask(FOdinChannelMask InChannelMask);
+    /**
+     * Returns playout statistics of the decoder, accumulated from all pops by synth components and Pop calls.
+     */
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Playout Stats", ToolTip = "Get underrun, concealment and buffering statistics of the decoder"),
+              Category = "Odin|Audio Pipeline|Stats")
+    FOdinDecoderPlayoutStats GetPlayoutStats() const;
+
+    /**
+     * Resets the playout statistics of the decoder.
+     */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Reset Playout Stats"), Category = "Odin|Audio Pipeline|Stats")
+    void ResetPlayoutStats();
+
     /**
      * Retrieves a block of processed audio samples from the decoder's buffer. The samples are
      * interleaved floating-point values in the range[-1, 1] and are written into the provided output buffer.
@@ -154,6 +270,16 @@ class ODIN_API UOdinDecoder : public UObject
     int32 SampleRate = 48000;
     UPROPERTY(BlueprintReadOnly, Category = "Odin")
     bool bStereo = true;
+    /**
+     * If true, the decoder is recreated to match the active audio device whenever the device changes.
+     */
+    UPROPERTY(BlueprintReadWrite, Category = "Odin")
+    bool bFollowAudioDeviceFormat = false;
+    /**
+     * Requested channel layout if the decoder follows the audio device format.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin")
+    bool bPreferStereo = false;
 
     /**
      * Get internal handle
@@ -166,6 +292,12 @@ class ODIN_API UOdinDecoder : public UObject
     TWeakObjectPtr<UOdinHandle> GetHandle() const
     { return Handle; }
 
+    /**
+     * Get the thread-safe state shared with the datagram processing thread
+     */
+    const FOdinDecoderStatePtr &GetState() const
+    { return State; }
+
     /**
      * Replace internal handle object
      * @param NewHandle internal handle
@@ -178,5 +310,8 @@ class ODIN_API UOdinDecoder : public UObject
   private:
     UPROPERTY()
     UOdinHandle *Handle;
+    int32        AudioEventFilter = 0;
+
+    FOdinDecoderStatePtr State;
     static void  HandleOdinAudioEventCallback(OdinDecoder *DecoderHandle, const OdinAudioEvents Events, TWeakObjectPtr<UObject> UserData = nullptr);
 };
\ No newline at end of file
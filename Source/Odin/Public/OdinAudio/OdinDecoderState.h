@@ -0,0 +1,125 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OdinCore/include/odin.h"
+#include "OdinSeqLock.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+#include <atomic>
+
+/**
+ * Thread-safe state of a decoder that is updated by the datagram processing thread and read from any thread without
+ * calling into the native decoder.
+ */
+class ODIN_API FOdinDecoderState
+{
+  public:
+    static constexpr uint32 MaxPositions = 64;
+
+    /**
+     * @param InName name the Insights counters of this decoder are registered under, e.g. Odin/Decoder/<Name>/Underruns
+     */
+    explicit FOdinDecoderState(const FString& InName);
+    ~FOdinDecoderState();
+
+    struct FPositionsSnapshot {
+        uint32       NumPositions = 0;
+        OdinPosition Positions[MaxPositions];
+    };
+
+    struct FPlayoutCounters {
+        /** Number of pop calls on the decoder. */
+        uint64 NumPops = 0;
+        /** Number of pops that returned no data at all. */
+        uint64 NumUnderruns = 0;
+        /** Number of pops that returned audible audio although no received audio was left to play, i.e. packet loss concealment. */
+        uint64 NumConcealedFrames = 0;
+        /** Number of samples handed out to the caller. */
+        uint64 NumDeliveredSamples = 0;
+        /** Number of delivered samples that were silence or filled because of an underrun. */
+        uint64 NumSilentSamples = 0;
+        /** Number of voice packets pushed into the decoder. */
+        uint64 NumReceivedPackets = 0;
+        /** Received audio that was not played yet, in milliseconds. */
+        float BufferedMs = 0.0f;
+    };
+
+    /**
+     * Reads the positions of the most recently pushed voice packet from the native decoder and publishes them if they changed.
+     * Called by the datagram processing thread after each push.
+     * @param Decoder native decoder the datagram was pushed to
+     */
+    void RefreshPositions(OdinDecoder* Decoder);
+
+    /**
+     * Copies the cached positions.
+     * @param OutSnapshot receives the positions
+     * @return version of the copied positions
+     */
+    uint32 ReadPositions(FPositionsSnapshot& OutSnapshot) const
+    { return Positions.Read(OutSnapshot) >> 1; }
+
+    /**
+     * @return version of the cached positions, which increases every time the positions change
+     */
+    uint32 GetPositionsVersion() const
+    { return Positions.GetSequence() >> 1; }
+
+    /**
+     * Sets the channel mask used to query positions from the native decoder, all channels by default.
+     */
+    void SetPositionsChannelMask(uint64 InChannelMask)
+    { PositionsChannelMask.store(InChannelMask, std::memory_order_relaxed); }
+
+    /**
+     * Accounts a voice packet pushed into the decoder. Called by the datagram processing thread.
+     */
+    void RecordPush();
+
+    /**
+     * Accounts a pop of the decoder. Called by every path rendering the decoder, the sound generator and UOdinDecoder::Pop,
+     * which must not pop the same decoder concurrently.
+     * @param Result result of odin_decoder_pop
+     * @param bIsSilent silence flag returned by odin_decoder_pop
+     * @param NumSamples number of interleaved samples requested
+     * @param SampleRate sample rate of the decoder
+     * @param NumChannels channel count of the decoder
+     */
+    void RecordPop(OdinError Result, bool bIsSilent, int32 NumSamples, int32 SampleRate, int32 NumChannels);
+
+    /**
+     * @return snapshot of the playout counters
+     */
+    FPlayoutCounters GetPlayoutCounters() const;
+
+    /**
+     * Resets the playout counters, e.g. when starting a new measurement. The playout cursor is rebased to the audio still
+     * buffered by the next pop, as only the rendering thread may move it.
+     */
+    void ResetPlayoutCounters();
+
+  private:
+    TOdinSeqLock<FPositionsSnapshot> Positions;
+
+    std::atomic<uint64> NumPops             = 0;
+    std::atomic<uint64> NumUnderruns        = 0;
+    std::atomic<uint64> NumConcealedFrames  = 0;
+    std::atomic<uint64> NumDeliveredSamples = 0;
+    std::atomic<uint64> NumSilentSamples    = 0;
+    std::atomic<uint64> NumReceivedPackets  = 0;
+    // Playout cursor in microseconds of received audio, written by the datagram thread and the render thread respectively.
+    std::atomic<uint64> ReceivedAudioUs = 0;
+    std::atomic<uint64> PlayedAudioUs   = 0;
+    std::atomic<bool>   bRebaseCursor   = false;
+    std::atomic<uint64>              PositionsChannelMask = ~static_cast<uint64>(0);
+
+    // per decoder Insights counters, received packets are updated by the datagram thread and the others by the rendering thread
+    TUniquePtr<FCountersTrace::FCounterInt> UnderrunsCounter;
+    TUniquePtr<FCountersTrace::FCounterInt> ConcealedFramesCounter;
+    TUniquePtr<FCountersTrace::FCounterInt> SilentSamplesCounter;
+    TUniquePtr<FCountersTrace::FCounterInt> ReceivedPacketsCounter;
+};
+
+typedef TSharedPtr<FOdinDecoderState, ESPMode::ThreadSafe> FOdinDecoderStatePtr;
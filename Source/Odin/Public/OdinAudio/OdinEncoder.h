@@ -11,12 +11,21 @@
 #include "HAL/ThreadSafeBool.h"
 #include "OdinNative/OdinNativeBlueprint.h"
 #include "AudioDefines.h"
+#include "OdinCaptureSink.h"
+#include "OdinRemixer.h"
+#include "OdinEncoderAdaptation.h"
+#include "OdinEncoderInputMixer.h"
 #include "OdinEncoder.generated.h"
 
 struct FOdinPosition;
 class UAudioGenerator;
 class UOdinPipeline;
+class UOdinRoom;
+class UOdinAudioCapture;
+class USoundSubmix;
 class FOdinSubmixListener;
+class FOdinEncoderCaptureSink;
+class FOdinAudioPushDataThread;
 
 /**
  * Represents an encoder for local media streams, which encapsulates the components required to
@@ -163,13 +172,131 @@ class ODIN_API UOdinEncoder : public UObject
 
     /**
      * Set and add generator delegate handle for current encoder
-     * @remarks internal use
+     * @remarks internal use. A UOdinAudioCapture generator is consumed through a native capture sink instead of a generator delegate.
      * @param Generator   to add the delegate to
      */
     UFUNCTION(BlueprintCallable, meta = (DisplayName = "Set Audio Generator", ToolTip = "Set the AudioGenerator of an encoder"),
               Category = "Odin|Audio Pipeline")
     void SetAudioGenerator(UAudioGenerator* Generator);
 
+    /**
+     * Enables the push-to-talk gate of the capture sink. While the gate is closed captured audio is neither queued nor
+     * encoded, only the most recent PushToTalkPreRollMs are kept and sent once the gate opens again.
+     * @remarks only applies to encoders fed by an Odin Audio Capture
+     * @param bEnabled true to gate the capture by SetPushToTalkActive
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Capture")
+    void SetPushToTalkEnabled(bool bEnabled);
+
+    /**
+     * Opens or closes the push-to-talk gate, e.g. on key down and key up.
+     * @param bActive true while the player is talking
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Capture")
+    void SetPushToTalkActive(bool bActive);
+
+    /**
+     * Sets the amount of audio kept while the push-to-talk gate is closed, so the first syllable is not clipped.
+     * @param PreRollMs pre-roll duration in milliseconds, 0 disables the pre-roll
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Capture")
+    void SetPushToTalkPreRollMs(int32 PreRollMs);
+
+    /**
+     * @return true if audio is currently transmitted, i.e. push-to-talk is disabled or active
+     */
+    UFUNCTION(BlueprintPure, Category = "Odin|Audio Capture")
+    bool IsTransmitting() const
+    { return !bPushToTalkEnabled || bPushToTalkActive; }
+
+    /**
+     * Starts adapting the encoder to the connection quality of a room. The round-trip time of the room is sampled in the
+     * background and the encoder is replaced by one configured with the matching profile, keeping its pipeline effects,
+     * event handler, positions, capture input and room link. The first profile is applied right away.
+     * @param Room room the encoder is sending to
+     * @param Profiles encoder profiles ordered from best quality to most robust
+     * @param SampleIntervalMs interval in which the connection statistics are sampled
+     * @return true if adaptation was started
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Pipeline")
+    bool StartAdaptiveEncoding(UOdinRoom* Room, const TArray<FOdinEncoderProfile>& Profiles, float SampleIntervalMs = 1000.0f);
+
+    /**
+     * Stops adapting the encoder, the currently active profile stays in use.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Pipeline")
+    void StopAdaptiveEncoding();
+
+    /**
+     * @return index of the active profile passed to StartAdaptiveEncoding or -1 if adaptation is not running
+     */
+    UFUNCTION(BlueprintPure, Category = "Odin|Audio Pipeline")
+    int32 GetActiveEncoderProfileIndex() const;
+
+    /**
+     * @return connection statistics of the latest adaptation sample
+     */
+    UFUNCTION(BlueprintPure, Category = "Odin|Audio Pipeline")
+    FOdinConnectionStats GetAdaptiveConnectionStats() const;
+
+    /**
+     * @return packet loss percentage estimated by the adaptation from the datagram counters, 0 if adaptation is not running.
+     * Diagnostic only, the estimate also moves when remote peers start or stop talking.
+     */
+    UFUNCTION(BlueprintPure, Category = "Odin|Audio Pipeline")
+    float GetAdaptiveLossPerc() const;
+
+    /**
+     * Replaces the encoder by one created with the given codec settings. The new encoder takes over the pipeline effects,
+     * event handler, positions, capture input and room link, the old encoder is retired at the next frame boundary.
+     * @param Profile codec settings of the new encoder
+     * @return true if the encoder was replaced
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Pipeline")
+    bool ApplyEncoderProfile(const FOdinEncoderProfile& Profile);
+
+    /**
+     * Mixes an Odin Audio Capture into this encoder through the input mixer. Use the mixer instead of SetAudioGenerator to
+     * combine several inputs, e.g. microphone and game audio, into one stream.
+     * @param AudioCapture capture to mix in
+     * @param Gain linear gain of the capture
+     * @return id of the mixer source or 0 on failure
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Pipeline|Mixer")
+    int32 AddMixerCaptureSource(UOdinAudioCapture* AudioCapture, float Gain = 1.0f);
+
+    /**
+     * Mixes the output of a sound submix of the active audio device into this encoder through the input mixer.
+     * @param Submix submix to mix in or none for the main submix
+     * @param Gain linear gain of the submix
+     * @return id of the mixer source or 0 on failure
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Pipeline|Mixer")
+    int32 AddMixerSubmixSource(USoundSubmix* Submix, float Gain = 1.0f);
+
+    /**
+     * Changes the linear gain of a mixer source.
+     * @param SourceId id returned when the source was added
+     * @param Gain new linear gain
+     * @return true if the source exists
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Pipeline|Mixer")
+    bool SetMixerSourceGain(int32 SourceId, float Gain);
+
+    /**
+     * Removes a source from the input mixer.
+     * @param SourceId id returned when the source was added
+     * @return true if the source was removed
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Pipeline|Mixer")
+    bool RemoveMixerSource(int32 SourceId);
+
+    /**
+     * @return per source counters and the CPU budget used by the input mixer
+     */
+    UFUNCTION(BlueprintPure, Category = "Odin|Audio Pipeline|Mixer")
+    FOdinInputMixerStats GetInputMixerStats() const;
+
     /**
      * Updates the 3D position of the specified channel mask. To assign different positions to multiple masks, call this function once per mask.
      * @param ChannelMask   audio layer
@@ -262,6 +389,13 @@ class ODIN_API UOdinEncoder : public UObject
     UPROPERTY(BlueprintReadOnly, Category = "Odin")
     bool bStereo = false;
 
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Odin|Audio Capture")
+    bool bPushToTalkEnabled = false;
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Capture")
+    bool bPushToTalkActive = false;
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Odin|Audio Capture", meta = (ClampMin = "0", ClampMax = "1000"))
+    int32 PushToTalkPreRollMs = 150;
+
   protected:
     virtual void BeginDestroy() override;
 
@@ -277,7 +411,24 @@ class ODIN_API UOdinEncoder : public UObject
     FAudioGeneratorHandle Audio_Generator_Handle;
     static void           HandleOdinAudioEventCallback(OdinEncoder* EncoderHandle, const OdinAudioEvents Events, TWeakObjectPtr<UOdinEncoder> WeakEncoderPtr);
 
-    TSharedPtr<FOdinSubmixListener> SubmixListener;
+    void                    DetachAudioGenerator();
+    FOdinEncoderInputMixer* GetOrCreateInputMixer();
+    void                    ReleaseInputMixer();
+
+    TSharedPtr<FOdinSubmixListener>                          SubmixListener;
+    TSharedPtr<FOdinEncoderCaptureSink, ESPMode::ThreadSafe> CaptureSink;
+    TUniquePtr<FOdinEncoderAdaptation>                       Adaptation;
+    TUniquePtr<FOdinEncoderInputMixer>                       InputMixer;
+    TMap<int32, TWeakObjectPtr<UOdinAudioCapture>>           MixerCaptures;
+    TMap<int32, TSharedPtr<FOdinMixerSubmixTap>>             MixerSubmixTaps;
+
+    // codec settings and state, re-applied when the encoder handle is replaced by ApplyEncoderProfile
+    bool                        bApplicationVoip         = true;
+    int32                       BitrateKbps              = 32;
+    int32                       PacketLossPerc           = 15;
+    int64                       UpdatePositionIntervalMs = 0;
+    int32                       AudioEventFilter         = 0;
+    TMap<uint64, FOdinPosition> Positions;
 };
 
 class ODIN_API FOdinSubmixListener : public ISubmixBufferListener
@@ -293,6 +444,7 @@ class ODIN_API FOdinSubmixListener : public ISubmixBufferListener
     void         AddEffectId(uint32 EffectId);
     void         DetachFromSubmix();
     void         RemoveEffectId(uint32 EffectId);
+    void         RemapEffectIds(const TMap<uint32, uint32>& EffectIdMap);
     void         SetDelay(int32 NewDelayInMs);
     int32        GetNumEffectsRegistered() const;
 
@@ -310,4 +462,55 @@ class ODIN_API FOdinSubmixListener : public ISubmixBufferListener
     TSharedPtr<Audio::FDeviceId, ESPMode::ThreadSafe> ListenTargetId;
     FDelegateHandle                                   AudioDeviceCreatedCallbackHandle;
     FDelegateHandle                                   AudioDeviceDestroyedCallbackHandle;
-};
\ No newline at end of file
+};
+
+/**
+ * @class FOdinEncoderCaptureSink
+ *
+ * Native capture sink feeding a single encoder. Holds the raw encoder handle and a strong reference to the push thread, so
+ * the capture thread only remixes and enqueues without resolving any UObject. The owning UOdinEncoder updates the handle
+ * whenever it is replaced or freed.
+ *
+ * The optional push-to-talk gate drops captured audio before it is remixed or queued. While closed, the raw capture is
+ * kept in a small pre-roll ring, which is flushed to the encoder as soon as the gate opens.
+ */
+class ODIN_API FOdinEncoderCaptureSink : public IOdinCaptureSink
+{
+  public:
+    FOdinEncoderCaptureSink(TSharedPtr<FOdinAudioPushDataThread, ESPMode::ThreadSafe> InPushDataThread, int32 InNumEncoderChannels);
+
+    virtual void OnCapturedAudio(const float* AudioData, int32 NumFrames, int32 NumChannels, int32 SampleRate, const FOdinCaptureBlockInfo& BlockInfo) override;
+    virtual void PrepareCapture(int32 NumChannels, int32 SampleRate) override;
+
+    void SetEncoderHandle(OdinEncoder* NewHandle);
+    void SetGateEnabled(bool bEnabled);
+    void SetGateOpen(bool bOpen);
+    /**
+     * Sets the pre-roll duration. The ring is only allocated in PrepareCapture, until then a longer pre-roll is limited to
+     * the previously allocated capacity.
+     */
+    void SetPreRollMs(int32 NewPreRollMs);
+
+  private:
+    void WritePreRoll(const float* AudioData, int32 NumSamples, int32 NumChannels, int32 SampleRate);
+    void FlushPreRoll(OdinEncoder* Encoder, const FOdinCaptureBlockInfo& BlockInfo);
+    void PushToEncoder(OdinEncoder* Encoder, const float* AudioData, int32 NumSamples, const FOdinCaptureBlockInfo& BlockInfo);
+
+    TSharedPtr<FOdinAudioPushDataThread, ESPMode::ThreadSafe> PushDataThread;
+    std::atomic<OdinEncoder*>                                 EncoderHandle = nullptr;
+    const int32                                               NumEncoderChannels;
+
+    std::atomic<bool>  bGateEnabled = false;
+    std::atomic<bool>  bGateOpen    = false;
+    std::atomic<int32> PreRollMs    = 150;
+
+    // capture thread only, or PrepareCapture while the capture thread is not running the sink
+    FOdinRemixer                       Remixer;
+    int32                              NumCaptureChannels = 0;
+    bool                               bWasGateOpen       = true;
+    Audio::TCircularAudioBuffer<float> PreRoll;
+    int32                              PreRollCapacity = 0;
+    TArray<float>                      PreRollScratch;
+    // remixed blocks are handed to the push thread in these buffers and come back once pushed
+    FOdinAudioBufferPoolPtr PushBufferPool;
+};
@@ -0,0 +1,128 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "OdinCore/include/odin.h"
+
+#include <atomic>
+
+#include "OdinEncoderAdaptation.generated.h"
+
+/**
+ * Codec settings of an encoder together with the connection quality it is meant for.
+ */
+USTRUCT(BlueprintType)
+struct ODIN_API FOdinEncoderProfile {
+    GENERATED_BODY()
+
+    /**
+     * Toggle codec type. Set to true for sending voice, false for anything else (like music).
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Odin|Audio Pipeline")
+    bool bApplicationVoip = true;
+    /**
+     * Encoding bitrate in kbps.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Odin|Audio Pipeline", meta = (ClampMin = "6", ClampMax = "510"))
+    int32 BitrateKbps = 32;
+    /**
+     * Expected packet loss percentage, higher values add more redundancy to each packet.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Odin|Audio Pipeline", meta = (ClampMin = "0", ClampMax = "100"))
+    int32 PacketLossPerc = 15;
+    /**
+     * Highest round-trip time in milliseconds this profile is used for. Above it the controller moves on to the next profile.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Odin|Audio Pipeline", meta = (ClampMin = "0"))
+    float MaxRttMs = 150.0f;
+};
+
+/**
+ * @class FOdinEncoderAdaptation
+ *
+ * Samples the connection statistics of a room on a background timer and picks the encoder profile matching the current
+ * round-trip time. Profiles are ordered from best to most robust. The controller only steps down after the round-trip time
+ * exceeded the current profile for DegradeSamples in a row, and only steps up again after it stayed below RecoverRatio of
+ * the better profile for RecoverSamples, so short spikes do not cause encoder switches.
+ *
+ * The connection statistics carry no loss counter, so GetLossPerc only estimates loss from the datagram counter deltas
+ * between two samples, compared against a baseline ratio of received to sent datagrams. Received datagrams mostly carry
+ * the voice of remote peers, so the ratio also moves when they start or stop talking. The estimate is a diagnostic and
+ * neither picks the profile nor changes its packet loss percentage.
+ */
+class ODIN_API FOdinEncoderAdaptation : public FRunnable
+{
+  public:
+    /**
+     * Called on the adaptation thread whenever a different profile should be used.
+     */
+    typedef TFunction<void(int32 ProfileIndex)> FOdinProfileChangeHandler;
+
+    FOdinEncoderAdaptation(OdinRoom* InRoom, TArray<FOdinEncoderProfile> InProfiles, FOdinProfileChangeHandler InProfileChangeHandler,
+                           float InSampleIntervalMs = 1000);
+    virtual ~FOdinEncoderAdaptation() override;
+
+    /**
+     * Starts sampling the room.
+     * @param InitialProfileIndex profile the encoder is currently configured with
+     */
+    void Start(int32 InitialProfileIndex);
+
+    int32 GetProfileIndex() const
+    { return ProfileIndex.load(std::memory_order_relaxed); }
+
+    const TArray<FOdinEncoderProfile>& GetProfiles() const
+    { return Profiles; }
+
+    /**
+     * @return Latest connection statistics sampled from the room.
+     */
+    OdinConnectionStats GetLastStats() const;
+
+    /**
+     * @return Smoothed packet loss percentage estimated from the datagram counters, for diagnostics only.
+     */
+    float GetLossPerc() const
+    { return LossPerc.load(std::memory_order_relaxed); }
+
+    virtual uint32 Run() override;
+    virtual void   Exit() override;
+
+    int32 DegradeSamples = 2;
+    int32 RecoverSamples = 5;
+    float RecoverRatio   = 0.8f;
+    // samples with fewer sent datagrams are too sparse for a loss estimate and keep the previous one
+    int32 MinLossDatagrams = 25;
+    // how fast the received to sent datagram ratio of a healthy connection is learned, per sample
+    float BaselineRate = 0.1f;
+    // a ratio below this share of the baseline is remote peers going silent, not loss, and restarts the baseline
+    float RemoteSilenceRatio = 0.5f;
+
+  private:
+    void  Sample();
+    float EstimateLoss(const OdinConnectionStats& Stats);
+
+    OdinRoom*                         Room;
+    const TArray<FOdinEncoderProfile> Profiles;
+    FOdinProfileChangeHandler         ProfileChangeHandler;
+
+    std::atomic<int32> ProfileIndex  = 0;
+    int32              DegradeStreak = 0;
+    int32              RecoverStreak = 0;
+
+    std::atomic<float>  LossPerc          = 0.0f;
+    float               BaselineRatio     = 0.0f;
+    bool                bHasPreviousStats = false;
+    OdinConnectionStats PreviousStats     = {};
+
+    mutable FCriticalSection StatsCS;
+    OdinConnectionStats      LastStats = {};
+
+    FThreadSafeBool             bIsRunning;
+    TUniquePtr<FRunnableThread> Thread;
+    FEvent*                     SampleEvent;
+    float                       SampleIntervalMs;
+};
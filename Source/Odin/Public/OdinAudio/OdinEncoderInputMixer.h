@@ -0,0 +1,253 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DSP/Dsp.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "ISubmixBufferListener.h"
+#include "OdinCore/include/odin.h"
+#include "OdinAudioPushDataThread.h"
+#include "OdinCaptureSink.h"
+#include "OdinSeqLock.h"
+#include "OdinRemixer.h"
+#include "OdinResampler.h"
+
+#include <atomic>
+
+#include "OdinEncoderInputMixer.generated.h"
+
+class USoundSubmix;
+
+/**
+ * Statistics of a single input of an encoder input mixer.
+ */
+USTRUCT(BlueprintType)
+struct ODIN_API FOdinInputMixerSourceStats {
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline")
+    int32 SourceId = 0;
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline")
+    FName Name;
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline")
+    float Gain = 1.0f;
+    /**
+     * Frames of this source mixed into the encoder input.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline")
+    int64 NumMixedFrames = 0;
+    /**
+     * Frames the source did not deliver in time and that were mixed as silence.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline")
+    int64 NumUnderrunFrames = 0;
+    /**
+     * Frames that arrived too late for their mix window and were skipped to stay aligned.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline")
+    int64 NumLateFrames = 0;
+    /**
+     * Frames dropped because the source ring was full.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline")
+    int64 NumOverflowFrames = 0;
+};
+
+/**
+ * Statistics of an encoder input mixer.
+ */
+USTRUCT(BlueprintType)
+struct ODIN_API FOdinInputMixerStats {
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline")
+    TArray<FOdinInputMixerSourceStats> Sources;
+    /**
+     * Smoothed time in microseconds spent per mix cycle.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline")
+    float MeanMixTimeUs = 0.0f;
+    /**
+     * Longest mix cycle in microseconds.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline")
+    float MaxMixTimeUs = 0.0f;
+    /**
+     * Share of the mix interval spent mixing in percent, i.e. the used CPU budget of the mixer thread.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline")
+    float BudgetUsagePercent = 0.0f;
+};
+
+/**
+ * @class FOdinMixerSource
+ *
+ * Single input of an FOdinEncoderInputMixer. Producers write blocks in any channel layout and sample rate, which are
+ * remixed and resampled with a polyphase filter to the encoder format on the producer thread and stored in a preallocated
+ * ring together with the time the block was received. Can be registered directly as capture sink on an Odin Audio Capture.
+ */
+class ODIN_API FOdinMixerSource : public IOdinCaptureSink
+{
+  public:
+    FOdinMixerSource(int32 InSourceId, FName InName, int32 InSampleRate, int32 InNumChannels, float InGain, int32 InCapacityFrames);
+
+    virtual void OnCapturedAudio(const float* AudioData, int32 NumFrames, int32 NumChannels, int32 SampleRate, const FOdinCaptureBlockInfo& BlockInfo) override;
+
+    /**
+     * Converts and stores a block of audio. Must only be called from one producer thread at a time, never blocks.
+     * @param AudioData interleaved samples
+     * @param NumFrames number of frames in AudioData
+     * @param NumChannels channels of AudioData
+     * @param SampleRate sample rate of AudioData
+     * @param Timestamp platform time in seconds at which the last frame of the block was received
+     */
+    void Write(const float* AudioData, int32 NumFrames, int32 NumChannels, int32 SampleRate, double Timestamp);
+
+    void SetGain(float NewGain)
+    { Gain.store(NewGain, std::memory_order_relaxed); }
+
+    float GetGain() const
+    { return Gain.load(std::memory_order_relaxed); }
+
+    int32 GetSourceId() const
+    { return SourceId; }
+
+    FName GetName() const
+    { return Name; }
+
+    FOdinInputMixerSourceStats GetStats() const;
+
+  private:
+    friend class FOdinEncoderInputMixer;
+
+    struct FWriteAnchor {
+        double Timestamp   = 0.0;
+        uint64 TotalFrames = 0;
+    };
+
+    const int32 SourceId;
+    const FName Name;
+    const int32 SampleRate;
+    const int32 NumChannels;
+
+    std::atomic<float>                 Gain;
+    Audio::TCircularAudioBuffer<float> Ring;
+    TOdinSeqLock<FWriteAnchor>         Anchor;
+
+    // producer thread only
+    FOdinRemixer   Remixer;
+    FOdinResampler Resampler;
+    int32          NumInputChannels   = 0;
+    int32          InputSampleRate    = 0;
+    uint64         TotalFramesWritten = 0;
+
+    // mixer thread only
+    uint64 TotalFramesRead = 0;
+
+    std::atomic<uint64> NumMixedFrames    = 0;
+    std::atomic<uint64> NumUnderrunFrames = 0;
+    std::atomic<uint64> NumLateFrames     = 0;
+    std::atomic<uint64> NumOverflowFrames = 0;
+};
+
+typedef TSharedPtr<FOdinMixerSource, ESPMode::ThreadSafe> FOdinMixerSourcePtr;
+
+/**
+ * @class FOdinMixerSubmixTap
+ *
+ * Feeds the output of a sound submix, e.g. game audio for streaming, into a mixer source. Owners have to call Detach
+ * before releasing the tap.
+ */
+class ODIN_API FOdinMixerSubmixTap : public ISubmixBufferListener
+{
+  public:
+    explicit FOdinMixerSubmixTap(FOdinMixerSourcePtr InSource);
+
+    virtual void OnNewSubmixBuffer(const USoundSubmix* OwningSubmix, float* AudioData, int32 NumSamples, int32 NumChannels, const int32 SampleRate,
+                                   double AudioClock) override;
+
+    /**
+     * Starts listening to the given submix of the active audio device.
+     * @param Submix submix to tap or null for the main submix
+     * @return true if the tap was registered
+     */
+    bool Attach(USoundSubmix* Submix);
+    void Detach();
+
+  private:
+    FOdinMixerSourcePtr                               Source;
+    TWeakObjectPtr<USoundSubmix>                      TappedSubmix;
+    TSharedPtr<Audio::FDeviceId, ESPMode::ThreadSafe> ListenTargetId;
+    std::atomic<bool>                                 bIsListening = false;
+};
+
+/**
+ * @class FOdinEncoderInputMixer
+ *
+ * Mixes several inputs, e.g. a microphone and the game audio, into the input of a single encoder. Sources convert their
+ * audio to the encoder format on their producer threads. The mixer thread then cuts a time window delayed by the mix
+ * latency out of every source, aligned by the time the audio was received, and sums all sources with their gain in one
+ * vectorized pass. Late audio is skipped and missing audio is mixed as silence, so a stalled source never delays others.
+ */
+class ODIN_API FOdinEncoderInputMixer : public FRunnable
+{
+  public:
+    FOdinEncoderInputMixer(TSharedPtr<FOdinAudioPushDataThread, ESPMode::ThreadSafe> InPushDataThread, int32 InSampleRate, int32 InNumChannels,
+                           float InMixIntervalMs = 10, float InMixLatencyMs = 40);
+    virtual ~FOdinEncoderInputMixer() override;
+
+    /**
+     * Adds a new input to the mixer, starting the mixer thread on first use.
+     * @param Name name shown in the statistics
+     * @param Gain linear gain applied to the source
+     * @return the new source, producers write into it or register it as capture sink
+     */
+    FOdinMixerSourcePtr AddSource(FName Name, float Gain = 1.0f);
+
+    /**
+     * @return true if a source with the id was removed
+     */
+    bool RemoveSource(int32 SourceId);
+
+    FOdinMixerSourcePtr FindSource(int32 SourceId) const;
+
+    void SetEncoderHandle(OdinEncoder* NewHandle);
+
+    FOdinInputMixerStats GetStats() const;
+
+    virtual uint32 Run() override;
+    virtual void   Exit() override;
+
+  private:
+    void Start();
+    void Mix();
+    void MixSource(FOdinMixerSource& Source, int32 NumFrames);
+
+    TSharedPtr<FOdinAudioPushDataThread, ESPMode::ThreadSafe> PushDataThread;
+    std::atomic<OdinEncoder*>                                 EncoderHandle = nullptr;
+    const int32                                               SampleRate;
+    const int32                                               NumChannels;
+    const float                                               MixIntervalMs;
+    const double                                              MixLatencySeconds;
+    const int32                                               SourceCapacityFrames;
+
+    mutable FCriticalSection    SourcesCS;
+    TArray<FOdinMixerSourcePtr> Sources;
+    int32                       NextSourceId = 1;
+
+    // mixer thread only
+    double                     WindowStart = 0.0;
+    Audio::FAlignedFloatBuffer MixBuffer;
+    Audio::FAlignedFloatBuffer SourceBuffer;
+    // mixed blocks are handed to the push thread in these buffers and come back once pushed
+    FOdinAudioBufferPoolPtr PushBufferPool;
+
+    std::atomic<float> MeanMixTimeUs = 0.0f;
+    std::atomic<float> MaxMixTimeUs  = 0.0f;
+
+    FThreadSafeBool             bIsRunning;
+    TUniquePtr<FRunnableThread> Thread;
+    FEvent*                     MixEvent;
+};
@@ -7,11 +7,17 @@
 #include "CoreMinimal.h"
 #include "OdinNative/OdinNativeHandle.h"
 #include "OdinNative/OdinNativeBlueprint.h"
+#include "OdinAudio/Effects/OdinNativeEffect.h"
+#include "OdinAudio/OdinPipelineTiming.h"
 #include "UObject/Object.h"
 
 #include "OdinPipeline.generated.h"
 
 class UOdinCloneEffect;
+class UOdinCustomEffect;
+class UOdinPipelineDescriptorAsset;
+struct FOdinPipelineDescriptor;
+struct FOdinCompiledPipelineDescriptor;
 /**
  * A highly dynamic audio processing chain that manages a thread-safe collection of filters like
  * voice activity detection, echo cancellation, noise suppression and even custom effects.
@@ -89,6 +95,20 @@ class ODIN_API UOdinPipeline : public UObject
     UFUNCTION(BlueprintCallable, meta = (DisplayName = "Insert Custom Effect", ToolTip = "Add a custom effect to the pipline"),
               Category = "Odin|Audio Pipeline")
     int32 InsertCustomEffect(int32 Index, UOdinCustomEffect* Effect);
+    /**
+     * Inserts a native effect at the specified index in the audio pipeline. The native pipeline calls the effect directly
+     * with the raw samples, the pipeline keeps a reference to it until the effect is removed.
+     * @remarks Index is shifting subsequent effects. An index of `0` inserts at the beginning of the pipeline.
+     * @param Index desired index
+     * @param Effect native effect
+     * @return the new effect id or 0
+     */
+    int32 InsertNativeEffect(int32 Index, FOdinNativeEffectRef Effect);
+    /**
+     * @param EffectId effect id
+     * @return the native effect inserted with the id or null
+     */
+    FOdinNativeEffectRef FindNativeEffect(int32 EffectId) const;
     /**
      * Inserts a Voice Activity Detection (VAD) effect into the audio pipeline at the specified
      * index and returns a unique effect identifier.
@@ -188,6 +208,54 @@ class ODIN_API UOdinPipeline : public UObject
      */
     bool UpdateApmPlayback(int32 EffectId, const float* Samples, int32 Count, int32 Delay = 10);
 
+    /**
+     * Appends all effects of a descriptor asset in one batch. The asset is validated on first use and the converted
+     * descriptor is reused for every pipeline. Either all effects are inserted or, on failure, none.
+     * @param Descriptor descriptor asset
+     * @param OutCustomEffects receives the custom effects created for this pipeline in slot order, the pipeline keeps them
+     * alive until they are removed
+     * @return true if every effect was inserted
+     */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Apply Descriptor Asset", ToolTip = "Append all effects of a pipeline descriptor asset"),
+              Category = "Odin|Audio Pipeline")
+    bool ApplyDescriptorAsset(UOdinPipelineDescriptorAsset* Descriptor, TArray<UOdinCustomEffect*>& OutCustomEffects);
+    /**
+     * Validates a descriptor and appends all of its effects in one batch. Prefer a descriptor asset when the same
+     * descriptor is applied to many pipelines, as it is only validated once.
+     * @param Descriptor pipeline descriptor
+     * @param OutCustomEffects receives the custom effects created for this pipeline in slot order, the pipeline keeps them
+     * alive until they are removed
+     * @return true if every effect was inserted
+     */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Apply Descriptor", ToolTip = "Append all effects of a pipeline descriptor"),
+              Category = "Odin|Audio Pipeline")
+    bool ApplyDescriptor(const FOdinPipelineDescriptor& Descriptor, TArray<UOdinCustomEffect*>& OutCustomEffects);
+    /**
+     * Appends all effects of a compiled descriptor in one batch, rolling back already inserted effects on failure.
+     */
+    bool ApplyCompiledDescriptor(const FOdinCompiledPipelineDescriptor& Compiled, TArray<UOdinCustomEffect*>& OutCustomEffects);
+
+    /**
+     * Enables CPU timing of this pipeline. Every custom and native effect is timed individually and the whole encoder or
+     * decoder pop call is timed as well, which includes VAD and APM effects. Durations are also published as Insights
+     * counters below 'Odin/Pipeline'. While disabled, effects only pay for a flag check.
+     * @param bEnabled true to record timings
+     */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Set Effect Timing Enabled", ToolTip = "Record CPU time of the effects and pop calls of the pipeline"),
+              Category = "Odin|Audio Pipeline|Stats")
+    void SetEffectTimingEnabled(bool bEnabled);
+    UFUNCTION(BlueprintPure, Category = "Odin|Audio Pipeline|Stats")
+    bool IsEffectTimingEnabled() const;
+    /**
+     * Retrieves the CPU timing recorded since timing was enabled or last reset.
+     * @param OutEffects receives the timing of every custom and native effect in pipeline order
+     * @return timing of the whole pop call
+     */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Get Effect Timing Stats", ReturnDisplayName = "Pop Timing"), Category = "Odin|Audio Pipeline|Stats")
+    FOdinEffectTimingStats GetEffectTimingStats(TArray<FOdinEffectTimingStats>& OutEffects) const;
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Reset Effect Timing Stats"), Category = "Odin|Audio Pipeline|Stats")
+    void ResetEffectTimingStats();
+
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FApmConfigChangedDelegate, UOdinPipeline*, Pipeline, int32, EffectId, FOdinApmConfig, NewApmConfig);
     UPROPERTY(BlueprintAssignable, Category = "Odin|Audio Pipeline")
     FApmConfigChangedDelegate OnApmConfigChanged;
@@ -255,8 +323,49 @@ class ODIN_API UOdinPipeline : public UObject
 
     void SetHandle(const OdinPipeline* NewHandle);
 
+    /**
+     * Recreates all effects of this pipeline in the same order on another pipeline, e.g. of a replacement encoder.
+     * VAD and APM effects are inserted with their current configuration, custom and native effects are registered with the
+     * same effect object. APM effects start with fresh internal state, as their adaptive filters can not be transferred.
+     * @param Target pipeline handle to insert the effects into, expected to be empty
+     * @param SampleRate sample rate for APM effects
+     * @param bStereo channel layout for APM effects
+     * @param OutEffectIdMap maps effect ids of this pipeline to the ids in Target
+     * @return true if every effect was recreated
+     */
+    bool CopyEffectsTo(const OdinPipeline* Target, int32 SampleRate, bool bStereo, TMap<uint32, uint32>& OutEffectIdMap) const;
+
+    /**
+     * Replaces the internal handle with a pipeline previously filled by CopyEffectsTo and updates the effect ids of all
+     * registered custom and native effects, so existing UOdinPipeline and effect references stay usable.
+     * @param NewHandle pipeline handle of the replacement encoder
+     * @param EffectIdMap effect id mapping returned by CopyEffectsTo
+     */
+    void SwapHandle(const OdinPipeline* NewHandle, const TMap<uint32, uint32>& EffectIdMap);
+
+  protected:
+    virtual void BeginDestroy() override;
+
   private:
+    FOdinPipelineTimings* GetOrCreateTimings();
+    void                  UpdateTimingRegistration(const OdinPipeline* NewHandle);
+    /**
+     * Inserts a custom effect callback wrapped in an effect timer and keeps the timer until the effect is removed.
+     */
+    OdinError InsertTimedEffect(int32 Index, OdinCustomEffectCallback Callback, const void* UserData, const FString& Name, uint32_t& OutEffectId);
+
     UPROPERTY()
     UOdinHandle*                  Handle;
     TWeakObjectPtr<UOdinPipeline> Self = this;
+
+    TMap<uint32, TWeakObjectPtr<UOdinCustomEffect>> CustomEffects;
+    TMap<uint32, FOdinNativeEffectRef>              NativeEffects;
+    // custom effects created by the pipeline itself, e.g. from a descriptor, are kept alive for as long as they are inserted
+    UPROPERTY()
+    TArray<TObjectPtr<UOdinCustomEffect>> OwnedCustomEffects;
+
+    FOdinPipelineTimingsRef           Timings;
+    TMap<uint32, FOdinEffectTimerRef> EffectTimers;
+    uint32                            NumNativeEffectsInserted = 0;
+    const OdinPipeline*               RegisteredTimingHandle   = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,128 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "OdinCore/include/odin.h"
+#include "OdinNative/OdinNativeBlueprint.h"
+#include "Templates/SubclassOf.h"
+
+#include "OdinPipelineDescriptor.generated.h"
+
+class UOdinCustomEffect;
+
+UENUM(BlueprintType)
+enum class EOdinPipelineSlotType : uint8 {
+    Vad    UMETA(DisplayName = "VAD"),
+    Apm    UMETA(DisplayName = "APM"),
+    Custom UMETA(DisplayName = "Custom Effect"),
+};
+
+/**
+ * Single effect of a pipeline descriptor together with its configuration.
+ */
+USTRUCT(BlueprintType)
+struct ODIN_API FOdinPipelineEffectSlot {
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Odin|Audio Pipeline")
+    EOdinPipelineSlotType Type = EOdinPipelineSlotType::Vad;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Odin|Audio Pipeline", meta = (EditCondition = "Type == EOdinPipelineSlotType::Vad", EditConditionHides))
+    FOdinVadConfig VadConfig;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Odin|Audio Pipeline", meta = (EditCondition = "Type == EOdinPipelineSlotType::Apm", EditConditionHides))
+    FOdinApmConfig ApmConfig;
+
+    /**
+     * Effect class instantiated for every pipeline the descriptor is applied to.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Odin|Audio Pipeline",
+              meta = (EditCondition = "Type == EOdinPipelineSlotType::Custom", EditConditionHides))
+    TSubclassOf<UOdinCustomEffect> CustomEffectClass;
+};
+
+/**
+ * Validated descriptor with all configurations already converted to their native representation.
+ */
+struct ODIN_API FOdinCompiledPipelineDescriptor {
+    struct FSlot {
+        EOdinPipelineSlotType Type = EOdinPipelineSlotType::Vad;
+        OdinVadConfig         VadConfig         = {};
+        OdinApmConfig         ApmConfig         = {};
+        UClass*               CustomEffectClass = nullptr;
+    };
+
+    TArray<FSlot> Slots;
+    int32         ApmSampleRate = 48000;
+    bool          bApmStereo    = false;
+};
+
+/**
+ * Declarative description of an audio pipeline. Instead of inserting and configuring every effect with its own calls,
+ * the descriptor is validated and converted once and then applied to any number of pipelines in a single batch.
+ */
+USTRUCT(BlueprintType)
+struct ODIN_API FOdinPipelineDescriptor {
+    GENERATED_BODY()
+
+    /**
+     * Effects in processing order.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Odin|Audio Pipeline")
+    TArray<FOdinPipelineEffectSlot> Slots;
+
+    /**
+     * Playback sample rate of APM effects.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Odin|Audio Pipeline")
+    int32 ApmSampleRate = 48000;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Odin|Audio Pipeline")
+    bool bApmStereo = false;
+
+    /**
+     * Validates all slots and converts them to their native representation.
+     * @param OutCompiled receives the converted descriptor
+     * @param OutErrors receives a description of every invalid slot
+     * @return true if the descriptor is valid
+     */
+    bool Compile(FOdinCompiledPipelineDescriptor& OutCompiled, TArray<FString>& OutErrors) const;
+};
+
+/**
+ * Asset holding a pipeline descriptor, e.g. one shared by all peer decoders. The descriptor is validated and converted
+ * on first use and the result is reused for every pipeline it is applied to.
+ */
+UCLASS(BlueprintType)
+class ODIN_API UOdinPipelineDescriptorAsset : public UDataAsset
+{
+    GENERATED_BODY()
+
+  public:
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Odin|Audio Pipeline")
+    FOdinPipelineDescriptor Descriptor;
+
+    /**
+     * @return The converted descriptor or null if it is invalid, errors are logged once.
+     */
+    const FOdinCompiledPipelineDescriptor* GetCompiled();
+
+    /**
+     * Validates the descriptor without using the cached result.
+     * @param OutErrors receives a description of every invalid slot
+     * @return true if the descriptor is valid
+     */
+    UFUNCTION(BlueprintCallable, Category = "Odin|Audio Pipeline")
+    bool Validate(TArray<FString>& OutErrors) const;
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+  private:
+    FOdinCompiledPipelineDescriptor Compiled;
+    bool                            bIsCompiled = false;
+    bool                            bIsValid    = false;
+};
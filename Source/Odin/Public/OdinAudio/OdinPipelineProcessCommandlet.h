@@ -0,0 +1,63 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "OdinAudio/OdinPipelineTiming.h"
+
+#include "OdinPipelineProcessCommandlet.generated.h"
+
+class UOdinPipelineDescriptorAsset;
+
+/**
+ * Offline processor for WAV corpora. Every file is pushed through an encoder pipeline and a decoder pipeline as fast as
+ * possible, without room or network: odin_encoder_push, odin_encoder_pop, odin_decoder_push, odin_decoder_pop. The
+ * decoded output is written as 16 bit WAV next to a CSV with per-stage and per-effect timing, so APM, VAD and custom
+ * effect settings as well as CPU regressions can be checked on long recordings in CI. The output mirrors the folders of
+ * an input directory, the CSV names every file by its path relative to the input.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd <Project> -run=OdinPipelineProcess -Input=<file or directory> -Output=<directory>
+ *     [-EncoderDescriptor=<asset path>] [-DecoderDescriptor=<asset path>] [-SampleRate=48000] [-Stereo]
+ */
+UCLASS()
+class ODIN_API UOdinPipelineProcessCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+  public:
+    UOdinPipelineProcessCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+  private:
+    /**
+     * Timing of one file, every stage is recorded per 20 ms frame.
+     */
+    struct FFileResult {
+        /** Path relative to the input directory, or the file name for a single input file. */
+        FString                        Name;
+        double                         AudioSeconds   = 0.0;
+        double                         ProcessSeconds = 0.0;
+        FOdinTimingStats               Convert;
+        FOdinTimingStats               EncoderPush;
+        FOdinTimingStats               EncoderPop;
+        FOdinTimingStats               DecoderPush;
+        FOdinTimingStats               DecoderPop;
+        TArray<FOdinEffectTimingStats> EncoderEffects;
+        TArray<FOdinEffectTimingStats> DecoderEffects;
+    };
+
+    bool ProcessFile(const FString& InputFile, const FString& OutputFile, FFileResult& OutResult);
+    bool ReadWav(const FString& InputFile, TArray<float>& OutSamples, int32& OutNumChannels, int32& OutSampleRate) const;
+    void WriteTimingReport(const FString& ReportFile, const TArray<TUniquePtr<FFileResult>>& Results) const;
+
+    UPROPERTY()
+    UOdinPipelineDescriptorAsset* EncoderDescriptor = nullptr;
+    UPROPERTY()
+    UOdinPipelineDescriptorAsset* DecoderDescriptor = nullptr;
+
+    int32 SampleRate = 48000;
+    bool  bStereo    = false;
+};
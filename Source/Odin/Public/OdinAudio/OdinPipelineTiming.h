@@ -0,0 +1,172 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OdinCore/include/odin.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "Templates/RefCounting.h"
+
+#include <atomic>
+
+#include "OdinPipelineTiming.generated.h"
+
+/**
+ * CPU time spent in a pipeline effect or in a whole pop call.
+ */
+USTRUCT(BlueprintType)
+struct ODIN_API FOdinEffectTimingStats {
+    GENERATED_BODY()
+
+    /**
+     * Effect id in the pipeline, 0 for the whole pop call.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|Stats")
+    int32 EffectId = 0;
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|Stats")
+    FString Name;
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|Stats")
+    int64 NumCalls = 0;
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|Stats")
+    float MeanUs = 0.0f;
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|Stats")
+    float MaxUs = 0.0f;
+    /**
+     * 99th percentile, resolved to 1/8 of an octave.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Odin|Audio Pipeline|Stats")
+    float P99Us = 0.0f;
+};
+
+/**
+ * Running duration statistics. Recording never allocates or locks, the percentile is taken from a log-linear histogram
+ * with 8 buckets per octave, so it is exact to within 12.5%.
+ */
+class ODIN_API FOdinTimingStats
+{
+  public:
+    FOdinTimingStats();
+
+    void Record(uint64 Cycles);
+    void Reset();
+    void Get(FOdinEffectTimingStats& OutStats) const;
+
+  private:
+    static constexpr int32 NumSubBuckets = 8;
+    static constexpr int32 NumBuckets    = 320;
+
+    static int32  BucketIndex(uint64 Nanoseconds);
+    static uint64 BucketUpperBound(int32 Index);
+
+    std::atomic<uint64> NumCalls;
+    std::atomic<uint64> TotalNs;
+    std::atomic<uint64> MaxNs;
+    std::atomic<uint32> Buckets[NumBuckets];
+};
+
+/**
+ * Timing state of one UOdinPipeline, shared with the threads popping from its encoder or decoder. Pipelines with enabled
+ * timing are registered by their native handle, so pop calls that only know the encoder or decoder handle can find it.
+ */
+class ODIN_API FOdinPipelineTimings : public FRefCountBase
+{
+  public:
+    explicit FOdinPipelineTimings(const FString& InName);
+    virtual ~FOdinPipelineTimings() override;
+
+    bool IsEnabled() const
+    { return bEnabled.load(std::memory_order_relaxed); }
+
+    void SetEnabled(bool bInEnabled)
+    { bEnabled.store(bInEnabled, std::memory_order_relaxed); }
+
+    const FString& GetName() const
+    { return Name; }
+
+    void RecordPop(uint64 Cycles);
+
+    FOdinTimingStats PopStats;
+
+    /**
+     * Registers the timings for pop calls of the pipeline handle, replacing a previous registration of the handle.
+     */
+    static void Register(const OdinPipeline* Handle, FOdinPipelineTimings* Timings);
+    static void Unregister(const OdinPipeline* Handle, const FOdinPipelineTimings* Timings);
+    /**
+     * @return The timings registered for the pipeline handle or null, without locking if no pipeline is registered.
+     */
+    static TRefCountPtr<FOdinPipelineTimings> Find(const OdinPipeline* Handle);
+
+  private:
+    FString           Name;
+    std::atomic<bool> bEnabled = false;
+#if COUNTERSTRACE_ENABLED
+    TUniquePtr<FCountersTrace::FCounterFloat> PopCounter;
+#endif
+};
+
+typedef TRefCountPtr<FOdinPipelineTimings> FOdinPipelineTimingsRef;
+
+/**
+ * Callback wrapper every custom and native effect of a UOdinPipeline is inserted with. The effect callback is forwarded
+ * unchanged and only timed while timing is enabled for the pipeline, otherwise the wrapper costs a single flag check.
+ */
+class ODIN_API FOdinEffectTimer : public FRefCountBase
+{
+  public:
+    /**
+     * @param InTimings timings of the pipeline the effect is inserted into
+     * @param InCallback effect callback
+     * @param InUserData user data of the effect callback
+     * @param InName name of the effect in statistics and Insights counters, unique within the pipeline
+     */
+    FOdinEffectTimer(FOdinPipelineTimingsRef InTimings, OdinCustomEffectCallback InCallback, const void* InUserData, const FString& InName);
+    virtual ~FOdinEffectTimer() override;
+
+    /**
+     * Sets the effect id after insertion or after the pipeline handle was swapped.
+     */
+    void SetEffectId(uint32 InEffectId)
+    { EffectId = InEffectId; }
+
+    uint32 GetEffectId() const
+    { return EffectId; }
+
+    void GetStats(FOdinEffectTimingStats& OutStats) const;
+
+    void ResetStats()
+    { Stats.Reset(); }
+
+    /**
+     * Callback registered with odin_pipeline_insert_custom_effect, the user data is the timer itself.
+     */
+    static void FFICallback(float* Samples, uint32_t SamplesCount, bool* bIsSilent, const void* InUserData);
+
+  private:
+    FOdinPipelineTimingsRef  Timings;
+    OdinCustomEffectCallback Callback;
+    const void*              UserData;
+    FString                  Name;
+    uint32                   EffectId = 0;
+    FOdinTimingStats         Stats;
+#if COUNTERSTRACE_ENABLED
+    TUniquePtr<FCountersTrace::FCounterFloat> Counter;
+#endif
+};
+
+typedef TRefCountPtr<FOdinEffectTimer> FOdinEffectTimerRef;
+
+/**
+ * Times a single encoder or decoder pop call, if timing is enabled for the pipeline of the codec.
+ */
+class ODIN_API FOdinPopTimingScope
+{
+  public:
+    explicit FOdinPopTimingScope(OdinEncoder* Encoder);
+    explicit FOdinPopTimingScope(OdinDecoder* Decoder);
+    ~FOdinPopTimingScope();
+
+  private:
+    FOdinPipelineTimingsRef Timings;
+    uint64                  StartCycles = 0;
+};
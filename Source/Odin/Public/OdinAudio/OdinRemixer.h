@@ -0,0 +1,68 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DSP/Dsp.h"
+
+/**
+ * @class FOdinRemixer
+ *
+ * Converts interleaved audio between channel layouts. The remix kernel is selected once on Init, with vectorized kernels
+ * for the common capture cases stereo to mono, quad to mono, 5.1 to mono and mono to stereo. Process writes into a
+ * persistent scratch buffer, which only grows if a larger block than before is passed in.
+ */
+class ODIN_API FOdinRemixer
+{
+  public:
+    typedef void (*FRemixKernel)(const float* InSamples, float* OutSamples, int32 NumFrames, int32 NumInputChannels, int32 NumOutputChannels);
+
+    FOdinRemixer() = default;
+    FOdinRemixer(int32 InNumInputChannels, int32 InNumOutputChannels);
+
+    /**
+     * Selects the remix kernel for the given channel layouts.
+     * @param InNumInputChannels channels of the interleaved input
+     * @param InNumOutputChannels channels of the interleaved output
+     */
+    void Init(int32 InNumInputChannels, int32 InNumOutputChannels);
+
+    /**
+     * @return true if input and output layout are identical and Process returns the input unchanged
+     */
+    bool IsPassthrough() const
+    { return NumInputChannels == NumOutputChannels; }
+
+    int32 GetNumInputChannels() const
+    { return NumInputChannels; }
+
+    int32 GetNumOutputChannels() const
+    { return NumOutputChannels; }
+
+    /**
+     * Remixes a block of interleaved samples into the scratch buffer.
+     * @param InSamples interleaved input
+     * @param NumInputSamples number of interleaved input samples
+     * @return view of the remixed samples, valid until the next call to Process
+     */
+    TArrayView<const float> Process(const float* InSamples, int32 NumInputSamples);
+
+    /**
+     * Remixes a block of interleaved samples into a caller provided buffer.
+     * @param InSamples interleaved input
+     * @param NumFrames number of frames of the input
+     * @param OutSamples interleaved output, holding at least NumFrames * output channels samples
+     */
+    void Process(const float* InSamples, int32 NumFrames, float* OutSamples) const;
+
+    /**
+     * Selects the kernel converting between the given channel layouts.
+     */
+    static FRemixKernel SelectKernel(int32 InNumInputChannels, int32 InNumOutputChannels);
+
+  private:
+    FRemixKernel               Kernel            = nullptr;
+    int32                      NumInputChannels  = 1;
+    int32                      NumOutputChannels = 1;
+    Audio::FAlignedFloatBuffer Scratch;
+};
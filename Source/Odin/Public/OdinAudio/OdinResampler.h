@@ -0,0 +1,139 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DSP/Dsp.h"
+
+/**
+ * @class FOdinResampler
+ *
+ * Streaming polyphase resampler for interleaved audio. A Kaiser windowed sinc prototype filter is split into one
+ * sub-filter per output phase on Init, with the cutoff placed below the Nyquist frequency of the lower rate. When
+ * downsampling, the taps grow with the ratio, so the transition band keeps its width relative to the output rate.
+ * Relative to the Nyquist frequency of the lower rate, the default taps keep the passband flat within 0.02 dB up to 0.75,
+ * are 6 dB down at 0.9 and reach 80 dB of attenuation only at about 1.07, with about 90 dB beyond that. The Nyquist
+ * frequency itself is attenuated by only about 28 dB, so content just above it folds back into the transition band
+ * between 0.93 and 1.0 when downsampling. More taps narrow the transition band. Rational ratios like 48000/16000 or
+ * 44100/48000 use exact phases, other ratios are quantized to MaxPhases, which limits distortion and noise to about
+ * -70 dB. Each output sample is a vectorized dot
+ * product of a sub-filter with the input history of its channel. Input history and phase are kept across calls, so
+ * blocks of any size produce the same output as one large block, delayed by GetLatencyFrames. Buffers only grow if a
+ * larger block than before is passed in.
+ */
+class ODIN_API FOdinResampler
+{
+  public:
+    static constexpr int32 MaxPhases      = 256;
+    static constexpr int32 DefaultNumTaps = 32;
+
+    FOdinResampler() = default;
+    FOdinResampler(int32 InInputSampleRate, int32 InOutputSampleRate, int32 InNumChannels, int32 InNumTaps = DefaultNumTaps);
+
+    /**
+     * Designs the filter for the given conversion and clears the stream state.
+     * @param InInputSampleRate sample rate of the input
+     * @param InOutputSampleRate sample rate of the output
+     * @param InNumChannels channels of the interleaved input and output
+     * @param InNumTaps taps per sub-filter, higher values give a steeper cutoff, multiplied by the rounded up ratio when
+     * downsampling and rounded up to a multiple of 4
+     */
+    void Init(int32 InInputSampleRate, int32 InOutputSampleRate, int32 InNumChannels, int32 InNumTaps = DefaultNumTaps);
+
+    /**
+     * Clears input history and phase, e.g. after a gap in the stream. Keeps the filter.
+     */
+    void Reset();
+
+    /**
+     * @return true if input and output rate are identical and Process copies the input unchanged
+     */
+    bool IsPassthrough() const
+    { return InputSampleRate == OutputSampleRate; }
+
+    int32 GetInputSampleRate() const
+    { return InputSampleRate; }
+
+    int32 GetOutputSampleRate() const
+    { return OutputSampleRate; }
+
+    int32 GetNumChannels() const
+    { return NumChannels; }
+
+    int32 GetNumTaps() const
+    { return NumTaps; }
+
+    /**
+     * @return Delay of the output in input frames, the input still held back by the filter at the end of a stream.
+     */
+    int32 GetLatencyFrames() const
+    { return IsPassthrough() ? 0 : NumTaps / 2; }
+
+    /**
+     * @return Upper bound of output frames produced from a block of input frames.
+     */
+    int32 GetMaxOutputFrames(int32 NumInputFrames) const;
+
+    /**
+     * Resamples a block of interleaved samples into a caller provided buffer.
+     * @param InSamples interleaved input
+     * @param NumInputFrames number of frames of the input
+     * @param OutSamples interleaved output
+     * @param MaxOutputFrames capacity of OutSamples in frames, at least GetMaxOutputFrames(NumInputFrames)
+     * @return number of frames written to OutSamples
+     */
+    int32 Process(const float* InSamples, int32 NumInputFrames, float* OutSamples, int32 MaxOutputFrames);
+
+    /**
+     * Resamples a block of interleaved samples into the scratch buffer.
+     * @param InSamples interleaved input
+     * @param NumInputFrames number of frames of the input
+     * @return view of the resampled interleaved samples, valid until the next call to Process
+     */
+    TArrayView<const float> Process(const float* InSamples, int32 NumInputFrames);
+
+    /**
+     * Ends the stream: pushes the input still held back by the filter out into a caller provided buffer and clears the
+     * stream state. Feeds silence through the work buffers without allocating.
+     * @param OutSamples interleaved output
+     * @param MaxOutputFrames capacity of OutSamples in frames, at least GetMaxOutputFrames(GetLatencyFrames())
+     * @return number of frames written to OutSamples
+     */
+    int32 Flush(float* OutSamples, int32 MaxOutputFrames);
+
+    /**
+     * Ends the stream: pushes the input still held back by the filter out into the scratch buffer and clears the stream
+     * state.
+     * @return view of the remaining interleaved samples, valid until the next call to Process or Flush
+     */
+    TArrayView<const float> Flush();
+
+  private:
+    /**
+     * Grows the work buffers of every channel to hold the history and a block of NumInputFrames.
+     */
+    void PrepareWork(int32 NumInputFrames);
+
+    /**
+     * Filters the block placed behind the history in the work buffers and keeps its tail as history for the next block.
+     * @return number of frames written to OutSamples
+     */
+    int32 FilterWork(int32 NumInputFrames, float* OutSamples, int32 MaxOutputFrames);
+
+    int32 InputSampleRate  = 0;
+    int32 OutputSampleRate = 0;
+    int32 NumChannels      = 1;
+    int32 NumTaps          = DefaultNumTaps;
+    int32 NumPhases        = 1;
+    // input frames advanced per output frame
+    double Step = 1.0;
+
+    // NumPhases + 1 sub-filters of NumTaps coefficients, the last one equals the first shifted by one frame
+    Audio::FAlignedFloatBuffer Coefficients;
+    // per channel: NumTaps - 1 frames of history followed by the current block
+    TArray<Audio::FAlignedFloatBuffer> Work;
+    Audio::FAlignedFloatBuffer         Scratch;
+
+    int32  NextIndex    = 0;
+    double NextFraction = 0.0;
+};
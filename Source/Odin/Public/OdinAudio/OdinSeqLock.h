@@ -0,0 +1,63 @@
+/* Copyright (c) 2022-2025 4Players GmbH. All rights reserved. */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+/**
+ * Sequence lock for a trivially copyable value with a single writer and any number of readers. Readers never block the
+ * writer and retry if the value was modified while they copied it.
+ */
+template <typename T>
+class TOdinSeqLock
+{
+    static_assert(TIsTriviallyCopyable<T>::Value, "TOdinSeqLock requires a trivially copyable type");
+
+  public:
+    /**
+     * Publishes a new value. Must only be called from a single writer thread at a time.
+     */
+    void Write(const T& NewValue)
+    {
+        Sequence.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        FMemory::Memcpy(&Value, &NewValue, sizeof(T));
+        Sequence.fetch_add(1, std::memory_order_release);
+    }
+
+    /**
+     * Copies the latest consistent value.
+     * @param OutValue receives the value
+     * @return the sequence number of the copied value, increasing by two with every write
+     */
+    uint32 Read(T& OutValue) const
+    {
+        uint32 Begin;
+        uint32 End;
+        do {
+            Begin = Sequence.load(std::memory_order_acquire);
+            FMemory::Memcpy(&OutValue, &Value, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            End = Sequence.load(std::memory_order_relaxed);
+        } while ((Begin & 1) != 0 || Begin != End);
+        return Begin;
+    }
+
+    /**
+     * @return the current sequence number without copying the value
+     */
+    uint32 GetSequence() const
+    { return Sequence.load(std::memory_order_acquire); }
+
+    /**
+     * Direct access for the writer thread, which is the only one allowed to modify the value.
+     */
+    const T& GetWriterValue() const
+    { return Value; }
+
+  private:
+    std::atomic<uint32> Sequence = 0;
+    T                   Value{};
+};
@@ -4,10 +4,12 @@
 
 #include "DSP/Dsp.h"
 #include "OdinNative/OdinNativeHandle.h"
+#include "OdinAudio/OdinDecoderState.h"
 #include "HAL/ThreadSafeBool.h"
 #include "Sound/SoundGenerator.h"
 
 class IAudioBufferListener;
+class FOdinAudioTap;
 class UOdinDecoder;
 
 /**
@@ -46,6 +48,32 @@ class ODIN_API FOdinSoundGenerator : public ISoundGenerator
      */
     void RemoveAudioBufferListener(const TWeakPtr<IAudioBufferListener>& InAudioBufferListener);
 
+    /**
+     * Adds a tap that receives a copy of every decoded buffer. Unlike buffer listeners, taps are fed through a lock-free
+     * ring and consumed on their own thread, so a slow consumer never stalls the render thread.
+     * @param InAudioTap The tap to feed.
+     */
+    void AddAudioTap(const TSharedPtr<FOdinAudioTap, ESPMode::ThreadSafe>& InAudioTap);
+
+    /**
+     * Removes a previously added audio tap.
+     * @param InAudioTap The tap to remove.
+     */
+    void RemoveAudioTap(const TSharedPtr<FOdinAudioTap, ESPMode::ThreadSafe>& InAudioTap);
+
+    /**
+     * Sets the number of frames rendered per callback. If set to a value greater than zero, the generator pops exactly
+     * the mixer callback size from the decoder instead of 20 ms blocks, avoiding extra buffering in the generator wrapper.
+     * @param InNumFrames Frames per callback, zero to use the default 20 ms blocks.
+     */
+    void SetNumFramesPerCallback(int32 InNumFrames);
+
+    /**
+     * Returns the duration of audio rendered per callback.
+     * @return The playback quantum in milliseconds.
+     */
+    float GetPlaybackQuantumMs() const;
+
     /**
      * Returns the number of samples the generator prefers to render per callback.
      * @return The preferred number of samples.
@@ -81,11 +109,17 @@ class ODIN_API FOdinSoundGenerator : public ISoundGenerator
     TArray<TWeakPtr<IAudioBufferListener>> AudioBufferListeners;
     FCriticalSection                       CriticalSectionAudioBufferListeners;
 
-    OdinDecoder*     NativeDecoderHandle;
-    FCriticalSection NativeHandleAccessSection;
+    TArray<TSharedPtr<FOdinAudioTap, ESPMode::ThreadSafe>> AudioTaps;
+    FCriticalSection                                       CriticalSectionAudioTaps;
+
+    OdinDecoder*         NativeDecoderHandle;
+    FOdinDecoderStatePtr DecoderState;
+    FCriticalSection     NativeHandleAccessSection;
 
     FThreadSafeBool bIsFinished;
 
     int32 SampleRate   = 48000;
     int32 ChannelCount = 1;
+
+    std::atomic<int32> NumFramesPerCallback = 0;
 };
\ No newline at end of file
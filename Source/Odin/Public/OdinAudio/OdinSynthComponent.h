@@ -6,6 +6,7 @@
 #include "CoreMinimal.h"
 #include "OdinSynthComponent.generated.h"
 
+class FOdinAudioTap;
 class FOdinSoundGenerator;
 class UOdinDecoder;
 
@@ -56,6 +57,34 @@ class ODIN_API UOdinSynthComponent : public USynthComponent
     UFUNCTION(BlueprintCallable, Category = "Odin|Sound")
     void SetDecoder(UOdinDecoder* InDecoder);
 
+    /**
+     * Adds a tap receiving a copy of all decoded audio played back by this component, e.g. to record or analyze it.
+     * The tap is kept across sound generator restarts and is started if it is not running yet.
+     * @param AudioTap The tap to feed.
+     */
+    void AddAudioTap(const TSharedPtr<FOdinAudioTap, ESPMode::ThreadSafe>& AudioTap);
+
+    /**
+     * Removes a previously added audio tap.
+     * @param AudioTap The tap to remove.
+     */
+    void RemoveAudioTap(const TSharedPtr<FOdinAudioTap, ESPMode::ThreadSafe>& AudioTap);
+
+    /**
+     * Returns the duration of audio popped from the decoder per render callback.
+     * @return The playback quantum in milliseconds, or zero if no sound generator is active.
+     */
+    UFUNCTION(BlueprintPure, Category = "Odin|Sound")
+    float GetPlaybackQuantumMs() const;
+
+    /**
+     * If enabled, the decoder is popped with the actual callback size of the audio mixer (e.g. 256 or 512 frames) instead of
+     * fixed 20 ms blocks, which removes the extra buffering in the generator wrapper and lowers the receive latency.
+     * Takes effect the next time the sound generator is created.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Odin|Sound")
+    bool bLowLatencyPlayback = false;
+
   protected:
     /**
      * Restarts the Odin Synth Component by stopping and then restarting its audio generation.
@@ -69,6 +98,13 @@ class ODIN_API UOdinSynthComponent : public USynthComponent
     virtual void OnUnregister() override;
     void         CloseSoundGenerator();
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    /**
+     * Subscribes to format changes of the current decoder, releasing the subscription of a previously bound decoder.
+     */
+    void BindDecoderFormatChanged();
+    void HandleDecoderFormatChanged(UOdinDecoder* ChangedDecoder);
+
     /**
      * Holds a reference to an Odin Decoder instance for retrieving audio data in the Odin Synth Component.
      */
@@ -76,8 +112,13 @@ class ODIN_API UOdinSynthComponent : public USynthComponent
     UOdinDecoder* Decoder;
 
     TSharedPtr<FOdinSoundGenerator, ESPMode::ThreadSafe> OdinSoundGeneratorPtr;
+    TArray<TSharedPtr<FOdinAudioTap, ESPMode::ThreadSafe>> AudioTaps;
     FThreadSafeCounter                                   CurrentAudioDeviceId = -1;
 
   private:
     bool bWasPlayingBeforeUnregister = false;
+    bool bIsMatchingDecoderFormat    = false;
+
+    TWeakObjectPtr<UOdinDecoder> FormatChangedBoundDecoder;
+    FDelegateHandle              DecoderFormatChangedHandle;
 };
\ No newline at end of file
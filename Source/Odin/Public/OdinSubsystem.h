@@ -8,6 +8,7 @@
 #include "OdinCore/include/odin.h"
 #include "Subsystems/EngineSubsystem.h"
 #include "OdinAudio/OdinDecoder.h"
+#include "AudioDefines.h"
 
 #include "OdinSubsystem.generated.h"
 
@@ -32,6 +33,14 @@ class ODIN_API UOdinSubsystem : public UEngineSubsystem
   public:
     static UOdinSubsystem* Get();
     static bool            GlobalIsRoomValid(const OdinRoom* Handle);
+    /**
+     * Resolves the output format of the audio device used by the world of the given context object, or the active audio device.
+     * @param WorldContextObject context object to resolve the world audio device, may be null
+     * @param OutSampleRate sample rate of the audio mixer
+     * @param OutNumChannels number of output channels of the audio mixer
+     * @return true if an audio device was available
+     */
+    static bool GetAudioDeviceFormat(const UObject* WorldContextObject, int32& OutSampleRate, int32& OutNumChannels);
 
     virtual void Initialize(FSubsystemCollectionBase& Collection) override;
     virtual void Deinitialize() override;
@@ -39,7 +48,25 @@ class ODIN_API UOdinSubsystem : public UEngineSubsystem
     void                              LinkEncoder(TWeakObjectPtr<UOdinEncoder> Encoder, TWeakObjectPtr<UOdinRoom> TargetRoom);
     void                              UnlinkEncoder(TWeakObjectPtr<UOdinEncoder> Encoder);
     void                              UnlinkEncoder(OdinEncoder* Encoder);
-    void                              PushAudioToEncoder(OdinEncoder* Encoder, TArray<float>&& Audio);
+    void                              PushAudioToEncoder(OdinEncoder* Encoder, TArray<float>&& Audio, const FOdinAudioBufferPoolPtr& ReturnPool = nullptr);
+    /**
+     * Hands the room link of an encoder over to a replacement encoder on the push thread.
+     * @param OldHandle encoder to retire, freed by the push thread if this returns true
+     * @param NewHandle replacement encoder
+     * @return true if the push thread took ownership of the old encoder
+     */
+    bool SwapEncoderHandle(OdinEncoder* OldHandle, OdinEncoder* NewHandle);
+    /**
+     * Frees an encoder on the push thread once frames still queued for it are drained, or immediately without push thread.
+     * @param Handle encoder to retire
+     */
+    void RetireEncoderHandle(OdinEncoder* Handle);
+    /**
+     * Shared access to the encoder push thread for native producers, which need to outlive a single callback without resolving the subsystem.
+     * @return push data thread or null after deinitialization
+     */
+    TSharedPtr<FOdinAudioPushDataThread, ESPMode::ThreadSafe> GetPushDataThread() const
+    { return PushDataThread; }
     void                              RegisterRoom(OdinRoom* Handle, UOdinRoom* Room);
     void                              DeregisterRoom(OdinRoom* Handle);
     void                              SwapRoomHandle(OdinRoom* OldHandle, OdinRoom* NewHandle);
@@ -52,18 +79,24 @@ class ODIN_API UOdinSubsystem : public UEngineSubsystem
     void                  RegisterDecoderObject(const TWeakObjectPtr<UOdinDecoder> Decoder);
     void                  DeregisterDecoder(const UOdinDecoder* OdinDecoder);
     void                  DeregisterDecoder(const OdinDecoder* Handle);
+    void                  SwapDecoderHandle(OdinDecoder* OldHandle, OdinDecoder* NewHandle);
+    void                  RetireDecoderHandle(OdinDecoder* Handle);
     TArray<OdinDecoder*>  GetDecoderHandlesFor(OdinRoom* TargetRoom, uint32 PeerId) const;
     TArray<UOdinDecoder*> GetDecodersFor(OdinRoom* TargetRoom, uint32 PeerId) const;
 
     void HandleDatagram(OdinRoom* RoomHandle, uint32 PeerId, uint64 ChannelMask, uint32 SsrcId, TArray<uint8>&& Datagram);
 
   protected:
+    void OnAudioDeviceCreated(Audio::FDeviceId Id);
+
     mutable FCriticalSection                   RoomsCS;
     TMap<OdinRoom*, TWeakObjectPtr<UOdinRoom>> RegisteredRooms;
 
     mutable FCriticalSection                         DecoderObjectsCS;
     TMap<OdinDecoder*, TWeakObjectPtr<UOdinDecoder>> DecoderObjects;
 
-    TUniquePtr<FOdinAudioPushDataThread>      PushDataThread;
-    TUniquePtr<FOdinDatagramProcessingThread> DatagramProcessingThread;
+    TSharedPtr<FOdinAudioPushDataThread, ESPMode::ThreadSafe> PushDataThread;
+    TUniquePtr<FOdinDatagramProcessingThread>                 DatagramProcessingThread;
+
+    FDelegateHandle AudioDeviceCreatedCallbackHandle;
 };
\ No newline at end of file